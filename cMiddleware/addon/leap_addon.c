@@ -0,0 +1,246 @@
+// addon/leap_addon.c
+// N-API addon that runs the middleware's pipeline (pipeline.h) inside the Node/Electron
+// process: no ultraleap_middleware process, no TCP hop, no startup race. The pipeline's
+// polling thread encodes the packed binary record (frame_encode.h) and this file's sink
+// copies it into a ring of slots inside one ArrayBuffer created at start(). A threadsafe
+// function tells JS which slot is newest;
+// calls coalesce (latest wins) while one is still queued, and the slot JS is reading is
+// never rewritten. The JS side is src/bridges/leapc-native.js.
+//
+//   start({ fields, ibox, idleMs, idleHeartbeatMs, newFrames }, onFrame(slot, length, coalesced)) -> { buffer, slotSize, slots }
+//   control(line) -> NDJSON reply ("" when not "stats" or an ibox/calibrate/display command)
+//   stats()       -> metrics JSON (metrics.h)
+//   stop()
+//
+// The ArrayBuffer is allocated by V8 and pinned with a reference: Electron's memory cage
+// refuses external buffers, and a V8 backing store never moves.
+
+#define NAPI_VERSION 4
+#include <node_api.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+
+#include "LeapC.h"
+#include "../frame_encode.h"
+#include "../metrics.h"
+#include "../pipeline.h"
+
+#define ADDON_SLOTS     4
+#define ADDON_SLOT_SZ   FRAME_BIN_MAX
+#define ADDON_POLL_MS   100      // stop() waits at most this long for the polling thread
+#define ADDON_STREAM    ULM_STREAM_USER   // raw binary records, no base64 line
+
+typedef struct {
+  UlmCtx*         ctx;
+  napi_threadsafe_function tsfn;
+  napi_ref        bufRef;
+  uint8_t*        slots;         // ADDON_SLOTS x ADDON_SLOT_SZ inside the ArrayBuffer
+  int             lens[ADDON_SLOTS];
+  atomic_uint     latest;        // slot + 1 of the newest unread record, 0 = none
+  atomic_int      reading;       // slot the JS callback is reading, -1 = none
+  atomic_int      queued;        // a threadsafe call is in flight
+  atomic_uint     coalesced;     // records replaced before JS read them
+  MetShard*       met;           // kept across start/stop: shards are never freed
+} Addon;
+
+static Addon addon = { .reading = -1 };
+static int started = 0;           // JS thread only
+
+#define NAPI_OK(env, call) do {                                        \
+    if ((call) != napi_ok) { napi_throw_error(env, NULL, "[leap_addon] " #call " failed"); return NULL; } \
+  } while (0)
+
+// ----------------------- Sink ---------------------
+static int encodeRaw(void* user, const UlmFrame* f, uint32_t mask, char* out) {
+  (void)user;
+  return frameEncodeBinRaw(f->src, mask, (uint8_t*)out);
+}
+
+static uint32_t sinkWanted(void* user) { (void)user; return ADDON_STREAM; }
+
+// Polling thread: copies the record into the next free slot and wakes JS unless a call
+// is already queued (it will pick up this slot instead).
+static void sinkWrite(void* user, uint32_t stream, const char* rec, int len) {
+  (void)stream;
+  Addon* a = user;
+  static int last = -1;
+  int slot = (last + 1) % ADDON_SLOTS;
+  if (slot == atomic_load(&a->reading)) slot = (slot + 1) % ADDON_SLOTS;
+  memcpy(a->slots + (size_t)slot * ADDON_SLOT_SZ, rec, (size_t)len);
+  a->lens[slot] = len;
+  last = slot;
+  if (atomic_exchange(&a->latest, (unsigned)slot + 1)) atomic_fetch_add(&a->coalesced, 1);
+  if (!atomic_exchange(&a->queued, 1)) napi_call_threadsafe_function(a->tsfn, NULL, napi_tsfn_nonblocking);
+}
+
+// --------------------- JS side --------------------
+// Runs on the JS thread; env is NULL when stop() aborted the queue.
+static void callJs(napi_env env, napi_value fn, void* context, void* data) {
+  (void)data;
+  Addon* a = context;
+  atomic_store(&a->queued, 0);
+  unsigned latest = atomic_exchange(&a->latest, 0);
+  if (!env || !latest) return;
+  int slot = (int)latest - 1;
+  atomic_store(&a->reading, slot);
+  napi_value args[3], undef;
+  napi_create_uint32(env, (uint32_t)slot, &args[0]);
+  napi_create_uint32(env, (uint32_t)a->lens[slot], &args[1]);
+  napi_create_uint32(env, atomic_load(&a->coalesced), &args[2]);
+  napi_get_undefined(env, &undef);
+  napi_call_function(env, undef, fn, 3, args, NULL);
+  atomic_store(&a->reading, -1);
+}
+
+// Reads an optional string property of obj into out ("" when absent)
+static void optString(napi_env env, napi_value obj, const char* key, char* out, size_t cap) {
+  bool has = false;
+  napi_value v;
+  napi_valuetype t;
+  out[0] = 0;
+  if (napi_has_named_property(env, obj, key, &has) != napi_ok || !has) return;
+  if (napi_get_named_property(env, obj, key, &v) != napi_ok || napi_typeof(env, v, &t) != napi_ok || t != napi_string) return;
+  size_t len;
+  napi_get_value_string_utf8(env, v, out, cap, &len);
+}
+
+// Reads an optional non-negative number property of obj (def when absent)
+static uint32_t optUint(napi_env env, napi_value obj, const char* key, uint32_t def) {
+  bool has = false;
+  napi_value v;
+  napi_valuetype t;
+  double d;
+  if (napi_has_named_property(env, obj, key, &has) != napi_ok || !has) return def;
+  if (napi_get_named_property(env, obj, key, &v) != napi_ok || napi_typeof(env, v, &t) != napi_ok || t != napi_number) return def;
+  if (napi_get_value_double(env, v, &d) != napi_ok || !(d >= 0)) return def;
+  return d > 4294967295.0 ? UINT32_MAX : (uint32_t)d;
+}
+
+static napi_value start(napi_env env, napi_callback_info info) {
+  size_t argc = 2;
+  napi_value argv[2];
+  NAPI_OK(env, napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+  if (started) { napi_throw_error(env, NULL, "[leap_addon] already started"); return NULL; }
+  napi_valuetype t;
+  if (argc < 2 || napi_typeof(env, argv[1], &t) != napi_ok || t != napi_function) {
+    napi_throw_type_error(env, NULL, "[leap_addon] start(options, onFrame)");
+    return NULL;
+  }
+
+  Addon* a = &addon;
+  char fields[512], box[128];
+  optString(env, argv[0], "fields", fields, sizeof(fields));
+  optString(env, argv[0], "ibox", box, sizeof(box));
+  UlmConfig cfg;
+  ulmDefaults(&cfg);
+  cfg.fieldMask = fields[0] ? frameParseFields(fields) : FM_ALL;
+  if (!cfg.fieldMask) { napi_throw_error(env, NULL, "[leap_addon] unknown field in fields"); return NULL; }
+  cfg.ibox = box[0] ? box : NULL;
+  cfg.name = "addon";
+  cfg.met = a->met;
+  cfg.pollTimeoutMs = ADDON_POLL_MS;
+  cfg.idleMs = optUint(env, argv[0], "idleMs", 0);
+  cfg.idleHeartbeatMs = optUint(env, argv[0], "idleHeartbeatMs", cfg.idleHeartbeatMs);
+  cfg.newFrames = optUint(env, argv[0], "newFrames", cfg.newFrames);
+  UlmCtx* ctx = ulmCreate(&cfg);
+  if (!ctx) { napi_throw_error(env, NULL, "[leap_addon] bad ibox"); return NULL; }
+  a->met = ulmMetrics(ctx);
+  ulmAddEncoder(ctx, &(UlmEncoder){ "binraw", ADDON_STREAM, FRAME_BIN_MAX, 1, encodeRaw, NULL, NULL });
+  ulmAddSink(ctx, &(UlmSink){ .name = "addon", .wanted = sinkWanted, .write = sinkWrite, .user = a });
+
+  napi_value buffer;
+  void* data;
+  if (napi_create_arraybuffer(env, (size_t)ADDON_SLOTS * ADDON_SLOT_SZ, &data, &buffer) != napi_ok ||
+      napi_create_reference(env, buffer, 1, &a->bufRef) != napi_ok) {
+    ulmDestroy(ctx);
+    napi_throw_error(env, NULL, "[leap_addon] could not allocate the frame slots");
+    return NULL;
+  }
+  a->slots = data;
+  atomic_store(&a->latest, 0);
+  atomic_store(&a->reading, -1);
+  atomic_store(&a->queued, 0);
+  atomic_store(&a->coalesced, 0);
+
+  napi_value name;
+  if (napi_create_string_utf8(env, "leapFrame", NAPI_AUTO_LENGTH, &name) != napi_ok ||
+      napi_create_threadsafe_function(env, argv[1], NULL, name, 0, 1, NULL, NULL, a, callJs, &a->tsfn) != napi_ok) {
+    ulmDestroy(ctx);
+    napi_delete_reference(env, a->bufRef);
+    napi_throw_error(env, NULL, "[leap_addon] could not create the frame callback");
+    return NULL;
+  }
+
+  UlmSource src;
+  if (!ulmLeapSource(&src) || !ulmStart(ctx, &src)) {
+    ulmDestroy(ctx);
+    napi_release_threadsafe_function(a->tsfn, napi_tsfn_abort);
+    napi_delete_reference(env, a->bufRef);
+    napi_throw_error(env, NULL, "[leap_addon] could not open a LeapC connection");
+    return NULL;
+  }
+  a->ctx = ctx;
+  started = 1;
+
+  napi_value out, v;
+  NAPI_OK(env, napi_create_object(env, &out));
+  NAPI_OK(env, napi_set_named_property(env, out, "buffer", buffer));
+  NAPI_OK(env, napi_create_uint32(env, ADDON_SLOT_SZ, &v));
+  NAPI_OK(env, napi_set_named_property(env, out, "slotSize", v));
+  NAPI_OK(env, napi_create_uint32(env, ADDON_SLOTS, &v));
+  NAPI_OK(env, napi_set_named_property(env, out, "slots", v));
+  return out;
+}
+
+static napi_value stop(napi_env env, napi_callback_info info) {
+  (void)info;
+  if (!started) return NULL;
+  Addon* a = &addon;
+  ulmDestroy(a->ctx);   // joins the polling thread first
+  a->ctx = NULL;
+  napi_release_threadsafe_function(a->tsfn, napi_tsfn_abort);
+  napi_delete_reference(env, a->bufRef);
+  a->slots = NULL;
+  started = 0;
+  return NULL;
+}
+
+static napi_value control(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value argv[1], out;
+  NAPI_OK(env, napi_get_cb_info(env, info, &argc, argv, NULL, NULL));
+  char line[256], reply[256];
+  size_t len = 0;
+  if (argc < 1 || napi_get_value_string_utf8(env, argv[0], line, sizeof(line), &len) != napi_ok) {
+    napi_throw_type_error(env, NULL, "[leap_addon] control(line)");
+    return NULL;
+  }
+  int n = addon.ctx ? ulmControl(addon.ctx, line, reply, sizeof(reply)) : 0;
+  NAPI_OK(env, napi_create_string_utf8(env, reply, (size_t)(n > 0 ? n : 0), &out));
+  return out;
+}
+
+static const char* resultName(int32_t code) { return ulmResultString((eLeapRS)code); }
+
+static napi_value stats(napi_env env, napi_callback_info info) {
+  (void)info;
+  static char buf[8192];
+  int n = addon.ctx ? ulmRenderStats(addon.ctx, 1, buf, sizeof(buf)) : metRenderJson(buf, sizeof(buf), resultName, NULL);
+  napi_value out;
+  NAPI_OK(env, napi_create_string_utf8(env, buf, (size_t)n, &out));
+  return out;
+}
+
+NAPI_MODULE_INIT() {
+  const napi_property_descriptor props[] = {
+    { "start", NULL, start, NULL, NULL, NULL, napi_default, NULL },
+    { "stop", NULL, stop, NULL, NULL, NULL, napi_default, NULL },
+    { "control", NULL, control, NULL, NULL, NULL, napi_default, NULL },
+    { "stats", NULL, stats, NULL, NULL, NULL, napi_default, NULL },
+  };
+  napi_define_properties(env, exports, sizeof(props) / sizeof(props[0]), props);
+  return exports;
+}
@@ -0,0 +1,88 @@
+// bench/bench_frame_encode.c
+// Bytes and encode time per frame for the three schema-generated encodings (frame_encode.c):
+// JSON, binary, and delta with hands at rest, drifting slowly (typical pointing) and moving
+// every field every frame (worst case). Two synthetic hands, all fields, then the
+// cursor-only subset a --fields list would send.
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#include "../frame_encode.h"
+
+#define FRAMES 200000
+
+static int64_t monoNs(void) {
+  struct timespec ts; clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (int64_t)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+// Frame i of a two-hand sequence; `jitter` scales how far every value moves per frame
+static void synth(FrameSrc* f, int i, float jitter) {
+  f->frameId = 1000 + i;
+  f->ts = (int64_t)i * 8333;
+  f->framerate = 120.0f;
+  const float box[6] = { -150, 150, 100, 400, -150, 150 };
+  memcpy(f->ibox, box, sizeof(box));
+  f->displayId = 1;
+  f->nHands = 2;
+  for (uint32_t h = 0; h < 2; ++h) {
+    FrameHandSrc* s = &f->hands[h];
+    float t = i * jitter, o = (float)h;
+    s->id = 40 + h; s->type = h;
+    for (int a = 0; a < 3; ++a) {
+      s->palmPosition[a] = s->palmStab[a] = 50.0f * a + 20.0f * sinf(t + o + a);
+      s->palmVel[a] = 300.0f * cosf(t + a);
+      s->palmNorm[a] = 0.5f + 0.2f * sinf(t + a);
+      s->palmNormal[a] = s->palmDir[a] = s->angVel[a] = 0.3f * sinf(t * 2 + a);
+    }
+    const float q[4] = { 0.1f * sinf(t), 0.2f, 0.1f * cosf(t), 0.97f };
+    memcpy(s->palmQuat, q, sizeof(q));
+    s->grab = 0.5f + 0.5f * sinf(t); s->pinch = 0.5f + 0.5f * cosf(t);
+    s->pinchDistance = 30.0f + 10.0f * sinf(t); s->grabAngle = 1.0f + sinf(t);
+    s->roll = sinf(t); s->pitch = cosf(t); s->yaw = 0.1f * t;
+    for (int k = 0; k < 15; ++k) {
+      s->tips[k] = 60.0f * k + 15.0f * sinf(t + k);
+      s->tipsNorm[k] = 0.5f + 0.3f * sinf(t + k);
+    }
+    s->screen[0] = 960.0f + 400.0f * sinf(t); s->screen[1] = 540.0f + 300.0f * cosf(t);
+    s->extended = 0x1f;
+    s->hasKin = s->hasScreen = 1;
+  }
+}
+
+typedef enum { ENC_JSON, ENC_BIN, ENC_DELTA } Enc;
+
+static void run(const char* label, Enc enc, uint32_t mask, float jitter) {
+  static FrameSrc frames[256];
+  for (int i = 0; i < 256; ++i) synth(&frames[i], i, jitter);
+  static char out[FRAME_JSON_SZ];
+  FrameDelta d;
+  frameDeltaReset(&d);
+  uint64_t bytes = 0;
+  int64_t t0 = monoNs();
+  for (int i = 0; i < FRAMES; ++i) {
+    const FrameSrc* f = &frames[i & 255];
+    int n = enc == ENC_JSON ? frameEncodeJson(f, mask, out)
+          : enc == ENC_BIN  ? frameEncodeBin(f, mask, out)
+          : frameEncodeDelta(&d, f, mask, out);
+    bytes += (uint64_t)n;
+  }
+  double ns = (double)(monoNs() - t0) / FRAMES;
+  printf("  %-26s %7.0f B/frame  %7.0f ns/frame\n", label, (double)bytes / FRAMES, ns);
+}
+
+int main(void) {
+  const uint32_t cursor = frameParseFields("type,pinch,grab,palmNorm,tipsNorm,screen,fingerExtended");
+  const struct { const char* name; uint32_t mask; } sets[2] = { { "all fields", FM_ALL }, { "cursor subset", cursor } };
+  for (int k = 0; k < 2; ++k) {
+    printf("%s (2 hands):\n", sets[k].name);
+    run("json", ENC_JSON, sets[k].mask, 0.01f);
+    run("binary", ENC_BIN, sets[k].mask, 0.01f);
+    run("delta, hand at rest", ENC_DELTA, sets[k].mask, 0.0f);
+    run("delta, slow drift", ENC_DELTA, sets[k].mask, 0.0005f);
+    run("delta, everything moves", ENC_DELTA, sets[k].mask, 0.5f);
+  }
+  return 0;
+}
@@ -0,0 +1,82 @@
+// bench/bench_idle.c
+// Idle mode (UlmConfig.idleMs) over a scripted minute at 120 Hz: a hand in view for
+// 10 s, then away for 50 s. For idle off and on it prints, per minute, the frames that
+// went through the pipeline, the records written to the sink (each one wakes the
+// consumer: a socket read, an addon callback), the pipeline's own CPU time, and how many
+// frames the first record carrying a hand lagged the hand's first frame. Driven through
+// ulmProcess(); no source, no thread, no device.
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <stdatomic.h>
+
+#include "../pipeline.h"
+#include "../subscribers.h"
+#include "bench_util.h"
+
+#define HZ        120
+#define SECONDS   60
+#define HAND_S    10
+#define MINUTES   10   // repeats of the scripted minute, averaged
+
+static void run(const char* label, uint32_t idleMs) {
+  UlmConfig cfg;
+  ulmDefaults(&cfg);
+  static MetShard* met;
+  cfg.met = met;
+  cfg.idleMs = idleMs;
+  UlmCtx* ctx = ulmCreate(&cfg);
+  met = ulmMetrics(ctx);
+  CountSink sink = { SUB_BINARY, 0, 0 };
+  ulmAddSink(ctx, &(UlmSink){ .name = "count", .wanted = countWanted, .write = countWrite, .user = &sink });
+
+  static LEAP_HAND hand;
+  LEAP_TRACKING_EVENT ev;
+  memset(&ev, 0, sizeof(ev));
+  ev.pHands = &hand; ev.framerate = HZ;
+  LEAP_CONNECTION_MESSAGE msg = { .size = sizeof(msg), .type = eLeapEventType_Tracking, .tracking_event = &ev };
+
+  // the pipeline's idle log lines are not what is measured
+  fflush(stdout);
+  int saved = dup(1), devNull = open("/dev/null", O_WRONLY);
+  dup2(devNull, 1);
+
+  int64_t ns = 0, frame = 0;
+  uint64_t full = 0, lag = 0, entries = 0;
+  uint64_t idleBefore = atomic_load(&met->counter[MET_FRAMES_IDLE]);
+  for (int m = 0; m < MINUTES; ++m) {
+    for (int i = 0; i < HZ * SECONDS; ++i, ++frame) {
+      int inView = i < HZ * HAND_S;
+      ev.nHands = inView;
+      if (inView) benchHand(&hand, 1, frame * 0.01f);
+      ev.info.frame_id = ev.tracking_frame_id = frame + 1;
+      ev.info.timestamp = 1 + frame * (1000000 / HZ);
+      uint64_t before = sink.records;
+      int64_t t0 = monoNs();
+      ulmProcess(ctx, &msg);
+      ns += monoNs() - t0;
+      if (i == 0) { entries++; if (sink.records == before) lag++; }   // the hand's first frame
+    }
+  }
+  full = (uint64_t)frame - (atomic_load(&met->counter[MET_FRAMES_IDLE]) - idleBefore);
+
+  fflush(stdout);
+  dup2(saved, 1);
+  close(saved); close(devNull);
+  printf("  %-22s %7.0f frames/min  %7.0f records/min  %7.2f ms CPU/min  entry lag %llu/%llu frames\n",
+         label, (double)full / MINUTES, (double)sink.records / MINUTES, ns / 1e6 / MINUTES,
+         (unsigned long long)lag, (unsigned long long)entries);
+  ulmDestroy(ctx);
+}
+
+int main(void) {
+  printf("idle mode, %d Hz, hand %d s then away %d s, binary stream:\n", HZ, HAND_S, SECONDS - HAND_S);
+  run("idle off", 0);
+  run("idle after 500 ms", 500);
+  run("idle after 2000 ms", 2000);
+  return 0;
+}
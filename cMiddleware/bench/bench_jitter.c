@@ -0,0 +1,142 @@
+// bench/bench_jitter.c
+// Wake-up jitter of a device-rate loop, with and without the rt.c options.
+// A thread sleeps to absolute 120 Hz deadlines (the polling thread's cadence) and, on each
+// wake, does a frame's worth of work touching a fresh JSON-sized buffer, while N spinner
+// threads (default: one per CPU) stand in for a build. Reports wake lateness percentiles
+// and deadline misses for the default policy, then for the requested pin/policy/mlock/prealloc.
+//
+//   bench_jitter [--seconds n] [--load n] [--cpu n] [--sched fifo|rr] [--rt-prio n] [--mlock] [--prealloc]
+//
+// FIFO/RR need CAP_SYS_NICE (or an rtprio limit); the [RT] lines show what was granted.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#include "../rt.h"
+
+#define DEVICE_HZ 120
+#define PERIOD_NS (1000000000LL / DEVICE_HZ)
+#define WORK_BYTES (16 * 1024)
+#define MAX_SAMPLES (DEVICE_HZ * 600)
+
+static volatile int spinning = 0;
+static int64_t late[MAX_SAMPLES];
+
+static int64_t monoNs(void) {
+  struct timespec ts; clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (int64_t)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+static void sleepUntil(int64_t t) {
+  for (;;) {
+    int64_t d = t - monoNs();
+    if (d <= 0) return;
+    struct timespec ts = { (time_t)(d / 1000000000LL), (long)(d % 1000000000LL) };
+    nanosleep(&ts, NULL);
+  }
+}
+
+static void* spinner(void* arg) {
+  (void)arg;
+  volatile unsigned long x = 0;
+  while (spinning) x++;
+  return NULL;
+}
+
+typedef struct {
+  const RtConfig* rt;
+  int   seconds;
+  int   n;
+  int64_t work;
+} Phase;
+
+static int cmpI64(const void* a, const void* b) {
+  int64_t x = *(const int64_t*)a, y = *(const int64_t*)b;
+  return (x > y) - (x < y);
+}
+
+// One frame: format into a heap buffer the size of the JSON record (fresh per frame unless
+// prealloc keeps one around, like the middleware's pre-faulted stack buffers)
+static void* loop(void* arg) {
+  Phase* p = arg;
+  rtApplyThread("loop", &p->rt->poll);
+  rtPrefaultStack(p->rt, WORK_BYTES * 2);
+  char* keep = p->rt->prealloc ? malloc(WORK_BYTES) : NULL;
+  rtPrefault(p->rt, keep, WORK_BYTES);
+
+  int total = p->seconds * DEVICE_HZ;
+  if (total > MAX_SAMPLES) total = MAX_SAMPLES;
+  int64_t next = monoNs() + PERIOD_NS, workNs = 0;
+  for (int i = 0; i < total; ++i) {
+    sleepUntil(next);
+    int64_t woke = monoNs();
+    late[i] = woke - next;
+
+    char* buf = keep ? keep : malloc(WORK_BYTES);
+    int len = 0;
+    for (int k = 0; k < 80 && len < WORK_BYTES - 64; ++k)
+      len += snprintf(buf + len, WORK_BYTES - len, "[%.1f, %.1f, %.1f], ", k * 1.5, k * 2.5, k * 3.5);
+    if (!keep) free(buf);
+    workNs += monoNs() - woke;
+
+    next += PERIOD_NS;
+    if (monoNs() > next) next = monoNs() + PERIOD_NS;   // missed a whole period: resync
+  }
+  free(keep);
+  p->n = total;
+  p->work = workNs / (total ? total : 1);
+  return NULL;
+}
+
+static void runPhase(const char* label, const RtConfig* rt, int seconds, int load) {
+  pthread_t spin[256];
+  if (load > 256) load = 256;
+  spinning = 1;
+  for (int i = 0; i < load; ++i) pthread_create(&spin[i], NULL, spinner, NULL);
+
+  Phase p = { rt, seconds, 0, 0 };
+  pthread_t t;
+  pthread_create(&t, NULL, loop, &p);
+  pthread_join(t, NULL);
+
+  spinning = 0;
+  for (int i = 0; i < load; ++i) pthread_join(spin[i], NULL);
+
+  qsort(late, (size_t)p.n, sizeof(late[0]), cmpI64);
+  int misses = 0;
+  for (int i = 0; i < p.n; ++i) misses += late[i] > PERIOD_NS / 2;
+  printf("%-10s %-8d %-9.1f %-9.1f %-9.1f %-10.1f %-8d %-8.1f\n", label, p.n,
+         late[p.n / 2] / 1e3, late[(int)(p.n * 0.99)] / 1e3, late[(int)(p.n * 0.999)] / 1e3,
+         late[p.n - 1] / 1e3, misses, p.work / 1e3);
+}
+
+int main(int argc, char** argv) {
+  int seconds = 10, load = (int)sysconf(_SC_NPROCESSORS_ONLN);
+  RtConfig tuned;
+  rtDefaults(&tuned);
+  tuned.poll.prio = RT_DEFAULT_PRIO;
+  for (int i = 1; i < argc; ++i) {
+    if (!strcmp(argv[i], "--seconds") && i + 1 < argc) seconds = atoi(argv[++i]);
+    else if (!strcmp(argv[i], "--load") && i + 1 < argc) load = atoi(argv[++i]);
+    else if (!strcmp(argv[i], "--cpu") && i + 1 < argc) rtParseCpu(argv[++i], &tuned.poll.cpu);
+    else if (!strcmp(argv[i], "--sched") && i + 1 < argc) rtParseSched(argv[++i], &tuned.poll.sched);
+    else if (!strcmp(argv[i], "--rt-prio") && i + 1 < argc) tuned.poll.prio = atoi(argv[++i]);
+    else if (!strcmp(argv[i], "--mlock")) tuned.lockMemory = 1;
+    else if (!strcmp(argv[i], "--prealloc")) tuned.prealloc = 1;
+    else { fprintf(stderr, "usage: %s [--seconds n] [--load n] [--cpu n] [--sched fifo|rr] [--rt-prio n] [--mlock] [--prealloc]\n", argv[0]); return 1; }
+  }
+
+  RtConfig plain;
+  rtDefaults(&plain);
+  printf("%d Hz loop, %d s per phase, %d spinner thread(s)\n\n", DEVICE_HZ, seconds, load);
+  printf("%-10s %-8s %-9s %-9s %-9s %-10s %-8s %-8s\n",
+         "phase", "frames", "p50 us", "p99 us", "p99.9 us", "max us", "misses", "work us");
+  runPhase("default", &plain, seconds, load);
+  rtApplyProcess(&tuned);
+  runPhase("tuned", &tuned, seconds, load);
+  return 0;
+}
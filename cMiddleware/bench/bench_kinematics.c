@@ -0,0 +1,87 @@
+// bench/bench_kinematics.c
+// Cost of deriving roll/pitch/yaw + palm basis per hand: the batch kernel (polynomial atan2,
+// SoA lanes) against the per-hand libm reference, at 1..1024 hands per call to cover
+// multi-hand, multi-device frames. Also reports the kernel's worst angle error.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+
+#include "../kinematics.h"
+
+#define MAX_N 1024
+#define CALLS_TOTAL 4000000   // hands processed per case
+
+static int64_t monoNs(void) {
+  struct timespec ts; clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (int64_t)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+static float qx[MAX_N], qy[MAX_N], qz[MAX_N], qw[MAX_N];
+static float roll[MAX_N], pitch[MAX_N], yaw[MAX_N];
+static float nx[MAX_N], ny[MAX_N], nz[MAX_N], dx[MAX_N], dy[MAX_N], dz[MAX_N];
+static volatile float sink;
+
+// Random unit quaternions (uniform enough for timing and error sweeps)
+static void fillQuats(void) {
+  srand(42);
+  for (int i = 0; i < MAX_N; ++i) {
+    float x = (float)rand() / RAND_MAX - 0.5f, y = (float)rand() / RAND_MAX - 0.5f;
+    float z = (float)rand() / RAND_MAX - 0.5f, w = (float)rand() / RAND_MAX - 0.5f;
+    float n = sqrtf(x * x + y * y + z * z + w * w) + 1e-9f;
+    qx[i] = x / n; qy[i] = y / n; qz[i] = z / n; qw[i] = w / n;
+  }
+}
+
+static double runBatch(int n) {
+  KinQuatSoA in = { qx, qy, qz, qw };
+  KinOrientSoA out = { roll, pitch, yaw, nx, ny, nz, dx, dy, dz };
+  int calls = CALLS_TOTAL / n;
+  int64_t t0 = monoNs();
+  for (int c = 0; c < calls; ++c) { kinOrientBatch(&in, &out, n); sink += roll[c % n]; }
+  return (double)(monoNs() - t0) / ((double)calls * n);
+}
+
+static double runRef(int n) {
+  float rpy[3], nrm[3], dir[3];
+  int calls = CALLS_TOTAL / n;
+  int64_t t0 = monoNs();
+  for (int c = 0; c < calls; ++c) {
+    for (int i = 0; i < n; ++i) {
+      float q[4] = { qx[i], qy[i], qz[i], qw[i] };
+      kinOrientRef(q, rpy, nrm, dir);
+      sink += rpy[0];
+    }
+  }
+  return (double)(monoNs() - t0) / ((double)calls * n);
+}
+
+static float angleErr(float a, float b) {
+  float d = fabsf(a - b);
+  return d > 3.14159265f ? 6.2831853f - d : d; // +-pi wrap
+}
+
+int main(void) {
+  fillQuats();
+
+  KinQuatSoA in = { qx, qy, qz, qw };
+  KinOrientSoA out = { roll, pitch, yaw, nx, ny, nz, dx, dy, dz };
+  kinOrientBatch(&in, &out, MAX_N);
+  float maxErr = 0;
+  for (int i = 0; i < MAX_N; ++i) {
+    float q[4] = { qx[i], qy[i], qz[i], qw[i] }, rpy[3], nrm[3], dir[3];
+    kinOrientRef(q, rpy, nrm, dir);
+    float e = fmaxf(angleErr(roll[i], rpy[0]), fmaxf(angleErr(pitch[i], rpy[1]), angleErr(yaw[i], rpy[2])));
+    if (e > maxErr) maxErr = e;
+  }
+  printf("batch kernel max angle error vs libm: %.2e rad\n\n", maxErr);
+
+  const int ns[] = { 1, 2, 4, 8, 64, 1024 };
+  printf("%-8s %-16s %-16s %-8s\n", "hands", "batch ns/hand", "libm ns/hand", "speedup");
+  for (size_t i = 0; i < sizeof(ns) / sizeof(ns[0]); ++i) {
+    double b = runBatch(ns[i]), r = runRef(ns[i]);
+    printf("%-8d %-16.2f %-16.2f %-8.2f\n", ns[i], b, r, r / b);
+  }
+  return 0;
+}
@@ -0,0 +1,59 @@
+// bench/bench_pipeline.c
+// Per-frame cost of the pipeline (pipeline.h) on the calling thread, one part at a time:
+// the fixed work every tracking event pays (metrics, kinematics, interaction box), then
+// each built-in encoder alone behind a sink that only counts bytes, then every stream at
+// once. Synthetic two-hand events go through ulmProcess(); no source, no thread, no
+// device.
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#include "../pipeline.h"
+#include "../subscribers.h"
+#include "bench_util.h"
+
+#define FRAMES 100000
+
+static void run(const char* label, uint32_t wanted) {
+  UlmConfig cfg;
+  ulmDefaults(&cfg);
+  static MetShard* met;
+  cfg.met = met;   // one shard for every run
+  UlmCtx* ctx = ulmCreate(&cfg);
+  met = ulmMetrics(ctx);
+  CountSink sink = { wanted, 0, 0 };
+  ulmAddSink(ctx, &(UlmSink){ .name = "count", .wanted = countWanted, .write = countWrite, .user = &sink });
+
+  static LEAP_HAND hands[2];
+  LEAP_TRACKING_EVENT ev;
+  memset(&ev, 0, sizeof(ev));
+  ev.nHands = 2; ev.pHands = hands; ev.framerate = 120.0f;
+  LEAP_CONNECTION_MESSAGE msg = { .size = sizeof(msg), .type = eLeapEventType_Tracking, .tracking_event = &ev };
+
+  int64_t ns = 0;
+  for (int i = 0; i < FRAMES; ++i) {
+    float t = i * 0.01f;
+    benchHand(&hands[0], 1, t);
+    benchHand(&hands[1], 2, t + 1.0f);
+    ev.info.frame_id = ev.tracking_frame_id = i + 1;
+    ev.info.timestamp = (int64_t)i * 8333;
+    int64_t t0 = monoNs();
+    ulmProcess(ctx, &msg);
+    ns += monoNs() - t0;
+  }
+  printf("  %-22s %7.0f ns/frame  %7.0f B/frame\n", label, (double)ns / FRAMES, (double)sink.bytes / FRAMES);
+  ulmDestroy(ctx);
+}
+
+int main(void) {
+  printf("pipeline, 2 hands, all fields:\n");
+  run("no stream wanted", 0);
+  run("frames (json)", SUB_FRAMES);
+  run("binary", SUB_BINARY);
+  run("delta", SUB_DELTA);
+  run("skeleton", SUB_SKELETON);
+  run("all streams", SUB_FRAMES | SUB_BINARY | SUB_DELTA | SUB_SKELETON);
+  return 0;
+}
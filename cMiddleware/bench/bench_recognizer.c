@@ -0,0 +1,70 @@
+// bench/bench_recognizer.c
+// How many DTW templates can the recognizer advance per tracking frame?
+// Feeds a synthetic 120 Hz hand trajectory and reports the cost of one template step,
+// then the template count that fits in a 120 Hz frame (8.33 ms) and in the default budget.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+
+#include "../recognizer.h"
+
+#define FRAME_US_120HZ 8333
+#define DEFAULT_BUDGET_US 1000
+#define FRAMES 6000
+
+static int64_t monoNs(void) {
+  struct timespec ts; clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (int64_t)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+// Circle-ish template with per-template phase/radius jitter, sampled at 120 Hz.
+static void addTemplates(Recognizer* r, int count, int lenSteps) {
+  int n = lenSteps * 2 + 2; // 120 Hz samples covering lenSteps 60 Hz steps
+  RecSample* s = malloc(sizeof(RecSample) * n);
+  int64_t* ts = malloc(sizeof(int64_t) * n);
+  for (int k = 0; k < count; ++k) {
+    float rad = 0.08f + 0.04f * (float)(k % 7) / 7.0f, ph = (float)k * 0.37f;
+    for (int i = 0; i < n; ++i) {
+      float a = ph + 6.2831853f * (float)i / (float)n;
+      s[i] = (RecSample){ 0.5f + rad * cosf(a), 0.5f + rad * sinf(a), 0.1f * (float)(k % 3), 0.0f };
+      ts[i] = (int64_t)i * FRAME_US_120HZ;
+    }
+    recAddTemplate(r, "bench", s, ts, n);
+  }
+  free(s); free(ts);
+}
+
+static double runCase(int templates, int lenSteps) {
+  // Tiny threshold: we measure steady-state stepping, not match handling.
+  Recognizer* r = recCreate(0, 1e-6f);
+  addTemplates(r, templates, lenSteps);
+
+  int64_t busyNs = 0; int steps = 0;
+  for (int f = 0; f < FRAMES; ++f) {
+    float a = (float)f * 0.05f;
+    RecSample s = { 0.5f + 0.1f * cosf(a), 0.5f + 0.07f * sinf(a * 1.3f), 0.2f, 0.0f };
+    int64_t t0 = monoNs();
+    recFeed(r, &s, (int64_t)(f + 1) * FRAME_US_120HZ, NULL);
+    int64_t dt = monoNs() - t0;
+    if (f % 2 == 1) { busyNs += dt; steps++; } // 60 Hz resample grid: every other 120 Hz frame steps
+  }
+  recDestroy(r);
+  return (double)busyNs / (double)steps / (double)templates; // ns per template step
+}
+
+int main(void) {
+  const int lens[] = { 30, 60, 120 };
+  const int counts[] = { 16, 64, 256 };
+
+  printf("%-8s %-10s %-14s %-18s %-18s\n", "len", "templates", "ns/template", "fit @120Hz frame", "fit @1ms budget");
+  for (size_t li = 0; li < sizeof(lens) / sizeof(lens[0]); ++li) {
+    for (size_t ci = 0; ci < sizeof(counts) / sizeof(counts[0]); ++ci) {
+      double ns = runCase(counts[ci], lens[li]);
+      printf("%-8d %-10d %-14.1f %-18.0f %-18.0f\n", lens[li], counts[ci], ns,
+             (FRAME_US_120HZ * 1000.0) / ns, (DEFAULT_BUDGET_US * 1000.0) / ns);
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,109 @@
+// bench/bench_skeleton.c
+// Can the skeleton stream keep up with the device to several subscribers?
+// Packs a synthetic two-hand frame into the skeleton record every iteration (the same work
+// the polling thread does) and fans it out over loopback TCP through subscribers.c to
+// 1..8 clients that drain on their own threads. Reports the sustainable frame rate
+// (unpaced) and the records each client missed when paced at the device rate.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+#include "../skeleton.h"
+#include "../subscribers.h"
+#include "bench_util.h"
+
+#define DEVICE_HZ 120
+#define BURST_FRAMES 20000
+#define PACED_SECONDS 2
+
+typedef struct { int sock; volatile long records; volatile long bytes; } Reader;
+
+static void* drain(void* arg) {
+  Reader* r = arg;
+  char buf[1 << 16];
+  ssize_t n;
+  while ((n = recv(r->sock, buf, sizeof(buf), 0)) > 0) {
+    r->bytes += n;
+    for (ssize_t i = 0; i < n; ++i) r->records += buf[i] == '\n';
+  }
+  return NULL;
+}
+
+static void runCase(int clients) {
+  int srv = socket(AF_INET, SOCK_STREAM, 0);
+  struct sockaddr_in a = { .sin_family = AF_INET, .sin_addr.s_addr = htonl(INADDR_LOOPBACK) };
+  socklen_t al = sizeof(a);
+  bind(srv, (struct sockaddr*)&a, sizeof(a));
+  getsockname(srv, (struct sockaddr*)&a, &al);
+  listen(srv, SUB_MAX_CLIENTS);
+
+  SubList subs; subInit(&subs);
+  Reader readers[SUB_MAX_CLIENTS];
+  pthread_t th[SUB_MAX_CLIENTS];
+  for (int c = 0; c < clients; ++c) {
+    readers[c] = (Reader){ .sock = socket(AF_INET, SOCK_STREAM, 0) };
+    connect(readers[c].sock, (struct sockaddr*)&a, sizeof(a));
+    subAdd(&subs, accept(srv, NULL, NULL), SUB_SKELETON);
+    pthread_create(&th[c], NULL, drain, &readers[c]);
+  }
+
+  LEAP_HAND hands[2];
+  LEAP_TRACKING_EVENT frame;
+  memset(&frame, 0, sizeof(frame));
+  frame.nHands = 2; frame.pHands = hands;
+  char rec[SKEL_JSON_SZ];
+  int recLen = 0;
+
+  // Unpaced: the fastest rate the producer can pack + fan out
+  int64_t t0 = monoNs(), packNs = 0;
+  for (int i = 0; i < BURST_FRAMES; ++i) {
+    int64_t p0 = monoNs();
+    benchHand(&hands[0], 1, (float)i * 0.01f); benchHand(&hands[1], 2, (float)i * 0.01f);
+    frame.tracking_frame_id = i; frame.info.timestamp = i * (1000000 / DEVICE_HZ);
+    recLen = skelFrameRecord(&frame, rec);
+    packNs += monoNs() - p0;
+    subBroadcast(&subs, SUB_SKELETON, rec, recLen);
+  }
+  double burstS = (double)(monoNs() - t0) / 1e9;
+  uint64_t burstDrops = 0;
+  for (int c = 0; c < clients; ++c) burstDrops += subs.c[c].dropped;
+
+  // Paced at the device rate: nothing should be missed
+  usleep(200000);
+  for (int c = 0; c < clients; ++c) subs.c[c].dropped = 0;
+  int pacedFrames = DEVICE_HZ * PACED_SECONDS;
+  for (int i = 0; i < pacedFrames; ++i) {
+    recLen = skelFrameRecord(&frame, rec);
+    subBroadcast(&subs, SUB_SKELETON, rec, recLen);
+    usleep(1000000 / DEVICE_HZ);
+  }
+  uint64_t pacedDrops = 0;
+  for (int c = 0; c < clients; ++c) pacedDrops += subs.c[c].dropped;
+
+  subCloseAll(&subs);
+  for (int c = 0; c < clients; ++c) { pthread_join(th[c], NULL); close(readers[c].sock); }
+  close(srv);
+
+  printf("%-9d %-8d %-12.0f %-10.2f %-12.1f %-12.1f %-10llu\n",
+         clients, recLen, BURST_FRAMES / burstS, (double)packNs / BURST_FRAMES / 1000.0,
+         (double)recLen * BURST_FRAMES * clients / burstS / 1e6,
+         100.0 * (double)burstDrops / ((double)BURST_FRAMES * clients),
+         (unsigned long long)pacedDrops);
+}
+
+int main(void) {
+  printf("skeleton record: %d floats/hand, 2 hands; device rate %d Hz\n\n", SKEL_STRIDE, DEVICE_HZ);
+  printf("%-9s %-8s %-12s %-10s %-12s %-12s %-10s\n",
+         "clients", "bytes", "max fps", "pack us", "MB/s out", "burst drop%", "drops@120Hz");
+  const int counts[] = { 1, 2, 4, 8 };
+  for (size_t i = 0; i < sizeof(counts) / sizeof(counts[0]); ++i) runCase(counts[i]);
+  return 0;
+}
@@ -0,0 +1,56 @@
+// bench/bench_util.h
+// Shared by the middleware benches: a monotonic clock, a synthetic hand and a sink that
+// only counts what the pipeline writes. Header-only; each bench is its own executable.
+
+#ifndef ULM_BENCH_UTIL_H
+#define ULM_BENCH_UTIL_H
+
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "LeapC.h"
+
+static inline int64_t monoNs(void) {
+  struct timespec ts; clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (int64_t)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+static inline void setv(LEAP_VECTOR* v, float x, float y, float z) { v->x = x; v->y = y; v->z = z; }
+
+// Hand `id` (odd: right) at phase t: palm circling, pinch/grab cycling, four fingers out
+static inline void benchHand(LEAP_HAND* h, uint32_t id, float t) {
+  memset(h, 0, sizeof(*h));
+  h->id = id; h->type = id & 1 ? eLeapHandType_Right : eLeapHandType_Left;
+  h->confidence = 1.0f; h->palm.width = 80.0f;
+  h->pinch_strength = 0.5f + 0.5f * sinf(t); h->grab_strength = 0.5f + 0.5f * cosf(t);
+  setv(&h->palm.position, 40.0f * sinf(t), 200.0f + 40.0f * cosf(t), 0.0f);
+  h->palm.stabilized_position = h->palm.position;
+  setv(&h->palm.velocity, 40.0f * cosf(t), -40.0f * sinf(t), 0.0f);
+  setv(&h->palm.normal, 0, -1, 0);
+  setv(&h->palm.direction, 0, 0, -1);
+  h->palm.orientation.z = sinf(0.1f * t); h->palm.orientation.w = cosf(0.1f * t);
+  for (int f = 0; f < 5; ++f) {
+    for (int b = 0; b < 4; ++b) {
+      LEAP_BONE* bone = &h->digits[f].bones[b];
+      setv(&bone->prev_joint, f * 20.0f, 200.0f + b * 25.0f + sinf(t), -b * 10.0f);
+      setv(&bone->next_joint, f * 20.0f, 225.0f + b * 25.0f + sinf(t), -b * 10.0f - 10.0f);
+      bone->width = 15.0f; bone->rotation.w = 1.0f;
+    }
+    h->digits[f].is_extended = f > 0;
+  }
+  h->arm.width = 60.0f; h->arm.rotation.w = 1.0f;
+}
+
+// UlmSink callbacks (pipeline.h): wants `wanted`, counts records and bytes
+typedef struct { uint32_t wanted; uint64_t records, bytes; } CountSink;
+
+static inline uint32_t countWanted(void* user) { return ((CountSink*)user)->wanted; }
+static inline void countWrite(void* user, uint32_t stream, const char* rec, int len) {
+  (void)stream; (void)rec;
+  CountSink* c = user;
+  c->records++;
+  c->bytes += (uint64_t)len;
+}
+
+#endif
@@ -0,0 +1,165 @@
+// fake/LeapC.h
+// The subset of the Ultraleap LeapC API this tree uses, for building without the SDK
+// (cmake -DULM_FAKE_LEAPC=ON). Names and member names match LeapSDK 5's LeapC.h so the
+// same sources compile against either; the implementation is fake_leapc.c.
+
+#ifndef ULM_FAKE_LEAPC_H
+#define ULM_FAKE_LEAPC_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef enum _eLeapRS {
+  eLeapRS_Success                  = 0x00000000,
+  eLeapRS_UnknownError             = 0xE2010000,
+  eLeapRS_InvalidArgument          = 0xE2010001,
+  eLeapRS_InsufficientResources    = 0xE2010002,
+  eLeapRS_InsufficientBuffer       = 0xE2010003,
+  eLeapRS_Timeout                  = 0xE2010004,
+  eLeapRS_NotConnected             = 0xE2010005,
+  eLeapRS_HandshakeIncomplete      = 0xE2010006,
+  eLeapRS_BufferSizeOverflow       = 0xE2010007,
+  eLeapRS_ProtocolError            = 0xE2010008,
+  eLeapRS_InvalidClientID          = 0xE2010009,
+  eLeapRS_UnexpectedClosed         = 0xE201000A,
+  eLeapRS_UnknownImageFrameRequest = 0xE201000B,
+  eLeapRS_UnknownTrackingFrameID   = 0xE201000C,
+  eLeapRS_RoutineIsNotSeer         = 0xE201000D,
+  eLeapRS_TimestampTooEarly        = 0xE201000E,
+  eLeapRS_ConcurrentPoll           = 0xE201000F,
+  eLeapRS_NotAvailable             = 0xE7010002,
+  eLeapRS_NotStreaming             = 0xE7010004,
+  eLeapRS_CannotOpenDevice         = 0xE7010005,
+} eLeapRS;
+
+typedef struct _LEAP_CONNECTION* LEAP_CONNECTION;
+typedef struct _LEAP_DEVICE* LEAP_DEVICE;
+typedef struct { uint32_t size; uint32_t flags; const char* server_namespace; } LEAP_CONNECTION_CONFIG;
+
+typedef union { struct { float x, y, z; }; float v[3]; } LEAP_VECTOR;
+typedef union { struct { float x, y, z, w; }; float v[4]; } LEAP_QUATERNION;
+
+typedef struct {
+  LEAP_VECTOR     prev_joint;
+  LEAP_VECTOR     next_joint;
+  float           width;
+  LEAP_QUATERNION rotation;
+} LEAP_BONE;
+
+typedef struct {
+  int32_t finger_id;
+  union {
+    struct { LEAP_BONE metacarpal, proximal, intermediate, distal; };
+    LEAP_BONE bones[4];
+  };
+  uint32_t is_extended;
+} LEAP_DIGIT;
+
+typedef struct {
+  LEAP_VECTOR     position;
+  LEAP_VECTOR     stabilized_position;
+  LEAP_VECTOR     velocity;
+  LEAP_VECTOR     normal;
+  float           width;
+  LEAP_VECTOR     direction;
+  LEAP_QUATERNION orientation;
+} LEAP_PALM;
+
+typedef enum { eLeapHandType_Left, eLeapHandType_Right } eLeapHandType;
+
+typedef struct {
+  uint32_t      id;
+  uint32_t      flags;
+  eLeapHandType type;
+  float         confidence;
+  uint64_t      visible_time;
+  float         pinch_distance;
+  float         grab_angle;
+  float         pinch_strength;
+  float         grab_strength;
+  LEAP_PALM     palm;
+  union {
+    struct { LEAP_DIGIT thumb, index, middle, ring, pinky; };
+    LEAP_DIGIT digits[5];
+  };
+  LEAP_BONE     arm;
+} LEAP_HAND;
+
+typedef struct { void* reserved; int64_t frame_id; int64_t timestamp; } LEAP_FRAME_HEADER;
+
+typedef struct {
+  LEAP_FRAME_HEADER info;
+  int64_t    tracking_frame_id;
+  uint32_t   nHands;
+  LEAP_HAND* pHands;
+  float      framerate;
+} LEAP_TRACKING_EVENT;
+
+typedef enum { eLeapImageType_Unknown = 0, eLeapImageType_Default, eLeapImageType_Raw } eLeapImageType;
+typedef enum { eLeapImageFormat_UNKNOWN = 0, eLeapImageFormat_IR = 0x317249 } eLeapImageFormat;
+
+typedef struct {
+  eLeapImageType   type;
+  eLeapImageFormat format;
+  uint32_t bpp, width, height;
+  float    x_scale, x_offset, y_scale, y_offset;
+} LEAP_IMAGE_PROPERTIES;
+
+typedef struct {
+  LEAP_IMAGE_PROPERTIES properties;
+  uint64_t matrix_version;
+  void*    distortion_matrix;
+  void*    data;
+  uint32_t offset;
+} LEAP_IMAGE;
+
+typedef struct { LEAP_FRAME_HEADER info; LEAP_IMAGE image[2]; void* calib; } LEAP_IMAGE_EVENT;
+
+typedef enum {
+  eLeapEventType_None = 0,
+  eLeapEventType_Connection,
+  eLeapEventType_ConnectionLost,
+  eLeapEventType_Device,
+  eLeapEventType_DeviceFailure,
+  eLeapEventType_Policy,
+  eLeapEventType_Tracking = 0x100,
+  eLeapEventType_ImageRequestError,
+  eLeapEventType_ImageComplete,
+  eLeapEventType_LogEvent,
+  eLeapEventType_DeviceLost,
+  eLeapEventType_ConfigResponse,
+  eLeapEventType_ConfigChange,
+  eLeapEventType_DeviceStatusChange,
+  eLeapEventType_DroppedFrame,
+  eLeapEventType_Image,
+} eLeapEventType;
+
+typedef enum {
+  eLeapPolicyFlag_BackgroundFrames = 0x00000001,
+  eLeapPolicyFlag_Images           = 0x00000002,
+  eLeapPolicyFlag_OptimizeHMD      = 0x00000004,
+  eLeapPolicyFlag_AllowPauseResume = 0x00000008,
+  eLeapPolicyFlag_MapPoints        = 0x00000080,
+} eLeapPolicyFlag;
+
+typedef struct {
+  uint32_t       size;
+  eLeapEventType type;
+  union {
+    const void*                pointer;
+    const LEAP_TRACKING_EVENT* tracking_event;
+    const LEAP_IMAGE_EVENT*    image_event;
+  };
+  LEAP_DEVICE device;
+} LEAP_CONNECTION_MESSAGE;
+
+eLeapRS LeapCreateConnection(const LEAP_CONNECTION_CONFIG* config, LEAP_CONNECTION* out);
+eLeapRS LeapOpenConnection(LEAP_CONNECTION c);
+void    LeapCloseConnection(LEAP_CONNECTION c);
+void    LeapDestroyConnection(LEAP_CONNECTION c);
+eLeapRS LeapSetPolicyFlags(LEAP_CONNECTION c, uint64_t set, uint64_t clear);
+eLeapRS LeapPollConnection(LEAP_CONNECTION c, uint32_t timeout, LEAP_CONNECTION_MESSAGE* msg);
+int64_t LeapGetNow(void);
+
+#endif
@@ -0,0 +1,151 @@
+// fake/fake_leapc.c
+// A scripted stand-in for the LeapC service: one device that tracks synthetic hands at a
+// steady rate, so the middleware, the Node addon and their tests run without hardware.
+// The palm circles 60 mm around (0, 200, 0) at 0.5 Hz, pinch and grab oscillate, and
+// the second hand (if any) mirrors the first. LeapPollConnection paces itself to the
+// frame rate and honours its timeout like the real call.
+//
+// Environment:
+//   ULM_FAKE_HZ      frames per second (default 120)
+//   ULM_FAKE_HANDS   hands per frame, 0..2 (default 1)
+//   ULM_FAKE_FRAMES  stop tracking after this many frames (default 0 = never); polls
+//                    then time out, as with a device and no hands over it
+
+#include "LeapC.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define FAKE_MAX_HANDS 2
+
+struct _LEAP_CONNECTION {
+  int      open;
+  int      stage;          // 0: Connection event, 1: Device event, 2: tracking
+  uint32_t hz, hands;
+  uint64_t frames, limit;
+  int64_t  t0, next;       // us
+  LEAP_TRACKING_EVENT ev;
+  LEAP_HAND hand[FAKE_MAX_HANDS];
+};
+
+int64_t LeapGetNow(void) {
+  struct timespec ts; clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static void sleepUs(int64_t us) {
+  if (us <= 0) return;
+  struct timespec ts = { (time_t)(us / 1000000), (long)(us % 1000000) * 1000 };
+  nanosleep(&ts, NULL);
+}
+
+static uint32_t envU32(const char* name, uint32_t def) {
+  const char* v = getenv(name);
+  return v && *v ? (uint32_t)strtoul(v, NULL, 10) : def;
+}
+
+eLeapRS LeapCreateConnection(const LEAP_CONNECTION_CONFIG* config, LEAP_CONNECTION* out) {
+  (void)config;
+  if (!out) return eLeapRS_InvalidArgument;
+  LEAP_CONNECTION c = calloc(1, sizeof(*c));
+  if (!c) return eLeapRS_InsufficientResources;
+  c->hz = envU32("ULM_FAKE_HZ", 120);
+  if (!c->hz) c->hz = 120;
+  c->hands = envU32("ULM_FAKE_HANDS", 1);
+  if (c->hands > FAKE_MAX_HANDS) c->hands = FAKE_MAX_HANDS;
+  c->limit = envU32("ULM_FAKE_FRAMES", 0);
+  *out = c;
+  return eLeapRS_Success;
+}
+
+eLeapRS LeapOpenConnection(LEAP_CONNECTION c) {
+  if (!c) return eLeapRS_InvalidArgument;
+  c->open = 1;
+  c->t0 = c->next = LeapGetNow();
+  return eLeapRS_Success;
+}
+
+void LeapCloseConnection(LEAP_CONNECTION c) { if (c) c->open = 0; }
+void LeapDestroyConnection(LEAP_CONNECTION c) { free(c); }
+
+eLeapRS LeapSetPolicyFlags(LEAP_CONNECTION c, uint64_t set, uint64_t clear) {
+  (void)set; (void)clear;
+  return c ? eLeapRS_Success : eLeapRS_InvalidArgument;
+}
+
+static void setVec(LEAP_VECTOR* v, float x, float y, float z) { v->x = x; v->y = y; v->z = z; }
+
+// Hand h at t seconds; the left hand mirrors x
+static void synthHand(LEAP_HAND* hand, uint32_t h, double t) {
+  const double w = 2 * M_PI * 0.5;
+  float side = h ? -1.0f : 1.0f;
+  float x = side * (40.0f + 60.0f * (float)cos(w * t)), y = 200.0f + 60.0f * (float)sin(w * t), z = 0.0f;
+  memset(hand, 0, sizeof(*hand));
+  hand->id = h + 1;
+  hand->type = h ? eLeapHandType_Left : eLeapHandType_Right;
+  hand->confidence = 1.0f;
+  hand->pinch_strength = 0.5f + 0.5f * (float)sin(w * t * 0.5);
+  hand->grab_strength = 0.5f + 0.5f * (float)cos(w * t * 0.25);
+  hand->pinch_distance = 80.0f * (1.0f - hand->pinch_strength);
+  hand->grab_angle = (float)M_PI * hand->grab_strength;
+  setVec(&hand->palm.position, x, y, z);
+  hand->palm.stabilized_position = hand->palm.position;
+  setVec(&hand->palm.velocity, -side * 60.0f * (float)(w * sin(w * t)), 60.0f * (float)(w * cos(w * t)), 0.0f);
+  setVec(&hand->palm.normal, 0, -1, 0);
+  setVec(&hand->palm.direction, 0, 0, -1);
+  hand->palm.width = 80.0f;
+  float roll = 0.3f * (float)sin(w * t);   // palm down, rocking about -z
+  hand->palm.orientation.x = 0; hand->palm.orientation.y = 0;
+  hand->palm.orientation.z = sinf(roll / 2); hand->palm.orientation.w = cosf(roll / 2);
+  for (int d = 0; d < 5; ++d) {
+    LEAP_DIGIT* dg = &hand->digits[d];
+    dg->finger_id = (int32_t)(hand->id * 10 + d);
+    dg->is_extended = d == 1 || hand->grab_strength < 0.5f;
+    float fx = x + side * (d - 2) * 20.0f, fz = z - 40.0f;
+    for (int b = 0; b < 4; ++b) {
+      LEAP_BONE* bone = &dg->bones[b];
+      setVec(&bone->prev_joint, fx, y, fz - 20.0f * b);
+      setVec(&bone->next_joint, fx, y, fz - 20.0f * (b + 1));
+      bone->width = 16.0f;
+      bone->rotation = hand->palm.orientation;
+    }
+  }
+  setVec(&hand->arm.prev_joint, x, y - 20.0f, z + 250.0f);
+  setVec(&hand->arm.next_joint, x, y, z + 20.0f);
+  hand->arm.width = 55.0f;
+  hand->arm.rotation = hand->palm.orientation;
+}
+
+eLeapRS LeapPollConnection(LEAP_CONNECTION c, uint32_t timeout, LEAP_CONNECTION_MESSAGE* msg) {
+  if (!c || !msg) return eLeapRS_InvalidArgument;
+  if (!c->open) return eLeapRS_NotConnected;
+  memset(msg, 0, sizeof(*msg));
+  msg->size = sizeof(*msg);
+  if (c->stage < 2) {
+    msg->type = c->stage++ == 0 ? eLeapEventType_Connection : eLeapEventType_Device;
+    return eLeapRS_Success;
+  }
+
+  int64_t now = LeapGetNow();
+  if ((c->limit && c->frames >= c->limit) || c->next - now > (int64_t)timeout * 1000) {
+    sleepUs((int64_t)timeout * 1000);
+    return eLeapRS_Timeout;
+  }
+  sleepUs(c->next - now);
+  now = LeapGetNow();
+
+  double t = (double)(c->next - c->t0) / 1e6;
+  for (uint32_t h = 0; h < c->hands; ++h) synthHand(&c->hand[h], h, t);
+  c->ev.info.frame_id = c->ev.tracking_frame_id = (int64_t)++c->frames;
+  c->ev.info.timestamp = c->next;
+  c->ev.nHands = c->hands;
+  c->ev.pHands = c->hand;
+  c->ev.framerate = (float)c->hz;
+  c->next += 1000000 / c->hz;
+  if (c->next < now) c->next = now;   // a stalled poller skips frames, like the service
+  msg->type = eLeapEventType_Tracking;
+  msg->tracking_event = &c->ev;
+  return eLeapRS_Success;
+}
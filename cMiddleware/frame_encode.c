@@ -0,0 +1,309 @@
+// frame_encode.c
+// Schema-driven encoders (see frame_schema.h / frame_encode.h). Every X(...) line expands
+// to one call of a small inline writer per wire format; N and PREC are constants, so the
+// compiler unrolls each field into straight-line stores.
+
+#include "frame_encode.h"
+#include "skeleton.h"   // base64Encode
+
+#include <math.h>
+#include <string.h>
+#include <strings.h>
+
+static const char* const fingerNames[5] = { "thumb", "index", "middle", "ring", "pinky" };
+static const float pow10f[6] = { 1.0f, 10.0f, 100.0f, 1000.0f, 10000.0f, 100000.0f };
+
+void frameHandFrom(const LEAP_HAND* hand, FrameHandSrc* s) {
+  s->id = hand->id;
+  s->type = hand->type == eLeapHandType_Left ? 0u : 1u;
+  memcpy(s->palmPosition, hand->palm.position.v, sizeof(s->palmPosition));
+  s->grab = hand->grab_strength;
+  s->pinch = hand->pinch_strength;
+  s->pinchDistance = hand->pinch_distance;
+  s->grabAngle = hand->grab_angle;
+  memcpy(s->palmStab, hand->palm.stabilized_position.v, sizeof(s->palmStab));
+  memcpy(s->palmVel, hand->palm.velocity.v, sizeof(s->palmVel));
+  memcpy(s->palmQuat, hand->palm.orientation.v, sizeof(s->palmQuat));
+  s->extended = 0;
+  for (int f = 0; f < 5; ++f) {
+    memcpy(s->tips + f * 3, hand->digits[f].distal.next_joint.v, 3 * sizeof(float));
+    s->extended |= (hand->digits[f].is_extended ? 1u : 0u) << f;
+  }
+  s->confidence = hand->confidence;
+  s->isNew = 0;
+  s->hasKin = s->hasScreen = 0;
+}
+
+// ---------------------- JSON ----------------------
+// Callers guarantee room (FRAME_HAND_JSON_MAX per hand), so the writers don't bounds-check.
+static inline void putRaw(char** p, const char* s, size_t n) { memcpy(*p, s, n); *p += n; }
+#define PUT_LIT(p, lit) putRaw(p, lit, sizeof(lit) - 1)
+
+static inline void putU64(char** p, uint64_t v) {
+  char tmp[20];
+  int n = 0;
+  do { tmp[n++] = (char)('0' + v % 10); v /= 10; } while (v);
+  while (n) *(*p)++ = tmp[--n];
+}
+
+static inline void putI64(char** p, int64_t v) {
+  if (v < 0) { *(*p)++ = '-'; putU64(p, (uint64_t)(-(v + 1)) + 1); }
+  else putU64(p, (uint64_t)v);
+}
+
+// Fixed-point with prec decimals (what "%.<prec>f" printed); NaN/inf -> 0 to stay valid JSON
+static inline void putFixed(char** p, float v, int prec) {
+  if (!isfinite(v)) v = 0.0f;
+  double scaled = fabs((double)v) * pow10f[prec] + 0.5;
+  uint64_t q = (uint64_t)scaled;
+  if (v < 0 && q) *(*p)++ = '-';
+  uint64_t div = (uint64_t)pow10f[prec];
+  putU64(p, q / div);
+  if (prec) {
+    *(*p)++ = '.';
+    uint64_t frac = q % div;
+    for (uint64_t d = div / 10; d; d /= 10) { *(*p)++ = (char)('0' + frac / d); frac %= d; }
+  }
+}
+
+static inline void putKey(char** p, const char* key, size_t n) {
+  *(*p)++ = '"'; putRaw(p, key, n); PUT_LIT(p, "\": ");
+}
+
+static inline void putVec(char** p, const float* v, int n, int prec) {
+  *(*p)++ = '[';
+  for (int i = 0; i < n; ++i) { if (i) PUT_LIT(p, ", "); putFixed(p, v[i], prec); }
+  *(*p)++ = ']';
+}
+
+#define JSON_U32(p, n, prec, src)      putU64(p, *(src))
+#define JSON_I64(p, n, prec, src)      putI64(p, *(src))
+#define JSON_HANDTYPE(p, n, prec, src) do { if (*(src)) PUT_LIT(p, "\"right\""); else PUT_LIT(p, "\"left\""); } while (0)
+#define JSON_BOOL(p, n, prec, src)     do { if (*(src)) PUT_LIT(p, "true"); else PUT_LIT(p, "false"); } while (0)
+#define JSON_F32(p, n, prec, src)      putFixed(p, *(src), prec)
+#define JSON_VEC(p, n, prec, src)      putVec(p, src, n, prec)
+#define JSON_VEC3S(p, n, prec, src) do {                                      \
+    *(*p)++ = '[';                                                           \
+    for (int t_ = 0; t_ < (n) / 3; ++t_) { if (t_) PUT_LIT(p, ", "); putVec(p, (src) + t_ * 3, 3, prec); } \
+    *(*p)++ = ']';                                                           \
+  } while (0)
+#define JSON_NAMED3(p, n, prec, src) do {                                     \
+    *(*p)++ = '{';                                                           \
+    for (int f_ = 0; f_ < 5; ++f_) {                                         \
+      if (f_) PUT_LIT(p, ", ");                                              \
+      putKey(p, fingerNames[f_], strlen(fingerNames[f_]));                   \
+      putVec(p, (src) + f_ * 3, 3, prec);                                    \
+    }                                                                        \
+    *(*p)++ = '}';                                                           \
+  } while (0)
+#define JSON_NAMEDB(p, n, prec, src) do {                                     \
+    *(*p)++ = '{';                                                           \
+    for (int f_ = 0; f_ < 5; ++f_) {                                         \
+      if (f_) PUT_LIT(p, ", ");                                              \
+      putKey(p, fingerNames[f_], strlen(fingerNames[f_]));                   \
+      if ((*(src) >> f_) & 1u) PUT_LIT(p, "true"); else PUT_LIT(p, "false"); \
+    }                                                                        \
+    *(*p)++ = '}';                                                           \
+  } while (0)
+
+int frameEncodeJson(const FrameSrc* f, uint32_t mask, char* out) {
+  char* p = out;
+  const char* sep = "{";
+#define X(NAME, KEY, KIND, N, PREC, SRC, COND)                 \
+  if (COND) {                                                  \
+    putRaw(&p, sep, strlen(sep)); sep = ", ";                  \
+    putKey(&p, KEY, sizeof(KEY) - 1);                          \
+    JSON_##KIND(&p, N, PREC, SRC);                             \
+  }
+  FRAME_HEADER_FIELDS(X)
+#undef X
+  if (f->heartbeat) PUT_LIT(&p, ", \"heartbeat\": true");
+  PUT_LIT(&p, ", \"hands\": [");
+
+  mask |= FM_ID;
+  uint32_t n = f->nHands < FRAME_MAX_HANDS ? f->nHands : FRAME_MAX_HANDS;
+  for (uint32_t h = 0; h < n; ++h) {
+    if ((p - out) + FRAME_HAND_JSON_MAX + 8 > FRAME_JSON_SZ) break;
+    const FrameHandSrc* s = &f->hands[h];
+    if (h) PUT_LIT(&p, ", ");
+    sep = "{";
+#define X(NAME, KEY, KIND, N, PREC, SRC, COND)                 \
+    if ((mask & FM_##NAME) && (COND)) {                        \
+      putRaw(&p, sep, strlen(sep)); sep = ", ";                \
+      putKey(&p, KEY, sizeof(KEY) - 1);                        \
+      JSON_##KIND(&p, N, PREC, SRC);                           \
+    }
+    FRAME_HAND_FIELDS(X)
+#undef X
+    *p++ = '}';
+  }
+  PUT_LIT(&p, "]}\n");
+  return (int)(p - out);
+}
+
+// --------------------- Binary ---------------------
+// float32 / integers go out in host order; every target we build for is little endian.
+static inline void binBytes(uint8_t** b, const void* v, size_t n) { memcpy(*b, v, n); *b += n; }
+static inline void binU8(uint8_t** b, uint32_t v) { *(*b)++ = (uint8_t)v; }
+
+static inline void binNaN(uint8_t** b, int n) {
+  const float nan = NAN;
+  for (int i = 0; i < n; ++i) binBytes(b, &nan, sizeof(nan));
+}
+
+#define BIN_U32(b, n, prec, src)      binBytes(b, src, 4)
+#define BIN_I64(b, n, prec, src)      binBytes(b, src, 8)
+#define BIN_HANDTYPE(b, n, prec, src) binU8(b, *(src))
+#define BIN_BOOL(b, n, prec, src)     binU8(b, *(src))
+#define BIN_NAMEDB(b, n, prec, src)   binU8(b, *(src))
+#define BIN_F32(b, n, prec, src)      binBytes(b, src, 4)
+#define BIN_VEC(b, n, prec, src)      binBytes(b, src, (size_t)(n) * 4)
+#define BIN_VEC3S                     BIN_VEC
+#define BIN_NAMED3                    BIN_VEC
+
+// Width in bytes when absent (integer kinds are never conditional)
+#define BIN_ABSENT_U32(b, n)      binBytes(b, &(uint32_t){ 0 }, 4)
+#define BIN_ABSENT_I64(b, n)      binBytes(b, &(int64_t){ 0 }, 8)
+#define BIN_ABSENT_HANDTYPE(b, n) binU8(b, 0)
+#define BIN_ABSENT_BOOL(b, n)     binU8(b, 0)
+#define BIN_ABSENT_NAMEDB(b, n)   binU8(b, 0)
+#define BIN_ABSENT_F32(b, n)      binNaN(b, 1)
+#define BIN_ABSENT_VEC(b, n)      binNaN(b, n)
+#define BIN_ABSENT_VEC3S          BIN_ABSENT_VEC
+#define BIN_ABSENT_NAMED3         BIN_ABSENT_VEC
+
+static uint8_t* binHeader(const FrameSrc* f, uint32_t mask, uint32_t nHands, uint32_t flags, uint8_t* b) {
+  binBytes(&b, &mask, 4);
+#define X(NAME, KEY, KIND, N, PREC, SRC, COND) BIN_##KIND(&b, N, PREC, SRC);
+  FRAME_HEADER_FIELDS(X)
+#undef X
+  binU8(&b, nHands);
+  binU8(&b, flags | (f->heartbeat ? 2u : 0u));
+  return b;
+}
+
+// {"type": "frameBin", "enc": "...", "data": "<base64>"}\n around a packed record
+static int binEnvelope(const char* enc, const uint8_t* bin, int n, char* out) {
+  char* p = out;
+  PUT_LIT(&p, "{\"type\": \"frameBin\", \"enc\": \"");
+  putRaw(&p, enc, strlen(enc));
+  PUT_LIT(&p, "\", \"data\": \"");
+  p += base64Encode(bin, n, p);
+  PUT_LIT(&p, "\"}\n");
+  return (int)(p - out);
+}
+
+int frameEncodeBinRaw(const FrameSrc* f, uint32_t mask, uint8_t* out) {
+  mask |= FM_ID;
+  uint32_t n = f->nHands < FRAME_MAX_HANDS ? f->nHands : FRAME_MAX_HANDS;
+  uint8_t* b = binHeader(f, mask, n, 0, out);
+  for (uint32_t h = 0; h < n; ++h) {
+    const FrameHandSrc* s = &f->hands[h];
+#define X(NAME, KEY, KIND, N, PREC, SRC, COND)                 \
+    if (mask & FM_##NAME) {                                    \
+      if (COND) BIN_##KIND(&b, N, PREC, SRC);                  \
+      else BIN_ABSENT_##KIND(&b, N);                           \
+    }
+    FRAME_HAND_FIELDS(X)
+#undef X
+  }
+  return (int)(b - out);
+}
+
+int frameEncodeBin(const FrameSrc* f, uint32_t mask, char* out) {
+  uint8_t bin[FRAME_BIN_MAX];
+  return binEnvelope("bin", bin, frameEncodeBinRaw(f, mask, bin), out);
+}
+
+// ---------------------- Delta ---------------------
+// Floats are compared and sent as integer quanta of their JSON precision, so the decoder's
+// state matches the encoder's exactly and jitter below the printed precision is not a change.
+static inline int32_t quant(float v, int prec) {
+  return isfinite(v) ? (int32_t)lrintf(v * pow10f[prec]) : 0;
+}
+
+#define DQ_U32(q, n, prec, src)      (q)[0] = (int32_t)*(src)
+#define DQ_I64(q, n, prec, src)      (q)[0] = (int32_t)*(src)
+#define DQ_HANDTYPE                  DQ_U32
+#define DQ_BOOL                      DQ_U32
+#define DQ_NAMEDB                    DQ_U32
+#define DQ_F32(q, n, prec, src)      (q)[0] = quant(*(src), prec)
+#define DQ_VEC(q, n, prec, src)      for (int i_ = 0; i_ < (n); ++i_) (q)[i_] = quant((src)[i_], prec)
+#define DQ_VEC3S                     DQ_VEC
+#define DQ_NAMED3                    DQ_VEC
+
+#define DW_U32(b, q, n)      binBytes(b, q, 4)
+#define DW_HANDTYPE(b, q, n) binU8(b, (uint32_t)(q)[0])
+#define DW_BOOL              DW_HANDTYPE
+#define DW_NAMEDB            DW_HANDTYPE
+#define DW_F32(b, q, n)      binBytes(b, q, 4)
+#define DW_VEC(b, q, n)      binBytes(b, q, (size_t)(n) * 4)
+#define DW_VEC3S             DW_VEC
+#define DW_NAMED3            DW_VEC
+
+void frameDeltaReset(FrameDelta* d) { memset(d, 0, sizeof(*d)); }
+
+int frameEncodeDelta(FrameDelta* d, const FrameSrc* f, uint32_t mask, char* out) {
+  uint8_t bin[FRAME_BIN_MAX];
+  FrameDelta next = { .frames = d->frames + 1 };
+  int key = d->frames % FRAME_DELTA_KEYFRAME == 0;
+  mask |= FM_ID;
+  uint32_t n = f->nHands < FRAME_MAX_HANDS ? f->nHands : FRAME_MAX_HANDS;
+  uint8_t* b = binHeader(f, mask, n, key ? 1u : 0u, bin);
+  // records are diffed against the one before: a client that missed one sees the gap
+  uint32_t seq = d->frames;
+  binBytes(&b, &seq, 4);
+
+  for (uint32_t h = 0; h < n; ++h) {
+    const FrameHandSrc* s = &f->hands[h];
+    const int32_t* prev = NULL;
+    uint32_t prevPresent = 0;
+    for (uint32_t k = 0; !key && k < d->nHands; ++k)
+      if (d->hands[k].id == s->id) { prev = d->hands[k].q; prevPresent = d->hands[k].present; break; }
+
+    int32_t* q = next.hands[h].q;
+    uint32_t present = 0, changed = 0;
+#define X(NAME, KEY, KIND, N, PREC, SRC, COND)                                              \
+    if ((mask & FM_##NAME) && (COND)) {                                                     \
+      present |= FM_##NAME;                                                                 \
+      DQ_##KIND(q + FQ_##NAME, N, PREC, SRC);                                               \
+      if (!(prevPresent & FM_##NAME) || memcmp(q + FQ_##NAME, prev + FQ_##NAME, (N) * sizeof(int32_t))) changed |= FM_##NAME; \
+    }
+    FRAME_HAND_FIELDS(X)
+#undef X
+    changed &= ~FM_ID;   // the id heads every delta hand
+    next.hands[h].id = s->id;
+    next.hands[h].present = present;
+
+    binBytes(&b, &s->id, 4);
+    binBytes(&b, &present, 4);
+    binBytes(&b, &changed, 4);
+#define X(NAME, KEY, KIND, N, PREC, SRC, COND) if (changed & FM_##NAME) DW_##KIND(&b, q + FQ_##NAME, N);
+    FRAME_HAND_FIELDS(X)
+#undef X
+  }
+  next.nHands = n;
+  *d = next;
+  return binEnvelope("delta", bin, (int)(b - bin), out);
+}
+
+// ---------------------- Masks ---------------------
+uint32_t frameParseFields(const char* names) {
+  if (!strcasecmp(names, "all")) return FM_ALL;
+  uint32_t m = 0;
+  const char* p = names;
+  while (*p) {
+    const char* e = p;
+    while (*e && *e != ',') ++e;
+    size_t len = (size_t)(e - p);
+    uint32_t bit = 0;
+#define X(NAME, KEY, KIND, N, PREC, SRC, COND) \
+    if (!bit && len == sizeof(KEY) - 1 && !strncmp(p, KEY, len)) bit = FM_##NAME;
+    FRAME_HAND_FIELDS(X)
+#undef X
+    if (!bit) return 0;
+    m |= bit;
+    p = *e ? e + 1 : e;
+  }
+  return m | FM_ID;
+}
@@ -0,0 +1,71 @@
+// frame_encode.h
+// Frame record encoders generated from frame_schema.h: JSON (the default "frames" stream),
+// binary ("binary" stream) and delta against the previous frame ("delta" stream).
+// The polling thread gathers each tracking event into a FrameSrc once; each encoder then
+// walks the schema as straight-line code (no format strings are parsed at runtime).
+
+#ifndef ULM_FRAME_ENCODE_H
+#define ULM_FRAME_ENCODE_H
+
+#include <stdint.h>
+#include "LeapC.h"
+#include "frame_schema.h"
+
+#define FRAME_MAX_HANDS      8
+#define FRAME_JSON_SZ        16384
+#define FRAME_HAND_JSON_MAX  1536   // worst-case JSON for one hand (bounded by the schema)
+#define FRAME_BIN_MAX        (64 + FRAME_MAX_HANDS * (12 + FQ_COUNT * 4))
+#define FRAME_BIN_JSON_SZ    (96 + ((FRAME_BIN_MAX + 2) / 3) * 4)
+#define FRAME_DELTA_KEYFRAME 60     // frames between full delta records (late joiners sync here)
+
+// Everything one hand record can carry, gathered once per frame
+typedef struct {
+  uint32_t id, type;            // type: 0 = left, 1 = right
+  float    palmPosition[3], grab, pinch, pinchDistance, grabAngle;
+  float    palmStab[3], palmVel[3], palmQuat[4];
+  float    roll, pitch, yaw, palmNormal[3], palmDir[3], angVel[3];
+  float    palmNorm[3], tipsNorm[15], screen[2];
+  float    tips[15];
+  uint32_t extended;            // bit f = digit f extended
+  float    confidence;          // LeapC's tracking confidence, 0..1
+  uint32_t isNew;               // within its first frames since entering (FrameKin.age)
+  int      hasKin, hasScreen;
+} FrameHandSrc;
+
+typedef struct {
+  int64_t      frameId;
+  int64_t      ts;              // device timestamp, us (LeapGetNow() clock)
+  float        framerate;
+  float        ibox[6];         // xmin, xmax, ymin, ymax, zmin, zmax
+  uint32_t     displayId;
+  uint32_t     nHands;
+  uint32_t     heartbeat;       // sent while idle: the tracking frames before it were skipped
+  FrameHandSrc hands[FRAME_MAX_HANDS];
+} FrameSrc;
+
+// Per-stream delta state (the previous frame, quantized)
+typedef struct {
+  uint32_t frames;
+  uint32_t nHands;
+  struct { uint32_t id, present; int32_t q[FQ_COUNT]; } hands[FRAME_MAX_HANDS];
+} FrameDelta;
+
+// The LEAP_HAND part of a hand source (id, type, palm, strengths, tips, extended flags,
+// confidence). Orientation, lifecycle, normalized points and the screen point are filled
+// in by the caller.
+void frameHandFrom(const LEAP_HAND* hand, FrameHandSrc* s);
+
+// Each writes one complete NDJSON line (with '\n') and returns its length.
+// JSON fits FRAME_JSON_SZ; binary and delta records fit FRAME_BIN_JSON_SZ.
+int  frameEncodeJson(const FrameSrc* f, uint32_t mask, char* out);
+int  frameEncodeBin(const FrameSrc* f, uint32_t mask, char* out);
+int  frameEncodeDelta(FrameDelta* d, const FrameSrc* f, uint32_t mask, char* out);
+void frameDeltaReset(FrameDelta* d);
+// The packed binary record itself (no base64 line), at most FRAME_BIN_MAX bytes; the Node
+// addon hands these to JS through shared memory.
+int  frameEncodeBinRaw(const FrameSrc* f, uint32_t mask, uint8_t* out);
+
+// "palmPosition,pinch,fingers" -> mask; "all" -> FM_ALL; 0 when a name is unknown.
+uint32_t frameParseFields(const char* names);
+
+#endif
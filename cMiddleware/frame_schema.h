@@ -0,0 +1,91 @@
+// frame_schema.h
+// The one definition of the frame record. Every wire format is generated from these
+// tables: the JSON, binary and delta encoders (frame_encode.c), the field-mask bits, and
+// the JS decoder (src/bridges/frameSchema.js, written by tools/gen_frame_schema.c).
+// Adding a field is one line here plus filling its source in FrameHandSrc; then
+// regenerate the JS (cmake --build <dir> --target frame_schema_js).
+//
+// X(NAME, "key", KIND, N, PREC, SRC, COND)
+//   NAME  FM_<NAME> mask bit / FQ_<NAME> delta slot
+//   KIND  U32       uint32                    JSON number
+//         I64       int64                     JSON number (header only)
+//         HANDTYPE  uint32 0 = left, 1 = right JSON "left"/"right"
+//         BOOL      uint32 0 / 1              JSON false/true
+//         F32       one float                 JSON number
+//         VEC       N floats                  JSON [a, b, ...]
+//         VEC3S     N floats as N/3 triples   JSON [[x, y, z], ...]
+//         NAMED3    15 floats, one per finger JSON {"thumb": [x, y, z], ...}
+//         NAMEDB    uint32 bit per finger     JSON {"thumb": true, ...}
+//   N     float count (1 for integer kinds)
+//   PREC  decimals in JSON; also the delta quantum (10^-PREC)
+//   SRC   pointer to the value(s) in `s` (FrameHandSrc) / `f` (FrameSrc)
+//   COND  field present in this record (absent: left out of JSON, NaN in binary)
+//
+// Binary record (little endian, base64 in {"type": "frameBin", "enc": "bin"|"delta", "data": ...}):
+//   u32 mask, header fields in table order, u8 hand count, u8 flags (bit 0: delta keyframe,
+//   bit 1: idle heartbeat, i.e. the frame ids before it were skipped, not lost; JSON
+//   carries "heartbeat": true),
+//   then per hand:
+//     bin:   masked fields in order; U32 4 bytes, HANDTYPE/BOOL/NAMEDB 1 byte, floats f32
+//     delta: u32 seq (after the flags, once per record: +1 per record, 0 on a reset), then
+//            per hand u32 id, u32 present, u32 changed, then changed fields; floats as i32 quanta
+//            (value * 10^PREC); a hand is sent whole on keyframes and when it first appears.
+
+#ifndef ULM_FRAME_SCHEMA_H
+#define ULM_FRAME_SCHEMA_H
+
+#define FRAME_HEADER_FIELDS(X) \
+  X(FRAME_ID,   "frameId",   I64, 1, 0, &f->frameId,   1) \
+  X(TS,         "ts",        I64, 1, 0, &f->ts,        1) \
+  X(FRAMERATE,  "framerate", F32, 1, 1, &f->framerate, 1) \
+  X(IBOX,       "ibox",      VEC, 6, 1, f->ibox,       1) \
+  X(DISPLAY_ID, "displayId", U32, 1, 0, &f->displayId, 1)
+
+#define FRAME_HAND_FIELDS(X) \
+  X(ID,              "id",             U32,       1, 0, &s->id,            1)            \
+  X(TYPE,            "type",           HANDTYPE,  1, 0, &s->type,          1)            \
+  X(PALM_POSITION,   "palmPosition",   VEC,       3, 1, s->palmPosition,   1)            \
+  X(GRAB,            "grab",           F32,       1, 3, &s->grab,          1)            \
+  X(PINCH,           "pinch",          F32,       1, 3, &s->pinch,         1)            \
+  X(PINCH_DISTANCE,  "pinchDistance",  F32,       1, 2, &s->pinchDistance, 1)            \
+  X(GRAB_ANGLE,      "grabAngle",      F32,       1, 3, &s->grabAngle,     1)            \
+  X(PALM_STAB,       "palmStab",       VEC,       3, 1, s->palmStab,       1)            \
+  X(PALM_VEL,        "palmVel",        VEC,       3, 0, s->palmVel,        1)            \
+  X(PALM_QUAT,       "palmQuat",       VEC,       4, 5, s->palmQuat,       1)            \
+  X(ROLL,            "roll",           F32,       1, 4, &s->roll,          s->hasKin)    \
+  X(PITCH,           "pitch",          F32,       1, 4, &s->pitch,         s->hasKin)    \
+  X(YAW,             "yaw",            F32,       1, 4, &s->yaw,           s->hasKin)    \
+  X(PALM_NORMAL,     "palmNormal",     VEC,       3, 4, s->palmNormal,     s->hasKin)    \
+  X(PALM_DIR,        "palmDir",        VEC,       3, 4, s->palmDir,        s->hasKin)    \
+  X(ANG_VEL,         "angVel",         VEC,       3, 3, s->angVel,         s->hasKin)    \
+  X(PALM_NORM,       "palmNorm",       VEC,       3, 4, s->palmNorm,       1)            \
+  X(TIPS_NORM,       "tipsNorm",       VEC3S,    15, 4, s->tipsNorm,       1)            \
+  X(SCREEN,          "screen",         VEC,       2, 1, s->screen,         s->hasScreen) \
+  X(FINGERS,         "fingers",        NAMED3,   15, 1, s->tips,           1)            \
+  X(FINGER_EXTENDED, "fingerExtended", NAMEDB,    1, 0, &s->extended,      1)            \
+  X(CONFIDENCE,      "confidence",     F32,       1, 2, &s->confidence,    1)            \
+  X(IS_NEW,          "isNew",          BOOL,      1, 0, &s->isNew,         1)
+
+// Field bit positions and mask bits: FB_<NAME> = index, FM_<NAME> = 1 << index
+enum {
+#define FRAME_FIELD_BIT(NAME, KEY, KIND, N, PREC, SRC, COND) FB_##NAME,
+  FRAME_HAND_FIELDS(FRAME_FIELD_BIT)
+#undef FRAME_FIELD_BIT
+  FB_COUNT
+};
+enum {
+#define FRAME_FIELD_MASK(NAME, KEY, KIND, N, PREC, SRC, COND) FM_##NAME = 1u << FB_##NAME,
+  FRAME_HAND_FIELDS(FRAME_FIELD_MASK)
+#undef FRAME_FIELD_MASK
+};
+#define FM_ALL ((1u << FB_COUNT) - 1u)
+
+// Delta state slots: FQ_<NAME> is the first of the field's N slots
+enum {
+#define FRAME_FIELD_SLOT(NAME, KEY, KIND, N, PREC, SRC, COND) FQ_##NAME, FQ_##NAME##_LAST = FQ_##NAME + (N) - 1,
+  FRAME_HAND_FIELDS(FRAME_FIELD_SLOT)
+#undef FRAME_FIELD_SLOT
+  FQ_COUNT
+};
+
+#endif
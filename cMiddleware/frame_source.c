@@ -0,0 +1,55 @@
+// frame_source.c
+// Tracking event -> FrameSrc (see frame_source.h).
+
+#include "frame_source.h"
+
+#include <string.h>
+
+uint32_t frameKinematics(KinHistory* hist, KinLife* life, const LEAP_TRACKING_EVENT* frame, FrameKin* k) {
+  uint32_t n = frame->nHands < KIN_MAX_HANDS ? frame->nHands : KIN_MAX_HANDS;
+  for (uint32_t h = 0; h < n; ++h) {
+    const LEAP_QUATERNION* q = &frame->pHands[h].palm.orientation;
+    k->qx[h] = q->x; k->qy[h] = q->y; k->qz[h] = q->z; k->qw[h] = q->w;
+  }
+  KinQuatSoA in = { k->qx, k->qy, k->qz, k->qw };
+  KinOrientSoA out = { k->roll, k->pitch, k->yaw, k->nx, k->ny, k->nz, k->dx, k->dy, k->dz };
+  kinOrientBatch(&in, &out, (int)n);
+  for (uint32_t h = 0; h < n; ++h) {
+    float q[4] = { k->qx[h], k->qy[h], k->qz[h], k->qw[h] };
+    kinAngularVelocity(hist, frame->pHands[h].id, q, frame->info.timestamp, k->w[h]);
+    k->age[h] = kinLifeUpdate(life, frame->pHands[h].id, frame->info.timestamp);
+    k->isNew[h] = k->age[h] <= life->newFrames;
+  }
+  return n;
+}
+
+void frameGather(const LEAP_TRACKING_EVENT* frame, const FrameKin* kin, uint32_t nKin,
+                 const IBoxView* box, FrameSrc* f) {
+  f->frameId = frame->tracking_frame_id;
+  f->ts = frame->info.timestamp;
+  f->framerate = frame->framerate;
+  for (int a = 0; a < 3; ++a) { f->ibox[a * 2] = box->min[a]; f->ibox[a * 2 + 1] = box->min[a] + box->size[a]; }
+  f->displayId = box->hasCal ? box->cal.displayId : 0u;
+  f->nHands = frame->nHands < FRAME_MAX_HANDS ? frame->nHands : FRAME_MAX_HANDS;
+
+  for (uint32_t h = 0; h < f->nHands; ++h) {
+    const LEAP_HAND* hand = &frame->pHands[h];
+    FrameHandSrc* s = &f->hands[h];
+    frameHandFrom(hand, s);
+    if (h < nKin) {
+      s->hasKin = 1;
+      s->roll = kin->roll[h]; s->pitch = kin->pitch[h]; s->yaw = kin->yaw[h];
+      s->palmNormal[0] = kin->nx[h]; s->palmNormal[1] = kin->ny[h]; s->palmNormal[2] = kin->nz[h];
+      s->palmDir[0] = kin->dx[h]; s->palmDir[1] = kin->dy[h]; s->palmDir[2] = kin->dz[h];
+      memcpy(s->angVel, kin->w[h], sizeof(s->angVel));
+      s->isNew = kin->isNew[h];
+    }
+    iboxNorm(box, hand->palm.stabilized_position, s->palmNorm);
+    for (int d = 0; d < 5; ++d) iboxNorm(box, hand->digits[d].distal.next_joint, s->tipsNorm + d * 3);
+    if (box->hasCal) {
+      s->hasScreen = 1;
+      iboxScreen(box, s->tipsNorm[3], s->tipsNorm[4], s->screen);
+    }
+  }
+}
+
@@ -0,0 +1,35 @@
+// frame_source.h
+// Per-tracking-event feature extraction shared by the middleware's polling thread and the
+// Node addon (addon/leap_addon.c): the batched orientation signals and the FrameSrc the
+// schema encoders read (frame_encode.h).
+
+#ifndef ULM_FRAME_SOURCE_H
+#define ULM_FRAME_SOURCE_H
+
+#include <stdint.h>
+#include "LeapC.h"
+#include "kinematics.h"
+#include "ibox.h"
+#include "frame_encode.h"
+
+// Per-frame orientation batch (SoA, one lane per hand)
+typedef struct {
+  float qx[KIN_MAX_HANDS], qy[KIN_MAX_HANDS], qz[KIN_MAX_HANDS], qw[KIN_MAX_HANDS];
+  float roll[KIN_MAX_HANDS], pitch[KIN_MAX_HANDS], yaw[KIN_MAX_HANDS];
+  float nx[KIN_MAX_HANDS], ny[KIN_MAX_HANDS], nz[KIN_MAX_HANDS];
+  float dx[KIN_MAX_HANDS], dy[KIN_MAX_HANDS], dz[KIN_MAX_HANDS];
+  float w[KIN_MAX_HANDS][3];
+  uint32_t age[KIN_MAX_HANDS];        // frames since the hand entered (KinLife)
+  uint8_t  isNew[KIN_MAX_HANDS];      // age <= life->newFrames
+} FrameKin;
+
+// Call on every frame (client or not) so angular velocity always has a previous sample
+// and hand ages count every frame. Returns the number of hands filled in k.
+uint32_t frameKinematics(KinHistory* hist, KinLife* life, const LEAP_TRACKING_EVENT* frame, FrameKin* k);
+
+// FrameSrc for the encoders: raw hand fields, this frame's orientation batch and isNew, points
+// normalized through the interaction box and, once calibrated, the index tip on screen.
+void frameGather(const LEAP_TRACKING_EVENT* frame, const FrameKin* kin, uint32_t nKin,
+                 const IBoxView* box, FrameSrc* f);
+
+#endif
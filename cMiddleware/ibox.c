@@ -0,0 +1,135 @@
+// ibox.c
+// Interaction box state shared by the server thread (commands) and the polling thread
+// (iboxFrame). Auto-fit tracks the palm and index tip with asymmetric rates: the range
+// grows quickly toward new extremes and relaxes slowly, so one stray sample doesn't
+// shrink the usable box and reaching a little further widens it within a few frames.
+
+#include "ibox.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define IBOX_GROW     0.05f    // per frame, toward a sample outside the tracked range
+#define IBOX_RELAX    0.0005f  // per frame, toward the centre
+#define IBOX_MARGIN   15.0f    // mm added around the tracked range
+#define IBOX_MIN_SPAN 120.0f   // mm, smallest box per axis
+
+static const float defaultMin[3] = { -120.0f, 0.0f, -120.0f };
+static const float defaultMax[3] = { 120.0f, 300.0f, 120.0f };
+
+static void setDefault(IBox* b) {
+  memcpy(b->min, defaultMin, sizeof(b->min));
+  memcpy(b->max, defaultMax, sizeof(b->max));
+  for (int a = 0; a < 3; ++a) { b->lo[a] = defaultMin[a] + IBOX_MARGIN; b->hi[a] = defaultMax[a] - IBOX_MARGIN; }
+}
+
+void iboxInit(IBox* b, int autoFit) {
+  memset(b, 0, sizeof(*b));
+  pthread_mutex_init(&b->mu, NULL);
+  setDefault(b);
+  b->autoFit = autoFit;
+}
+
+int iboxConfigure(IBox* b, const char* spec) {
+  if (!strcmp(spec, "auto")) { b->autoFit = 1; return 1; }
+  float v[6];
+  if (sscanf(spec, "%f,%f,%f,%f,%f,%f", &v[0], &v[1], &v[2], &v[3], &v[4], &v[5]) != 6) return 0;
+  for (int a = 0; a < 3; ++a) {
+    if (v[a * 2 + 1] <= v[a * 2]) return 0;
+    b->min[a] = v[a * 2]; b->max[a] = v[a * 2 + 1];
+  }
+  b->autoFit = 0;
+  return 1;
+}
+
+// ------------------- Auto-fit ---------------------
+static void observe(IBox* b, LEAP_VECTOR p) {
+  for (int a = 0; a < 3; ++a) {
+    float x = p.v[a];
+    b->lo[a] += (x < b->lo[a] ? IBOX_GROW : IBOX_RELAX) * (x - b->lo[a]);
+    b->hi[a] += (x > b->hi[a] ? IBOX_GROW : IBOX_RELAX) * (x - b->hi[a]);
+  }
+}
+
+static void fit(IBox* b) {
+  for (int a = 0; a < 3; ++a) {
+    float lo = b->lo[a] - IBOX_MARGIN, hi = b->hi[a] + IBOX_MARGIN;
+    if (hi - lo < IBOX_MIN_SPAN) { float c = 0.5f * (lo + hi); lo = c - 0.5f * IBOX_MIN_SPAN; hi = c + 0.5f * IBOX_MIN_SPAN; }
+    b->min[a] = lo; b->max[a] = hi;
+  }
+}
+
+void iboxFrame(IBox* b, const LEAP_TRACKING_EVENT* frame, const uint8_t* skip, uint32_t nSkip, IBoxView* v) {
+  pthread_mutex_lock(&b->mu);
+  if (b->autoFit && frame->nHands) {
+    for (uint32_t h = 0; h < frame->nHands; ++h) {
+      // entry frames are LeapC's first guesses at the edge of view, not reach
+      if (h < nSkip && skip[h]) continue;
+      observe(b, frame->pHands[h].palm.stabilized_position);
+      observe(b, frame->pHands[h].digits[1].distal.next_joint);
+    }
+    fit(b);
+  }
+  for (int a = 0; a < 3; ++a) { v->min[a] = b->min[a]; v->size[a] = b->max[a] - b->min[a]; }
+  v->hasCal = 0;
+  for (int i = 0; b->activeDisplay && i < IBOX_MAX_DISPLAYS; ++i) {
+    if (b->cals[i].displayId != b->activeDisplay) continue;
+    v->cal = b->cals[i];
+    v->hasCal = 1;
+    break;
+  }
+  pthread_mutex_unlock(&b->mu);
+}
+
+// -------------------- Commands --------------------
+static IBoxCal* calSlot(IBox* b, uint32_t id) {
+  IBoxCal* free = NULL;
+  for (int i = 0; i < IBOX_MAX_DISPLAYS; ++i) {
+    if (b->cals[i].displayId == id) return &b->cals[i];
+    if (!free && !b->cals[i].displayId) free = &b->cals[i];
+  }
+  return free ? free : &b->cals[id % IBOX_MAX_DISPLAYS]; // full: recycle a slot
+}
+
+static int ack(IBox* b, const char* cmd, int ok, char* reply, int sz) {
+  return snprintf(reply, sz,
+    "{\"type\": \"ack\", \"cmd\": \"%s\", \"ok\": %s, \"ibox\": [%.1f, %.1f, %.1f, %.1f, %.1f, %.1f], "
+    "\"auto\": %s, \"display\": %u}\n",
+    cmd, ok ? "true" : "false",
+    b->min[0], b->max[0], b->min[1], b->max[1], b->min[2], b->max[2],
+    b->autoFit ? "true" : "false", b->activeDisplay);
+}
+
+int iboxCommand(IBox* b, const char* line, char* reply, int replySz) {
+  const char* cmd = NULL;
+  int ok = 0;
+  pthread_mutex_lock(&b->mu);
+  if (!strncmp(line, "ibox ", 5)) {
+    cmd = "ibox";
+    const char* arg = line + 5;
+    if (!strcmp(arg, "reset")) { setDefault(b); b->autoFit = 0; ok = 1; }
+    else {
+      float v[6];
+      if (!strcmp(arg, "auto")) ok = iboxConfigure(b, "auto");
+      else if (sscanf(arg, "%f %f %f %f %f %f", &v[0], &v[1], &v[2], &v[3], &v[4], &v[5]) == 6) {
+        char spec[128];
+        snprintf(spec, sizeof(spec), "%f,%f,%f,%f,%f,%f", v[0], v[1], v[2], v[3], v[4], v[5]);
+        ok = iboxConfigure(b, spec);
+      }
+    }
+  } else if (!strncmp(line, "calibrate ", 10)) {
+    cmd = "calibrate";
+    IBoxCal c;
+    if (sscanf(line + 10, "%u %f %f %f %f %f %f", &c.displayId, &c.w, &c.h, &c.x0, &c.x1, &c.y0, &c.y1) == 7
+        && c.displayId && c.w > 0 && c.h > 0 && c.x1 > c.x0 && c.y1 > c.y0) {
+      *calSlot(b, c.displayId) = c;
+      ok = 1;
+    }
+  } else if (!strncmp(line, "display ", 8)) {
+    cmd = "display";
+    ok = sscanf(line + 8, "%u", &b->activeDisplay) == 1;
+  }
+  int len = cmd ? ack(b, cmd, ok, reply, replySz) : 0;
+  pthread_mutex_unlock(&b->mu);
+  return len > 0 ? len : 0;
+}
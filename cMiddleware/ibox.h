@@ -0,0 +1,72 @@
+// ibox.h
+// The middleware's single interaction box: maps tracking millimetres to [0,1]^3 once per
+// frame, so clients receive pre-normalized points instead of re-deriving them. The box is
+// fixed (--ibox / "ibox" command) or auto-fit to the observed hand range. Per-display
+// calibration (the HUD's two-point rect plus the display size) is uploaded once over the
+// control socket; points of the active display then also arrive in screen pixels.
+//
+// Control lines (any subscriber socket; each is answered with an ack record):
+//   ibox <xmin> <xmax> <ymin> <ymax> <zmin> <zmax>   fixed box, disables auto-fit
+//   ibox auto | ibox reset                          auto-fit on | default fixed box
+//   calibrate <displayId> <w> <h> <x0> <x1> <y0> <y1>
+//   display <displayId>                             active display (0 = none)
+
+#ifndef ULM_IBOX_H
+#define ULM_IBOX_H
+
+#include <stdint.h>
+#include <pthread.h>
+#include "LeapC.h"
+
+#define IBOX_MAX_DISPLAYS 8
+
+typedef struct {
+  uint32_t displayId;   // 0 = free
+  float    w, h;        // display size in points
+  float    x0, x1, y0, y1;
+} IBoxCal;
+
+// Per-frame copy taken by the polling thread; commands never touch it mid-frame.
+typedef struct {
+  float    min[3], size[3];
+  int      hasCal;
+  IBoxCal  cal;
+} IBoxView;
+
+typedef struct {
+  pthread_mutex_t mu;
+  float    min[3], max[3];     // active box (mm)
+  int      autoFit;
+  float    lo[3], hi[3];       // auto-fit: observed hand range trackers
+  IBoxCal  cals[IBOX_MAX_DISPLAYS];
+  uint32_t activeDisplay;
+} IBox;
+
+void iboxInit(IBox* b, int autoFit);
+// Parses "auto" or "xmin,xmax,ymin,ymax,zmin,zmax". Returns 0 on a malformed spec.
+int  iboxConfigure(IBox* b, const char* spec);
+
+// Polling thread: feeds this frame's hands to auto-fit and snapshots box + calibration.
+// Hands h < nSkip with skip[h] set (still entering: FrameKin.isNew) don't move the box.
+void iboxFrame(IBox* b, const LEAP_TRACKING_EVENT* frame, const uint8_t* skip, uint32_t nSkip, IBoxView* v);
+
+static inline float iboxClamp01(float v) { return v < 0 ? 0 : (v > 1 ? 1 : v); }
+
+static inline void iboxNorm(const IBoxView* v, LEAP_VECTOR p, float out[3]) {
+  out[0] = iboxClamp01((p.x - v->min[0]) / v->size[0]);
+  out[1] = iboxClamp01((p.y - v->min[1]) / v->size[1]);
+  out[2] = iboxClamp01((p.z - v->min[2]) / v->size[2]);
+}
+
+// Normalized point -> active display pixels through its calibration rect (y down).
+static inline void iboxScreen(const IBoxView* v, float nx, float ny, float out[2]) {
+  const IBoxCal* c = &v->cal;
+  out[0] = iboxClamp01((nx - c->x0) / (c->x1 - c->x0)) * c->w;
+  out[1] = (1.0f - iboxClamp01((ny - c->y0) / (c->y1 - c->y0))) * c->h;
+}
+
+// Handles one control line. When it is an ibox/calibrate/display command, writes an
+// NDJSON ack into reply and returns its length; returns 0 otherwise.
+int  iboxCommand(IBox* b, const char* line, char* reply, int replySz);
+
+#endif
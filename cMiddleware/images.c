@@ -0,0 +1,212 @@
+// images.c
+// Image channel: staging hand-off from the polling thread, downscale + publish on the
+// image thread (see images.h for the pool layout and isolation rules).
+
+#include "images.h"
+#include "metrics.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <time.h>
+#include <sys/mman.h>
+
+#define IMG_WAKE_NS 20000000L   // image thread re-checks staging at least every 20 ms
+
+enum { STAGE_FREE = 0, STAGE_FULL = 1 };
+
+struct ImageChannel {
+  SubList*   subs;
+  uint32_t   scale;
+  int64_t    minGapUs;
+  int64_t    lastTs;
+
+  // staging (polling thread -> image thread)
+  atomic_int stage;
+  uint8_t*   raw;
+  uint32_t   rawW, rawH, rawBpp, rawCount;
+  int64_t    rawFrameId, rawTs;
+
+  // pool
+  int        fd;
+  uint8_t*   map;
+  size_t     mapBytes;
+  uint32_t   slotBytes;
+  uint32_t   nextSlot;
+
+  pthread_t       thread;
+  pthread_mutex_t mu;
+  pthread_cond_t  cv;
+  int             quit;
+  RtThread        rt;
+
+  uint64_t published, limited, busy;
+  MetShard* met;   // image thread's shard
+};
+
+// --------------------- Util -----------------------
+static void putU32(uint8_t* p, uint32_t v) { memcpy(p, &v, 4); }
+static void putI64(uint8_t* p, int64_t v) { memcpy(p, &v, 8); }
+
+static void storeSeq(uint8_t* slot, uint32_t seq) {
+  atomic_thread_fence(memory_order_release);
+  atomic_store_explicit((_Atomic uint32_t*)slot, seq, memory_order_relaxed);
+  atomic_thread_fence(memory_order_release);
+}
+
+// Box filter for 8-bit IR; other formats keep the top-left sample of each block.
+static void downscale(const uint8_t* src, uint32_t w, uint32_t h, uint32_t bpp, uint32_t k, uint8_t* dst) {
+  uint32_t ow = w / k, oh = h / k;
+  if (k == 1) { memcpy(dst, src, (size_t)w * h * bpp); return; }
+  if (bpp != 1) {
+    for (uint32_t y = 0; y < oh; ++y)
+      for (uint32_t x = 0; x < ow; ++x)
+        memcpy(dst + ((size_t)y * ow + x) * bpp, src + ((size_t)y * k * w + x * k) * bpp, bpp);
+    return;
+  }
+  uint32_t area = k * k;
+  for (uint32_t y = 0; y < oh; ++y) {
+    for (uint32_t x = 0; x < ow; ++x) {
+      uint32_t sum = 0;
+      for (uint32_t dy = 0; dy < k; ++dy) {
+        const uint8_t* row = src + (size_t)(y * k + dy) * w + x * k;
+        for (uint32_t dx = 0; dx < k; ++dx) sum += row[dx];
+      }
+      dst[(size_t)y * ow + x] = (uint8_t)(sum / area);
+    }
+  }
+}
+
+// ------------------ Image thread ------------------
+static void publish(ImageChannel* ch) {
+  uint32_t k = ch->scale, ow = ch->rawW / k, oh = ch->rawH / k;
+  uint32_t slot = ch->nextSlot;
+  ch->nextSlot = (ch->nextSlot + 1) % IMG_SLOTS;
+  uint8_t* base = ch->map + IMG_HDR_BYTES + (size_t)slot * ch->slotBytes;
+
+  uint32_t seq = atomic_load_explicit((_Atomic uint32_t*)base, memory_order_relaxed);
+  storeSeq(base, seq + 1);  // odd: writing
+  size_t perImage = (size_t)ow * oh * ch->rawBpp, rawPer = (size_t)ch->rawW * ch->rawH * ch->rawBpp;
+  for (uint32_t i = 0; i < ch->rawCount; ++i)
+    downscale(ch->raw + i * rawPer, ch->rawW, ch->rawH, ch->rawBpp, k, base + IMG_HDR_BYTES + i * perImage);
+  putU32(base + 4, ow); putU32(base + 8, oh); putU32(base + 12, ch->rawCount);
+  putU32(base + 16, ch->rawBpp); putU32(base + 20, (uint32_t)(perImage * ch->rawCount));
+  putI64(base + 24, ch->rawFrameId); putI64(base + 32, ch->rawTs);
+  storeSeq(base, seq + 2);
+
+  char json[256];
+  int len = snprintf(json, sizeof(json),
+    "{\"type\": \"image\", \"frameId\": %lld, \"ts\": %lld, \"slot\": %u, \"seq\": %u, "
+    "\"width\": %u, \"height\": %u, \"count\": %u, \"bpp\": %u}\n",
+    (long long)ch->rawFrameId, (long long)ch->rawTs, slot, seq + 2, ow, oh, ch->rawCount, ch->rawBpp);
+  subBroadcast(ch->subs, SUB_IMAGES, json, len);
+  ch->published++;
+  metAdd(ch->met, MET_IMAGES_PUBLISHED, 1);
+}
+
+static void* imageLoop(void* arg) {
+  ImageChannel* ch = arg;
+  rtApplyThread("images", &ch->rt);
+  ch->met = metShard("images");
+  pthread_mutex_lock(&ch->mu);
+  while (!ch->quit) {
+    if (atomic_load(&ch->stage) != STAGE_FULL) {
+      // bounded wait: a try-signal lost between the check and the wait costs one tick
+      struct timespec until; clock_gettime(CLOCK_REALTIME, &until);
+      until.tv_nsec += IMG_WAKE_NS;
+      if (until.tv_nsec >= 1000000000L) { until.tv_sec++; until.tv_nsec -= 1000000000L; }
+      pthread_cond_timedwait(&ch->cv, &ch->mu, &until);
+      continue;
+    }
+    pthread_mutex_unlock(&ch->mu);
+    publish(ch);
+    atomic_store(&ch->stage, STAGE_FREE);
+    pthread_mutex_lock(&ch->mu);
+  }
+  pthread_mutex_unlock(&ch->mu);
+  return NULL;
+}
+
+// ---------------- Polling thread side -------------
+int imgOffer(ImageChannel* ch, const LEAP_IMAGE_EVENT* ev) {
+  int64_t ts = ev->info.timestamp;
+  if (ch->lastTs && ts - ch->lastTs < ch->minGapUs) { ch->limited++; return 0; }
+  if (atomic_load(&ch->stage) != STAGE_FREE) { ch->busy++; return 0; }
+
+  const LEAP_IMAGE_PROPERTIES* p = &ev->image[0].properties;
+  size_t per = (size_t)p->width * p->height * p->bpp;
+  if (!per || per * 2 > IMG_MAX_PIXELS) { ch->limited++; return 0; }
+  for (int i = 0; i < 2; ++i)
+    memcpy(ch->raw + i * per, (const uint8_t*)ev->image[i].data + ev->image[i].offset, per);
+  ch->rawW = p->width; ch->rawH = p->height; ch->rawBpp = p->bpp; ch->rawCount = 2;
+  ch->rawFrameId = ev->info.frame_id; ch->rawTs = ts;
+  ch->lastTs = ts;
+  atomic_store(&ch->stage, STAGE_FULL);
+
+  // try-signal only: if the image thread holds the lock it is about to re-check stage
+  if (pthread_mutex_trylock(&ch->mu) == 0) { pthread_cond_signal(&ch->cv); pthread_mutex_unlock(&ch->mu); }
+  return 1;
+}
+
+// ---------------------- Lifecycle -----------------
+ImageChannel* imgCreate(const char* shmPath, uint32_t maxFps, uint32_t scale, SubList* subs, const RtConfig* rt) {
+  ImageChannel* ch = calloc(1, sizeof(*ch));
+  if (!ch) return NULL;
+  ch->subs = subs;
+  if (rt) ch->rt = rt->images;
+  else ch->rt = (RtThread){ .cpu = RT_NO_CPU };
+  ch->scale = scale ? scale : 1;
+  ch->minGapUs = maxFps ? 1000000 / maxFps : 0;
+  ch->slotBytes = (IMG_HDR_BYTES + IMG_MAX_PIXELS + 63) & ~63u;
+  ch->mapBytes = IMG_HDR_BYTES + (size_t)IMG_SLOTS * ch->slotBytes;
+  ch->raw = malloc(IMG_MAX_PIXELS);
+
+  ch->fd = open(shmPath, O_RDWR | O_CREAT | O_TRUNC, 0600);
+  if (!ch->raw || ch->fd < 0 || ftruncate(ch->fd, (off_t)ch->mapBytes) != 0) {
+    perror("[Images] pool file");
+    if (ch->fd >= 0) close(ch->fd);
+    free(ch->raw); free(ch);
+    return NULL;
+  }
+  ch->map = mmap(NULL, ch->mapBytes, PROT_READ | PROT_WRITE, MAP_SHARED, ch->fd, 0);
+  if (ch->map == MAP_FAILED) {
+    perror("[Images] mmap");
+    close(ch->fd); free(ch->raw); free(ch);
+    return NULL;
+  }
+  memcpy(ch->map, "ULMIMG01", 8);
+  putU32(ch->map + 8, IMG_SLOTS); putU32(ch->map + 12, ch->slotBytes); putU32(ch->map + 16, IMG_MAX_PIXELS);
+  // the first image otherwise faults in every slot page on the image thread
+  rtPrefault(rt, ch->raw, IMG_MAX_PIXELS);
+  rtPrefault(rt, ch->map, ch->mapBytes);
+
+  pthread_mutex_init(&ch->mu, NULL);
+  pthread_cond_init(&ch->cv, NULL);
+  if (pthread_create(&ch->thread, NULL, imageLoop, ch) != 0) {
+    fprintf(stderr, "[Images] Could not create image thread\n");
+    munmap(ch->map, ch->mapBytes); close(ch->fd); free(ch->raw); free(ch);
+    return NULL;
+  }
+  return ch;
+}
+
+void imgDestroy(ImageChannel* ch) {
+  if (!ch) return;
+  pthread_mutex_lock(&ch->mu);
+  ch->quit = 1;
+  pthread_cond_signal(&ch->cv);
+  pthread_mutex_unlock(&ch->mu);
+  pthread_join(ch->thread, NULL);
+  munmap(ch->map, ch->mapBytes);
+  close(ch->fd);
+  free(ch->raw);
+  free(ch);
+}
+
+void imgStats(const ImageChannel* ch, uint64_t* published, uint64_t* limited, uint64_t* busy) {
+  *published = ch->published; *limited = ch->limited; *busy = ch->busy;
+}
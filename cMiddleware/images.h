@@ -0,0 +1,47 @@
+// images.h
+// Optional IR image channel. Pixels never enter the socket stream: the image thread
+// downscales each accepted frame into a slot of a file-backed mmap pool and broadcasts a
+// small notification record to "images" subscribers, who read the slot in place:
+//   {"type": "image", "frameId": N, "ts": us, "slot": k, "seq": s, "width": w, "height": h, "count": 2, "bpp": 1}
+//
+// Pool file layout (little endian, see src/bridges/imageChannel.js):
+//   [file header, IMG_HDR_BYTES]  magic "ULMIMG01", u32 slots, u32 slotBytes, u32 maxPixelBytes
+//   [slot 0 .. slots-1, slotBytes each]  slot header (IMG_HDR_BYTES) + count stacked images
+// Slot header: u32 seq (odd while the image thread writes it), u32 width, u32 height,
+// u32 count, u32 bpp, u32 bytes, i64 frameId, i64 ts. A reader that sees seq change
+// while copying has a torn image and drops it.
+//
+// Isolation: the polling thread only rate-limits, memcpys the raw event into a single
+// staging buffer when it is free and try-signals the image thread; it never waits on it.
+
+#ifndef ULM_IMAGES_H
+#define ULM_IMAGES_H
+
+#include <stdint.h>
+#include "LeapC.h"
+#include "subscribers.h"
+#include "rt.h"
+
+#define IMG_SLOTS         4
+#define IMG_HDR_BYTES     64
+#define IMG_MAX_PIXELS    (2 * 1024 * 1024)   // raw bytes per event (both cameras)
+#define IMG_DEFAULT_SHM   "/tmp/ultraleap_images.shm"
+#define IMG_DEFAULT_FPS   15
+#define IMG_DEFAULT_SCALE 2
+
+typedef struct ImageChannel ImageChannel;
+
+// Creates the pool file and starts the image thread. scale is the integer downscale
+// factor (1 = full size); maxFps limits accepted frames by device timestamp. rt (may be
+// NULL) supplies the image thread's pinning/policy and, with prealloc, pre-faults the pool.
+ImageChannel* imgCreate(const char* shmPath, uint32_t maxFps, uint32_t scale, SubList* subs, const RtConfig* rt);
+void          imgDestroy(ImageChannel* ch);
+
+// Polling thread: never blocks. Returns 1 if the event was handed to the image thread,
+// 0 if it was rate-limited or dropped because the previous one is still in flight.
+int           imgOffer(ImageChannel* ch, const LEAP_IMAGE_EVENT* ev);
+
+// Cumulative counters: published images, rate-limited and busy drops.
+void          imgStats(const ImageChannel* ch, uint64_t* published, uint64_t* limited, uint64_t* busy);
+
+#endif
@@ -0,0 +1,115 @@
+// kinematics.c
+// Palm basis from the orientation quaternion: Leap's hand frame has the palm normal along
+// -Y and the fingers along -Z, so normal = q*(0,-1,0)*q' and direction = q*(0,0,-1)*q'.
+// Only the needed rotation-matrix columns are expanded; angles come from those vectors
+// exactly as LeapJS derives them (roll from the normal, pitch/yaw from the direction).
+
+#include "kinematics.h"
+
+#include <math.h>
+#include <string.h>
+
+#define KIN_PI   3.14159265358979f
+#define KIN_PI_2 1.57079632679490f
+#define KIN_MAX_DT_US 200000   // longer gaps (tracking lost) restart the derivative
+
+// --------------------- atan2 ----------------------
+// Branch-free minimax atan on [0,1] plus octant fix-up; compiles to selects.
+static inline float fastAtan2(float y, float x) {
+  float ax = fabsf(x), ay = fabsf(y);
+  float mx = ax > ay ? ax : ay, mn = ax > ay ? ay : ax;
+  float a = mn / (mx + 1e-30f);
+  float s = a * a;
+  float r = ((-0.0464964749f * s + 0.15931422f) * s - 0.327622764f) * s * a + a;
+  r = ay > ax ? KIN_PI_2 - r : r;
+  r = x < 0.0f ? KIN_PI - r : r;
+  return y < 0.0f ? -r : r;
+}
+
+// --------------------- Batch ----------------------
+void kinOrientBatch(const KinQuatSoA* q, const KinOrientSoA* o, int n) {
+  for (int i = 0; i < n; ++i) {
+    float x = q->x[i], y = q->y[i], z = q->z[i], w = q->w[i];
+    // -(second column) and -(third column) of the rotation matrix
+    float nx = -2.0f * (x * y - w * z);
+    float ny = -(1.0f - 2.0f * (x * x + z * z));
+    float nz = -2.0f * (y * z + w * x);
+    float dx = -2.0f * (x * z + w * y);
+    float dy = -2.0f * (y * z - w * x);
+    float dz = -(1.0f - 2.0f * (x * x + y * y));
+    o->nx[i] = nx; o->ny[i] = ny; o->nz[i] = nz;
+    o->dx[i] = dx; o->dy[i] = dy; o->dz[i] = dz;
+    o->roll[i]  = fastAtan2(nx, -ny);
+    o->pitch[i] = fastAtan2(dy, -dz);
+    o->yaw[i]   = fastAtan2(dx, -dz);
+  }
+}
+
+void kinOrientRef(const float q[4], float rpy[3], float normal[3], float dir[3]) {
+  float x = q[0], y = q[1], z = q[2], w = q[3];
+  normal[0] = -2.0f * (x * y - w * z);
+  normal[1] = -(1.0f - 2.0f * (x * x + z * z));
+  normal[2] = -2.0f * (y * z + w * x);
+  dir[0] = -2.0f * (x * z + w * y);
+  dir[1] = -2.0f * (y * z - w * x);
+  dir[2] = -(1.0f - 2.0f * (x * x + y * y));
+  rpy[0] = atan2f(normal[0], -normal[1]);
+  rpy[1] = atan2f(dir[1], -dir[2]);
+  rpy[2] = atan2f(dir[0], -dir[2]);
+}
+
+// ----------------- Angular velocity ---------------
+void kinHistoryReset(KinHistory* h) { memset(h, 0, sizeof(*h)); }
+
+// Slot of id in a by-id table (ids + last-seen times), else the oldest one, freed
+static int slotIn(const uint32_t* ids, int64_t* tUs, uint32_t id) {
+  int oldest = 0;
+  for (int i = 0; i < KIN_MAX_HANDS; ++i) {
+    if (tUs[i] && ids[i] == id) return i;
+    if (tUs[i] < tUs[oldest]) oldest = i;
+  }
+  tUs[oldest] = 0; // recycled: no previous sample for this id
+  return oldest;
+}
+
+static int slotFor(KinHistory* h, uint32_t id) { return slotIn(h->id, h->tUs, id); }
+
+void kinAngularVelocity(KinHistory* h, uint32_t id, const float q[4], int64_t tUs, float w[3]) {
+  int s = slotFor(h, id);
+  float* p = h->q[s];
+  int64_t dtUs = tUs - h->tUs[s];
+  w[0] = w[1] = w[2] = 0.0f;
+
+  if (h->tUs[s] && dtUs > 0 && dtUs < KIN_MAX_DT_US) {
+    // dq = q * conj(p): rotation since the previous frame, in world axes
+    float dw =  q[3] * p[3] + q[0] * p[0] + q[1] * p[1] + q[2] * p[2];
+    float dx = -q[3] * p[0] + q[0] * p[3] - q[1] * p[2] + q[2] * p[1];
+    float dy = -q[3] * p[1] + q[1] * p[3] - q[2] * p[0] + q[0] * p[2];
+    float dz = -q[3] * p[2] + q[2] * p[3] - q[0] * p[1] + q[1] * p[0];
+    if (dw < 0.0f) { dw = -dw; dx = -dx; dy = -dy; dz = -dz; } // shortest arc
+    float sn = sqrtf(dx * dx + dy * dy + dz * dz);
+    if (sn > 1e-9f) {
+      float k = 2.0f * atan2f(sn, dw) / sn / ((float)dtUs * 1e-6f);
+      w[0] = dx * k; w[1] = dy * k; w[2] = dz * k;
+    }
+  }
+  h->id[s] = id;
+  memcpy(p, q, sizeof(float) * 4);
+  h->tUs[s] = tUs;
+}
+
+// ----------------- Hand lifecycle -----------------
+void kinLifeReset(KinLife* l, uint32_t newFrames) {
+  memset(l, 0, sizeof(*l));
+  l->newFrames = newFrames ? newFrames : KIN_NEW_FRAMES;
+}
+
+uint32_t kinLifeUpdate(KinLife* l, uint32_t id, int64_t tUs) {
+  int s = slotIn(l->id, l->tUs, id);
+  int64_t dtUs = tUs - l->tUs[s];
+  if (!l->tUs[s] || dtUs < 0 || dtUs > KIN_LIFE_GAP_US) l->age[s] = 0;
+  if (l->age[s] < UINT32_MAX) l->age[s]++;
+  l->id[s] = id;
+  l->tUs[s] = tUs;
+  return l->age[s];
+}
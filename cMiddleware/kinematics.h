@@ -0,0 +1,60 @@
+// kinematics.h
+// Derived hand orientation signals computed from the palm quaternion: roll/pitch/yaw,
+// palm normal and direction, and angular velocity from the previous frame's orientation.
+// Angles follow the LeapJS conventions the JS side already uses (hand.roll()/pitch()/yaw()).
+
+#ifndef ULM_KINEMATICS_H
+#define ULM_KINEMATICS_H
+
+#include <stdint.h>
+
+#define KIN_MAX_HANDS  8        // per-frame batch size and history slots
+#define KIN_NEW_FRAMES 6        // default frames a hand counts as new after entering
+#define KIN_LIFE_GAP_US 200000  // an id unseen this long enters again
+
+// Structure-of-arrays batch: one entry per hand, so a whole frame (or several devices'
+// frames) goes through the kernel in a single vectorizable loop.
+typedef struct {
+  const float *x, *y, *z, *w;           // palm.orientation
+} KinQuatSoA;
+
+typedef struct {
+  float *roll, *pitch, *yaw;            // radians
+  float *nx, *ny, *nz;                  // palm normal (unit)
+  float *dx, *dy, *dz;                  // palm direction (unit, toward the fingers)
+} KinOrientSoA;
+
+// Angular-velocity history: last orientation per hand id, oldest slot recycled.
+typedef struct {
+  uint32_t id[KIN_MAX_HANDS];
+  float    q[KIN_MAX_HANDS][4];
+  int64_t  tUs[KIN_MAX_HANDS];          // 0 = free
+} KinHistory;
+
+// Hand lifecycle: frames since each hand id entered view, oldest slot recycled. A hand is
+// new for its first newFrames frames, while LeapC's model of it is still settling.
+typedef struct {
+  uint32_t id[KIN_MAX_HANDS];
+  uint32_t age[KIN_MAX_HANDS];          // frames seen, 1 on the entry frame
+  int64_t  tUs[KIN_MAX_HANDS];          // last seen; 0 = free
+  uint32_t newFrames;
+} KinLife;
+
+// Quaternion -> normal/direction/Euler for n hands. Uses a polynomial atan2 (max error
+// ~2e-4 rad) instead of libm so the loop has no calls and no branches.
+void kinOrientBatch(const KinQuatSoA* q, const KinOrientSoA* out, int n);
+
+// Same outputs for one hand using libm atan2f (reference for tests/benches).
+void kinOrientRef(const float q[4], float rpy[3], float normal[3], float dir[3]);
+
+// Angular velocity (rad/s, world axes) of hand id since its previous sample at tUs
+// (device timestamp, microseconds). Writes zeros on a hand's first frame.
+void kinAngularVelocity(KinHistory* h, uint32_t id, const float q[4], int64_t tUs, float w[3]);
+void kinHistoryReset(KinHistory* h);
+
+// Frames hand id has been in view, this one included (1: it entered on this frame). An id
+// unseen for KIN_LIFE_GAP_US, or seen at an earlier timestamp, enters again.
+uint32_t kinLifeUpdate(KinLife* l, uint32_t id, int64_t tUs);
+void     kinLifeReset(KinLife* l, uint32_t newFrames);   // 0 = KIN_NEW_FRAMES
+
+#endif
@@ -2,247 +2,205 @@
 // Streams Ultraleap Gemini tracking over a local TCP socket as newline-delimited JSON.
 // Adds rich hand signals: grab, pinch, pinchDistance, grabAngle, palmStabilized, palmVelocity, palmQuaternion,
 // per-finger extended flags, and frame framerate. Also prints compact per-frame logs.
+// Orientation signals (roll/pitch/yaw, palmNormal, palmDir, angVel) are derived from the
+// palm quaternion in one batch per frame (kinematics.c).
+// With --gestures <dir>, Trainer segments are matched live (recognizer.c) and emitted as
+// {"type":"gesture",...} records on the same stream.
+// Several clients may connect at once (subscribers.c); each one opts into extra streams,
+// e.g. the full skeleton (skeleton.c), with a "subscribe skeleton" line on its socket.
+// With --images, IR images are published through a shared-memory pool (images.c) while
+// at least one client subscribes to "images".
+// Points are normalized here through one interaction box (ibox.c: fixed, --ibox, or
+// auto-fit) and, once a client uploads a display calibration, mapped to screen pixels.
+// Latency options (rt.c): per-thread CPU pinning, SCHED_FIFO/RR, mlockall, pre-faulting.
+// Runtime metrics (metrics.c) answer a "stats" control line and, with --metrics-port, a
+// local HTTP listener (GET /metrics: Prometheus text, GET /stats: JSON).
+// Frame records are generated from one field table (frame_schema.h) in three encodings:
+// JSON ("frames"), packed binary ("binary") and deltas ("delta"); --fields trims them.
+// --idle-ms drops to heartbeat-only output while no hand is in view (pipeline.h).
+// Each hand carries "isNew" for its first --new-frames frames and LeapC's "confidence".
+// This file is only the command line: the pipeline (pipeline.c) does the polling and
+// encoding, the TCP transport (server.c) the sockets.
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <unistd.h>              // close(), usleep()
-#include <pthread.h>
-#include <arpa/inet.h>
-#include <netinet/in.h>
-#include <sys/socket.h>
-#include <errno.h>
-#include <stdarg.h>
 
-#include "LeapC.h"  // Ultraleap LeapC SDK
+#include "pipeline.h"
+#include "server.h"
+#include "images.h"
+#include "rt.h"
 
 // --------------------- Config ---------------------
 #define SERVER_PORT 8000
-#define JSON_BUF_SZ 16384
-
-// --------------------- Globals --------------------
-static LEAP_CONNECTION leapConnection;
-static volatile int running = 0;
-static int clientSock = -1;
-
-// --------------------- Util -----------------------
-static const char* ResultString(eLeapRS r){
-  switch(r){
-    case eLeapRS_Success: return "eLeapRS_Success";
-    case eLeapRS_UnknownError: return "eLeapRS_UnknownError";
-    case eLeapRS_InvalidArgument: return "eLeapRS_InvalidArgument";
-    case eLeapRS_InsufficientResources: return "eLeapRS_InsufficientResources";
-    case eLeapRS_InsufficientBuffer: return "eLeapRS_InsufficientBuffer";
-    case eLeapRS_Timeout: return "eLeapRS_Timeout";
-    case eLeapRS_NotConnected: return "eLeapRS_NotConnected";
-    case eLeapRS_HandshakeIncomplete: return "eLeapRS_HandshakeIncomplete";
-    case eLeapRS_BufferSizeOverflow: return "eLeapRS_BufferSizeOverflow";
-    case eLeapRS_ProtocolError: return "eLeapRS_ProtocolError";
-    case eLeapRS_InvalidClientID: return "eLeapRS_InvalidClientID";
-    case eLeapRS_UnexpectedClosed: return "eLeapRS_UnexpectedClosed";
-    case eLeapRS_UnknownImageFrameRequest: return "eLeapRS_UnknownImageFrameRequest";
-    case eLeapRS_UnknownTrackingFrameID: return "eLeapRS_UnknownTrackingFrameID";
-    case eLeapRS_RoutineIsNotSeer: return "eLeapRS_RoutineIsNotSeer";
-    case eLeapRS_TimestampTooEarly: return "eLeapRS_TimestampTooEarly";
-    case eLeapRS_ConcurrentPoll: return "eLeapRS_ConcurrentPoll";
-    case eLeapRS_NotAvailable: return "eLeapRS_NotAvailable";
-    case eLeapRS_NotStreaming: return "eLeapRS_NotStreaming";
-    case eLeapRS_CannotOpenDevice: return "eLeapRS_CannotOpenDevice";
-    default: return "UnknownResult";
+#define GESTURE_BUDGET_US 1000   // default per-frame recognizer budget
+#define RT_STACK_PREFAULT (128 * 1024)
+
+// ----------------------- Log ----------------------
+// Compact per-frame summary on stdout, before the frame is encoded.
+static void logStage(void* user, UlmCtx* ctx, const UlmFrame* f) {
+  (void)user; (void)ctx;
+  const LEAP_TRACKING_EVENT* frame = f->ev;
+  printf("[LeapC] Frame %lld: hands=%u, fps=%.1f\n",
+         (long long)frame->tracking_frame_id, frame->nHands, frame->framerate);
+  for (uint32_t h = 0; h < frame->nHands; ++h) {
+    const LEAP_HAND* hand = &frame->pHands[h];
+    int extCount = 0;
+    for (int d = 0; d < 5; ++d) extCount += !!hand->digits[d].is_extended;
+    printf("  hand id=%u type=%s grab=%.2f pinch=%.2f dist=%.1f angle=%.2f ext=%d  extended:[%d %d %d %d %d]\n",
+           hand->id,
+           (hand->type == eLeapHandType_Left ? "left" : "right"),
+           hand->grab_strength, hand->pinch_strength,
+           hand->pinch_distance, hand->grab_angle,
+           extCount,
+           (int)hand->digits[0].is_extended, (int)hand->digits[1].is_extended,
+           (int)hand->digits[2].is_extended, (int)hand->digits[3].is_extended,
+           (int)hand->digits[4].is_extended);
   }
+  fflush(stdout);
 }
 
-static inline void jappend(char* json, int* len, const char* fmt, ...) {
-  if (*len >= JSON_BUF_SZ) return;
-  va_list ap; va_start(ap, fmt);
-  int n = vsnprintf(json + *len, JSON_BUF_SZ - *len, fmt, ap);
-  va_end(ap);
-  if (n > 0) *len += (n > (JSON_BUF_SZ - *len) ? (JSON_BUF_SZ - *len) : n);
+// ---------------------- main() --------------------
+static void usage(const char* argv0) {
+  fprintf(stderr,
+    "Usage: %s [--gestures <dir>] [--gesture-budget-us <n>] [--gesture-threshold <f>] [--skeleton]\n"
+    "          [--images] [--image-fps <n>] [--image-scale <n>] [--image-shm <path>]\n"
+    "          [--ibox auto|<xmin,xmax,ymin,ymax,zmin,zmax>]\n"
+    "          [--cpu-poll <n>] [--cpu-server <n>] [--cpu-images <n>] [--sched fifo|rr|other] [--rt-prio <n>]\n"
+    "          [--mlock] [--prealloc] [--metrics-port <n>] [--fields <list|all>]\n"
+    "          [--idle-ms <n>] [--idle-heartbeat-ms <n>] [--idle-images-off]\n"
+    "          [--new-frames <n>]\n"
+    "  --gestures <dir>          match Trainer segments (<label>.ndjson) live and emit gesture records\n"
+    "  --gesture-budget-us <n>   recognizer time budget per frame (default %d, 0 = unbounded)\n"
+    "  --gesture-threshold <f>   normalized DTW cost accepted as a match (default 0.15)\n"
+    "  --skeleton                subscribe every client to the skeleton stream on connect\n"
+    "  --images                  enable the IR image channel (clients \"subscribe images\")\n"
+    "  --image-fps <n>           images published per second at most (default %d)\n"
+    "  --image-scale <n>         integer downscale factor (default %d, 1 = full size)\n"
+    "  --image-shm <path>        shared-memory pool file (default %s)\n"
+    "  --ibox <spec>             interaction box in mm, or \"auto\" to fit the observed hand range\n"
+    "                            (default -120,120,0,300,-120,120)\n"
+    "  --cpu-poll <n>            pin the polling/encode thread to CPU n (macOS: affinity hint)\n"
+    "  --cpu-server <n>          pin the accept/command thread to CPU n\n"
+    "  --cpu-images <n>          pin the image thread to CPU n\n"
+    "  --sched <policy>          real-time policy for the polling thread (the server thread\n"
+    "                            gets it one priority lower); needs CAP_SYS_NICE/rtprio\n"
+    "  --rt-prio <n>             real-time priority (default %d)\n"
+    "  --mlock                   mlockall() current and future pages\n"
+    "  --prealloc                pre-fault stacks, frame and image buffers at startup\n"
+    "  --metrics-port <n>        serve GET /metrics (Prometheus) and /stats (JSON) on localhost:n\n"
+    "  --fields <list|all>       hand fields in frame records, e.g. id,type,palmNorm,tipsNorm,pinch\n"
+    "                            (names from frame_schema.h; default all)\n"
+    "  --idle-ms <n>             after n ms with no hand, send only heartbeat frames until a hand\n"
+    "                            appears (default 0 = off)\n"
+    "  --idle-heartbeat-ms <n>   one frame this often while idle (default 1000)\n"
+    "  --idle-images-off         drop the Images policy while idle\n"
+    "  --new-frames <n>          frames a hand is flagged isNew after entering (default %d)\n"
+    "Clients may send \"subscribe <streams>\" / \"unsubscribe <streams>\" lines (frames, binary, delta,\n"
+    "skeleton, images),\n"
+    "ibox/calibrate/display control lines (see ibox.h) and \"stats\" (one JSON metrics line).\n",
+    argv0, GESTURE_BUDGET_US, IMG_DEFAULT_FPS, IMG_DEFAULT_SCALE, IMG_DEFAULT_SHM, RT_DEFAULT_PRIO,
+    KIN_NEW_FRAMES);
 }
 
-// ------------------- Polling Thread ---------------
-static void* leapTrackingLoop(void* unused) {
-  const char* fingerNames[5] = {"thumb","index","middle","ring","pinky"};
-  static uint64_t lastTrackTs = 0;
-  static uint64_t lastHeartbeatUs = 0;
-
-  while (running) {
-    LEAP_CONNECTION_MESSAGE msg;
-    eLeapRS res = LeapPollConnection(leapConnection, 1000, &msg);
-    if (res != eLeapRS_Success) {
-      if (res == eLeapRS_Timeout) {
-        // heartbeat if no tracking yet every ~2s
-        uint64_t nowUs = LeapGetNow();
-        if (lastTrackTs == 0 && nowUs - lastHeartbeatUs > 2000000) {
-          printf("[LeapC] Waiting for tracking frames...\n"); fflush(stdout);
-          lastHeartbeatUs = nowUs;
-        }
-        continue;
-      }
-      fprintf(stderr, "LeapPollConnection error: %s\n", ResultString(res));
-      continue;
+int main(int argc, char** argv) {
+  UlmConfig cfg;
+  ulmDefaults(&cfg);
+  cfg.gestureBudgetUs = GESTURE_BUDGET_US;
+  uint32_t defaultStreams = SUB_FRAMES;
+  int imagesOn = 0;
+  uint32_t imageFps = IMG_DEFAULT_FPS, imageScale = IMG_DEFAULT_SCALE;
+  const char* imageShm = IMG_DEFAULT_SHM;
+  RtConfig rt;
+  RtSched sched = RT_SCHED_OTHER;
+  int rtPrio = RT_DEFAULT_PRIO;
+  int metricsPort = 0;
+  rtDefaults(&rt);
+  for (int i = 1; i < argc; ++i) {
+    if (!strcmp(argv[i], "--gestures") && i + 1 < argc) cfg.gesturesDir = argv[++i];
+    else if (!strcmp(argv[i], "--gesture-budget-us") && i + 1 < argc) cfg.gestureBudgetUs = (uint32_t)strtoul(argv[++i], NULL, 10);
+    else if (!strcmp(argv[i], "--gesture-threshold") && i + 1 < argc) cfg.gestureThreshold = strtof(argv[++i], NULL);
+    else if (!strcmp(argv[i], "--skeleton")) defaultStreams |= SUB_SKELETON;
+    else if (!strcmp(argv[i], "--images")) imagesOn = 1;
+    else if (!strcmp(argv[i], "--image-fps") && i + 1 < argc) imageFps = (uint32_t)strtoul(argv[++i], NULL, 10);
+    else if (!strcmp(argv[i], "--image-scale") && i + 1 < argc) imageScale = (uint32_t)strtoul(argv[++i], NULL, 10);
+    else if (!strcmp(argv[i], "--image-shm") && i + 1 < argc) imageShm = argv[++i];
+    else if (!strcmp(argv[i], "--ibox") && i + 1 < argc) {
+      IBox probe;
+      iboxInit(&probe, 0);
+      if (!iboxConfigure(&probe, argv[++i])) { usage(argv[0]); return EXIT_FAILURE; }
+      cfg.ibox = argv[i];
     }
-
-    switch (msg.type) {
-      case eLeapEventType_Connection:
-        printf("[LeapC] Connected to service.\n"); fflush(stdout);
-        break;
-
-      case eLeapEventType_ConnectionLost:
-        fprintf(stderr, "[LeapC] Connection lost.\n");
-        running = 0;
-        break;
-
-      case eLeapEventType_Device:
-        printf("[LeapC] Device connected.\n"); fflush(stdout);
-        break;
-
-      case eLeapEventType_DeviceLost:
-        fprintf(stderr, "[LeapC] Device disconnected.\n");
-        break;
-
-      case eLeapEventType_Tracking: {
-        const LEAP_TRACKING_EVENT* frame = msg.tracking_event;
-        lastTrackTs = frame->info.timestamp;
-
-        // ---------- LOG: frame summary ----------
-        printf("[LeapC] Frame %lld: hands=%u, fps=%.1f\n",
-               (long long)frame->tracking_frame_id, frame->nHands, frame->framerate);
-        for (uint32_t h = 0; h < frame->nHands; ++h) {
-          const LEAP_HAND* hand = &frame->pHands[h];
-          int extCount = 0;
-          for (int f = 0; f < 5; ++f) extCount += !!hand->digits[f].is_extended;
-          printf("  hand id=%u type=%s grab=%.2f pinch=%.2f dist=%.1f angle=%.2f ext=%d  extended:[%d %d %d %d %d]\n",
-                 hand->id,
-                 (hand->type == eLeapHandType_Left ? "left" : "right"),
-                 hand->grab_strength, hand->pinch_strength,
-                 hand->pinch_distance, hand->grab_angle,
-                 extCount,
-                 (int)hand->digits[0].is_extended, (int)hand->digits[1].is_extended,
-                 (int)hand->digits[2].is_extended, (int)hand->digits[3].is_extended,
-                 (int)hand->digits[4].is_extended);
-        }
-        fflush(stdout);
-
-        // ---------- JSON: send to Node bridge ----------
-        if (clientSock >= 0) {
-          char json[JSON_BUF_SZ];
-          int len = 0;
-          long long frameId = (long long)frame->tracking_frame_id;
-
-          jappend(json, &len, "{\"frameId\": %lld, \"framerate\": %.1f, \"hands\": [", frameId, frame->framerate);
-
-          for (uint32_t h = 0; h < frame->nHands; ++h) {
-            const LEAP_HAND* hand = &frame->pHands[h];
-            const char* handType = (hand->type == eLeapHandType_Left ? "left" : "right");
-
-            // open hand object
-            jappend(json, &len,
-              "{\"id\": %u, \"type\": \"%s\", "
-              "\"palmPosition\": [%.1f, %.1f, %.1f], "
-              "\"grab\": %.3f, \"pinch\": %.3f, "
-              "\"pinchDistance\": %.2f, \"grabAngle\": %.3f, "
-              "\"palmStab\": [%.1f, %.1f, %.1f], "
-              "\"palmVel\":  [%.0f, %.0f, %.0f], "
-              "\"palmQuat\": [%.5f, %.5f, %.5f, %.5f], "
-              "\"fingers\": {",
-              hand->id, handType,
-              hand->palm.position.x, hand->palm.position.y, hand->palm.position.z,
-              hand->grab_strength, hand->pinch_strength,
-              hand->pinch_distance, hand->grab_angle,
-              hand->palm.stabilized_position.x, hand->palm.stabilized_position.y, hand->palm.stabilized_position.z,
-              hand->palm.velocity.x, hand->palm.velocity.y, hand->palm.velocity.z,
-              hand->palm.orientation.x, hand->palm.orientation.y, hand->palm.orientation.z, hand->palm.orientation.w
-            );
-
-            // finger tips (arrays) — keep legacy shape your JS already knows
-            for (int f = 0; f < 5; ++f) {
-              LEAP_VECTOR tip = hand->digits[f].distal.next_joint;
-              jappend(json, &len,
-                "\"%s\": [%.1f, %.1f, %.1f]%s",
-                fingerNames[f], tip.x, tip.y, tip.z, (f < 4 ? ", " : "")
-              );
-            }
-
-            // close fingers object, add parallel "fingerExtended" map
-            jappend(json, &len, "}, \"fingerExtended\": {");
-            for (int f = 0; f < 5; ++f) {
-              jappend(json, &len,
-                "\"%s\": %s%s",
-                fingerNames[f],
-                hand->digits[f].is_extended ? "true" : "false",
-                (f < 4 ? ", " : "")
-              );
-            }
-
-            // close hand object
-            jappend(json, &len, "}}%s", (h < frame->nHands - 1 ? "," : ""));
-          }
-
-          // close hands + frame
-          jappend(json, &len, "]}\n");
-
-          // send
-          ssize_t sent = send(clientSock, json, len, 0);
-          if (sent < 0) { perror("Send error"); running = 0; }
-        }
-        break;
-      }
-
-      default: /* ignore others */ break;
+    else if (!strcmp(argv[i], "--cpu-poll") && i + 1 < argc) {
+      if (!rtParseCpu(argv[++i], &rt.poll.cpu)) { usage(argv[0]); return EXIT_FAILURE; }
+    }
+    else if (!strcmp(argv[i], "--cpu-server") && i + 1 < argc) {
+      if (!rtParseCpu(argv[++i], &rt.server.cpu)) { usage(argv[0]); return EXIT_FAILURE; }
     }
+    else if (!strcmp(argv[i], "--cpu-images") && i + 1 < argc) {
+      if (!rtParseCpu(argv[++i], &rt.images.cpu)) { usage(argv[0]); return EXIT_FAILURE; }
+    }
+    else if (!strcmp(argv[i], "--sched") && i + 1 < argc) {
+      if (!rtParseSched(argv[++i], &sched)) { usage(argv[0]); return EXIT_FAILURE; }
+    }
+    else if (!strcmp(argv[i], "--rt-prio") && i + 1 < argc) rtPrio = atoi(argv[++i]);
+    else if (!strcmp(argv[i], "--mlock")) rt.lockMemory = 1;
+    else if (!strcmp(argv[i], "--prealloc")) rt.prealloc = 1;
+    else if (!strcmp(argv[i], "--metrics-port") && i + 1 < argc) metricsPort = atoi(argv[++i]);
+    else if (!strcmp(argv[i], "--fields") && i + 1 < argc) {
+      if (!(cfg.fieldMask = frameParseFields(argv[++i]))) { usage(argv[0]); return EXIT_FAILURE; }
+    }
+    else if (!strcmp(argv[i], "--idle-ms") && i + 1 < argc) cfg.idleMs = (uint32_t)strtoul(argv[++i], NULL, 10);
+    else if (!strcmp(argv[i], "--idle-heartbeat-ms") && i + 1 < argc) cfg.idleHeartbeatMs = (uint32_t)strtoul(argv[++i], NULL, 10);
+    else if (!strcmp(argv[i], "--idle-images-off")) cfg.idleImagesOff = 1;
+    else if (!strcmp(argv[i], "--new-frames") && i + 1 < argc) cfg.newFrames = (uint32_t)strtoul(argv[++i], NULL, 10);
+    else { usage(argv[0]); return EXIT_FAILURE; }
   }
-  return NULL;
-}
 
-// ---------------------- main() --------------------
-int main(int argc, char** argv) {
-  eLeapRS r;
-  r = LeapCreateConnection(NULL, &leapConnection);
-  if (r != eLeapRS_Success) { fprintf(stderr, "ERROR: LeapCreateConnection failed (%s)\n", ResultString(r)); return EXIT_FAILURE; }
+  // Tracking first: frames are what the cursor waits on. Images stay best-effort (default
+  // policy) unless pinned; they are rate-limited and never block the polling thread.
+  rt.poll.sched = rt.server.sched = sched;
+  rt.poll.prio = rtPrio;
+  rt.server.prio = rtPrio > 1 ? rtPrio - 1 : rtPrio;
+  rtApplyProcess(&rt);
+  cfg.rt = &rt;
 
-  r = LeapOpenConnection(leapConnection);
-  if (r != eLeapRS_Success) { fprintf(stderr, "ERROR: LeapOpenConnection failed (%s)\n", ResultString(r)); return EXIT_FAILURE; }
+  UlmCtx* ctx = ulmCreate(&cfg);
+  if (!ctx) { fprintf(stderr, "ERROR: Could not create the tracking pipeline\n"); return EXIT_FAILURE; }
+  ulmAddStage(ctx, &(UlmStage){ "log", ULM_STAGE_PRE, logStage, NULL });
 
-  // Enable background frames so service streams regardless of focus
-  uint32_t setFlags = eLeapPolicyFlag_BackgroundFrames; // | eLeapPolicyFlag_Images;
-  eLeapRS pr = LeapSetPolicyFlags(leapConnection, setFlags, 0);
-  printf("[LeapC] Set policy flags result: %s\n", ResultString(pr)); fflush(stdout);
+  // TCP server
+  Server* server = srvCreate(ctx, SERVER_PORT, metricsPort, defaultStreams);
+  if (!server) { ulmDestroy(ctx); return EXIT_FAILURE; }
+  UlmSink sink;
+  srvSink(server, &sink);
+  ulmAddSink(ctx, &sink);
+
+  ImageChannel* images = NULL;
+  if (imagesOn) {
+    images = imgCreate(imageShm, imageFps, imageScale, srvSubs(server), &rt);
+    if (images) { printf("[Images] Pool %s (%d slots, <= %u fps, 1/%u scale)\n", imageShm, IMG_SLOTS, imageFps, imageScale); fflush(stdout); }
+    ulmAttachImages(ctx, images);
+  }
 
-  running = 1;
-  pthread_t leapThread;
-  if (pthread_create(&leapThread, NULL, leapTrackingLoop, NULL) != 0) {
-    fprintf(stderr, "ERROR: Could not create LeapC polling thread\n");
+  UlmSource source;
+  if (!ulmLeapSource(&source) || !ulmStart(ctx, &source)) {
+    srvDestroy(server); ulmDestroy(ctx); imgDestroy(images);
     return EXIT_FAILURE;
   }
 
-  // TCP server
-  int server_fd = socket(AF_INET, SOCK_STREAM, 0);
-  if (server_fd < 0) { perror("socket() failed"); return EXIT_FAILURE; }
-  int optval = 1; setsockopt(server_fd, SOL_SOCKET, SO_REUSEADDR, &optval, sizeof(optval));
-
-  struct sockaddr_in serv_addr;
-  memset(&serv_addr, 0, sizeof(serv_addr));
-  serv_addr.sin_family = AF_INET;
-  serv_addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
-  serv_addr.sin_port = htons(SERVER_PORT);
-
-  if (bind(server_fd, (struct sockaddr*)&serv_addr, sizeof(serv_addr)) < 0) { perror("bind() failed"); close(server_fd); return EXIT_FAILURE; }
-  if (listen(server_fd, 1) < 0) { perror("listen() failed"); close(server_fd); return EXIT_FAILURE; }
-
   printf("LeapC middleware: Listening on localhost:%d …\n", SERVER_PORT); fflush(stdout);
 
-  struct sockaddr_in client_addr; socklen_t client_len = sizeof(client_addr);
-  clientSock = accept(server_fd, (struct sockaddr*)&client_addr, &client_len);
-  if (clientSock < 0) { perror("accept() failed"); running = 0; }
-  else { printf("Client connected. Streaming hand tracking data…\n"); fflush(stdout); }
+  rtApplyThread("server", &rt.server);
+  rtPrefaultStack(&rt, RT_STACK_PREFAULT / 4);
+  if (rt.prealloc) { printf("[RT] prealloc: stacks, heap trim off%s\n", images ? ", image pool" : ""); fflush(stdout); }
 
-  pthread_join(leapThread, NULL);
+  srvRun(server);
 
-  if (clientSock >= 0) close(clientSock);
-  close(server_fd);
-  LeapCloseConnection(leapConnection);
-  LeapDestroyConnection(leapConnection);
+  ulmStop(ctx);
+  srvDestroy(server);
+  ulmDestroy(ctx);
+  imgDestroy(images);
   printf("LeapC middleware terminated.\n"); fflush(stdout);
   return 0;
 }
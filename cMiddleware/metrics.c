@@ -0,0 +1,188 @@
+// metrics.c
+// Per-thread shards and on-demand aggregation (see metrics.h).
+
+#include "metrics.h"
+
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include <time.h>
+
+const uint32_t metBucketBounds[MET_BUCKETS - 1] = { 5, 10, 25, 50, 100, 250, 500, 1000, 2500, 5000, 10000 };
+
+static const struct { const char* json; const char* prom; const char* help; } counterNames[MET_COUNTER_COUNT] = {
+  [MET_FRAMES_IN]         = { "framesIn",        "ulm_frames_in_total",         "Tracking events polled from LeapC" },
+  [MET_FRAMES_ENCODED]    = { "framesEncoded",   "ulm_frames_encoded_total",    "Frame records built for subscribers" },
+  [MET_POLL_TIMEOUTS]     = { "pollTimeouts",    "ulm_poll_timeouts_total",     "LeapPollConnection timeouts" },
+  [MET_POLL_ERRORS]       = { "pollErrors",      "ulm_poll_errors_total",       "LeapPollConnection errors other than timeouts" },
+  [MET_GESTURES]          = { "gestures",        "ulm_gestures_total",          "Recognizer matches" },
+  [MET_SKELETON_RECORDS]  = { "skeletonRecords", "ulm_skeleton_records_total",  "Skeleton records built" },
+  [MET_IMAGES_PUBLISHED]  = { "imagesPublished", "ulm_images_published_total",  "IR images published to the pool" },
+  [MET_CLIENTS_ACCEPTED]  = { "clientsAccepted", "ulm_clients_accepted_total",  "Client connections accepted" },
+  [MET_FRAMES_IDLE]       = { "framesIdle",      "ulm_frames_idle_total",       "Tracking events skipped while idle" },
+};
+
+static const struct { const char* json; const char* prom; const char* help; } gaugeNames[MET_GAUGE_COUNT] = {
+  [MET_FRAMERATE_MILLI] = { "framerate",   "ulm_framerate",           "Device framerate reported by the last frame (Hz)" },
+  [MET_HANDS]           = { "hands",       "ulm_hands",               "Hands in the last frame" },
+  [MET_CLIENTS]         = { "clients",     "ulm_clients",             "Connected clients" },
+  [MET_LAST_FRAME_US]   = { "lastFrameUs", "ulm_last_frame_age_seconds", "Seconds since the last tracking event" },
+  [MET_IDLE]            = { "idle",        "ulm_idle",                "1 while no hand has been seen for the idle period" },
+};
+
+static const struct { const char* json; const char* prom; const char* help; } histNames[MET_HIST_COUNT] = {
+  [MET_H_ENCODE_US]    = { "encodeUs",   "ulm_encode_seconds",    "Frame record build time" },
+  [MET_H_SEND_US]      = { "sendUs",     "ulm_send_seconds",      "Frame record broadcast time" },
+  [MET_H_FRAME_GAP_US] = { "frameGapUs", "ulm_frame_gap_seconds", "Device time between tracking events" },
+};
+
+static MetShard shards[MET_MAX_SHARDS];
+static atomic_int shardCount;
+static MetShard overflow;   // shared by threads past MET_MAX_SHARDS (never expected)
+
+MetShard* metShard(const char* thread) {
+  int i = atomic_fetch_add(&shardCount, 1);
+  if (i >= MET_MAX_SHARDS) { atomic_store(&shardCount, MET_MAX_SHARDS); return &overflow; }
+  shards[i].thread = thread;
+  return &shards[i];
+}
+
+uint64_t metNowUs(void) {
+  struct timespec ts; clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000ull + (uint64_t)ts.tv_nsec / 1000;
+}
+
+void metObserve(MetShard* s, MetHist h, uint64_t us) {
+  int b = 0;
+  while (b < MET_BUCKETS - 1 && us > metBucketBounds[b]) ++b;
+  uint64_t v = atomic_load_explicit(&s->bucket[h][b], memory_order_relaxed);
+  atomic_store_explicit(&s->bucket[h][b], v + 1, memory_order_relaxed);
+  v = atomic_load_explicit(&s->sum[h], memory_order_relaxed);
+  atomic_store_explicit(&s->sum[h], v + us, memory_order_relaxed);
+}
+
+void metPollError(MetShard* s, int32_t code) {
+  metAdd(s, MET_POLL_ERRORS, 1);
+  for (int i = 0; i < MET_ERR_SLOTS; ++i) {
+    int32_t c = atomic_load_explicit(&s->errCode[i], memory_order_relaxed);
+    if (c && c != code) continue;
+    if (!c) atomic_store_explicit(&s->errCode[i], code, memory_order_relaxed);
+    uint64_t v = atomic_load_explicit(&s->errCount[i], memory_order_relaxed);
+    atomic_store_explicit(&s->errCount[i], v + 1, memory_order_relaxed);
+    return;
+  }
+}
+
+// ------------------- Aggregation ------------------
+typedef struct {
+  uint64_t counter[MET_COUNTER_COUNT];
+  int64_t  gauge[MET_GAUGE_COUNT];
+  uint64_t bucket[MET_HIST_COUNT][MET_BUCKETS];
+  uint64_t sum[MET_HIST_COUNT];
+  int32_t  errCode[MET_MAX_SHARDS * MET_ERR_SLOTS];
+  uint64_t errCount[MET_MAX_SHARDS * MET_ERR_SLOTS];
+  int      nErr;
+} MetTotals;
+
+static void addShard(MetTotals* t, MetShard* s) {
+  for (int c = 0; c < MET_COUNTER_COUNT; ++c) t->counter[c] += atomic_load_explicit(&s->counter[c], memory_order_relaxed);
+  // each gauge has a single writing thread; the others stay 0
+  for (int g = 0; g < MET_GAUGE_COUNT; ++g) t->gauge[g] += atomic_load_explicit(&s->gauge[g], memory_order_relaxed);
+  for (int h = 0; h < MET_HIST_COUNT; ++h) {
+    for (int b = 0; b < MET_BUCKETS; ++b) t->bucket[h][b] += atomic_load_explicit(&s->bucket[h][b], memory_order_relaxed);
+    t->sum[h] += atomic_load_explicit(&s->sum[h], memory_order_relaxed);
+  }
+  for (int i = 0; i < MET_ERR_SLOTS; ++i) {
+    int32_t code = atomic_load_explicit(&s->errCode[i], memory_order_relaxed);
+    if (!code) break;
+    uint64_t n = atomic_load_explicit(&s->errCount[i], memory_order_relaxed);
+    int k = 0;
+    while (k < t->nErr && t->errCode[k] != code) ++k;
+    if (k == t->nErr) { t->errCode[k] = code; t->errCount[k] = 0; t->nErr++; }
+    t->errCount[k] += n;
+  }
+}
+
+static void collect(MetTotals* t) {
+  memset(t, 0, sizeof(*t));
+  int n = atomic_load(&shardCount);
+  for (int i = 0; i < n && i < MET_MAX_SHARDS; ++i) addShard(t, &shards[i]);
+  addShard(t, &overflow);
+}
+
+static void append(char* out, size_t cap, int* len, const char* fmt, ...) {
+  if ((size_t)*len >= cap) return;
+  va_list ap; va_start(ap, fmt);
+  int n = vsnprintf(out + *len, cap - (size_t)*len, fmt, ap);
+  va_end(ap);
+  if (n > 0) *len += ((size_t)n >= cap - (size_t)*len ? (int)(cap - (size_t)*len - 1) : n);
+}
+
+static double gaugeValue(const MetTotals* t, int g) {
+  if (g == MET_FRAMERATE_MILLI) return t->gauge[g] / 1000.0;
+  if (g == MET_LAST_FRAME_US) return t->gauge[g] ? (double)((int64_t)metNowUs() - t->gauge[g]) / 1e6 : -1;
+  return (double)t->gauge[g];
+}
+
+int metRenderJson(char* out, size_t cap, MetErrName errName, const char* extra) {
+  MetTotals t;
+  collect(&t);
+  int len = 0;
+  append(out, cap, &len, "{\"type\": \"stats\", \"counters\": {");
+  for (int c = 0; c < MET_COUNTER_COUNT; ++c)
+    append(out, cap, &len, "%s\"%s\": %llu", c ? ", " : "", counterNames[c].json, (unsigned long long)t.counter[c]);
+  append(out, cap, &len, "}, \"gauges\": {");
+  for (int g = 0; g < MET_GAUGE_COUNT; ++g) {
+    // lastFrameUs goes out as an age, like the Prometheus gauge
+    const char* name = g == MET_LAST_FRAME_US ? "lastFrameAgeS" : gaugeNames[g].json;
+    append(out, cap, &len, "%s\"%s\": %.3f", g ? ", " : "", name, gaugeValue(&t, g));
+  }
+  append(out, cap, &len, "}, \"histograms\": {");
+  for (int h = 0; h < MET_HIST_COUNT; ++h) {
+    uint64_t count = 0;
+    append(out, cap, &len, "%s\"%s\": {\"le\": [", h ? ", " : "", histNames[h].json);
+    for (int b = 0; b < MET_BUCKETS - 1; ++b) append(out, cap, &len, "%s%u", b ? ", " : "", metBucketBounds[b]);
+    append(out, cap, &len, "], \"counts\": [");
+    for (int b = 0; b < MET_BUCKETS; ++b) {
+      count += t.bucket[h][b];
+      append(out, cap, &len, "%s%llu", b ? ", " : "", (unsigned long long)t.bucket[h][b]);
+    }
+    append(out, cap, &len, "], \"count\": %llu, \"sum\": %llu}", (unsigned long long)count, (unsigned long long)t.sum[h]);
+  }
+  append(out, cap, &len, "}, \"pollErrors\": {");
+  for (int i = 0; i < t.nErr; ++i)
+    append(out, cap, &len, "%s\"%s\": %llu", i ? ", " : "", errName(t.errCode[i]), (unsigned long long)t.errCount[i]);
+  append(out, cap, &len, "}%s%s}", extra ? ", " : "", extra ? extra : "");
+  return len;
+}
+
+int metRenderProm(char* out, size_t cap, MetErrName errName, const char* extra) {
+  MetTotals t;
+  collect(&t);
+  int len = 0;
+  for (int c = 0; c < MET_COUNTER_COUNT; ++c)
+    append(out, cap, &len, "# HELP %s %s\n# TYPE %s counter\n%s %llu\n",
+           counterNames[c].prom, counterNames[c].help, counterNames[c].prom,
+           counterNames[c].prom, (unsigned long long)t.counter[c]);
+  append(out, cap, &len, "# HELP ulm_poll_errors_by_code_total LeapPollConnection errors by result code\n"
+                         "# TYPE ulm_poll_errors_by_code_total counter\n");
+  for (int i = 0; i < t.nErr; ++i)
+    append(out, cap, &len, "ulm_poll_errors_by_code_total{code=\"%s\"} %llu\n", errName(t.errCode[i]), (unsigned long long)t.errCount[i]);
+  for (int g = 0; g < MET_GAUGE_COUNT; ++g)
+    append(out, cap, &len, "# HELP %s %s\n# TYPE %s gauge\n%s %.3f\n",
+           gaugeNames[g].prom, gaugeNames[g].help, gaugeNames[g].prom, gaugeNames[g].prom, gaugeValue(&t, g));
+  for (int h = 0; h < MET_HIST_COUNT; ++h) {
+    const char* n = histNames[h].prom;
+    uint64_t cum = 0;
+    append(out, cap, &len, "# HELP %s %s\n# TYPE %s histogram\n", n, histNames[h].help, n);
+    for (int b = 0; b < MET_BUCKETS - 1; ++b) {
+      cum += t.bucket[h][b];
+      append(out, cap, &len, "%s_bucket{le=\"%g\"} %llu\n", n, metBucketBounds[b] / 1e6, (unsigned long long)cum);
+    }
+    cum += t.bucket[h][MET_BUCKETS - 1];
+    append(out, cap, &len, "%s_bucket{le=\"+Inf\"} %llu\n%s_sum %g\n%s_count %llu\n",
+           n, (unsigned long long)cum, n, t.sum[h] / 1e6, n, (unsigned long long)cum);
+  }
+  if (extra) append(out, cap, &len, "%s", extra);
+  return len;
+}
@@ -0,0 +1,96 @@
+// metrics.h
+// Runtime counters and latency histograms, scraped on demand.
+// Every thread that records owns a shard (metShard) and is its only writer, so updates are
+// relaxed atomic load+store — no lock, no locked RMW on the tracking path. Readers
+// (the "stats" control line, the optional HTTP listener) sum all shards with relaxed loads;
+// a scrape may be a few events behind but never tears a counter.
+//
+// Output:
+//   metRenderJson  -> {"type": "stats", "counters": {...}, "gauges": {...}, "histograms": {...}, "pollErrors": {...}}
+//   metRenderProm  -> Prometheus text exposition (ulm_* metric families)
+// Per-client series and socket totals live in the subscriber list (subStats); the caller
+// renders them and passes the fragment in as extra.
+
+#ifndef ULM_METRICS_H
+#define ULM_METRICS_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdatomic.h>
+
+#define MET_MAX_SHARDS   8
+#define MET_ERR_SLOTS    16    // distinct LeapPollConnection error codes kept
+#define MET_BUCKETS      12    // histogram buckets incl. +Inf
+
+// Counters (monotonic)
+typedef enum {
+  MET_FRAMES_IN,          // tracking events polled
+  MET_FRAMES_ENCODED,     // frame records built (someone subscribed)
+  MET_POLL_TIMEOUTS,
+  MET_POLL_ERRORS,        // everything but timeouts; by code in pollErrors
+  MET_GESTURES,           // recognizer matches
+  MET_SKELETON_RECORDS,
+  MET_IMAGES_PUBLISHED,
+  MET_CLIENTS_ACCEPTED,
+  MET_FRAMES_IDLE,        // tracking events skipped in idle mode (pipeline.h idleMs)
+  MET_COUNTER_COUNT
+} MetCounter;
+
+// Gauges (last value wins)
+typedef enum {
+  MET_FRAMERATE_MILLI,    // device framerate * 1000
+  MET_HANDS,
+  MET_CLIENTS,
+  MET_LAST_FRAME_US,      // metNowUs() at the last tracking event (rendered as an age)
+  MET_IDLE,               // 1 while in idle (heartbeat-only) mode
+  MET_GAUGE_COUNT
+} MetGauge;
+
+// Histograms (microseconds)
+typedef enum {
+  MET_H_ENCODE_US,        // frame record build, per encoding
+  MET_H_SEND_US,          // broadcast of one frame record
+  MET_H_FRAME_GAP_US,     // device timestamp delta between tracking events
+  MET_HIST_COUNT
+} MetHist;
+
+typedef struct {
+  const char* thread;
+  _Atomic uint64_t counter[MET_COUNTER_COUNT];
+  _Atomic int64_t  gauge[MET_GAUGE_COUNT];
+  _Atomic uint64_t bucket[MET_HIST_COUNT][MET_BUCKETS];
+  _Atomic uint64_t sum[MET_HIST_COUNT];
+  _Atomic int32_t  errCode[MET_ERR_SLOTS];   // 0 = free
+  _Atomic uint64_t errCount[MET_ERR_SLOTS];
+} MetShard;
+
+// Upper bounds (us) of the first MET_BUCKETS-1 buckets; the last one is +Inf.
+extern const uint32_t metBucketBounds[MET_BUCKETS - 1];
+
+// Registers a shard for the calling thread (once per thread, at startup).
+MetShard* metShard(const char* thread);
+
+static inline void metAdd(MetShard* s, MetCounter c, uint64_t n) {
+  uint64_t v = atomic_load_explicit(&s->counter[c], memory_order_relaxed);
+  atomic_store_explicit(&s->counter[c], v + n, memory_order_relaxed);
+}
+
+static inline void metSet(MetShard* s, MetGauge g, int64_t v) {
+  atomic_store_explicit(&s->gauge[g], v, memory_order_relaxed);
+}
+
+void metObserve(MetShard* s, MetHist h, uint64_t us);
+void metPollError(MetShard* s, int32_t code);
+
+// Monotonic microseconds for timing spans.
+uint64_t metNowUs(void);
+
+typedef const char* (*MetErrName)(int32_t code);
+
+// Render the aggregate of all shards; return the length written (truncated to cap).
+// extra (may be NULL): JSON members added to the top-level object / Prometheus lines
+// appended at the end.
+int metRenderJson(char* out, size_t cap, MetErrName errName, const char* extra);
+int metRenderProm(char* out, size_t cap, MetErrName errName, const char* extra);
+
+#endif
@@ -0,0 +1,482 @@
+// pipeline.c
+// Tracking pipeline behind an explicit context (pipeline.h). Everything the polling loop
+// used to keep in leap_middleware.c globals (connection, running flag, kinematics history,
+// interaction box, delta state, recognizer) lives in UlmCtx.
+
+#include "pipeline.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+#include "kinematics.h"
+#include "recognizer.h"
+#include "skeleton.h"
+#include "subscribers.h"
+
+#define IMAGE_POLICY_CHECK_US 500000
+#define RT_STACK_PREFAULT (128 * 1024)   // > skeleton buffer + frame batch on the polling stack
+#define HEARTBEAT_US      2000000
+
+struct UlmCtx {
+  UlmConfig   cfg;
+  UlmSource   src;
+  pthread_t   thread;
+  atomic_int  running;
+  int         started;
+
+  UlmStage    stages[ULM_MAX_STAGES];
+  int         nStages;
+  UlmEncoder  enc[ULM_MAX_ENCODERS];
+  int         nEnc;
+  UlmSink     sinks[ULM_MAX_SINKS];
+  int         nSinks;
+
+  IBox        ibox;
+  KinHistory  kin;               // polling thread only
+  KinLife     life;              // polling thread only
+  FrameSrc    frameSrc;          // polling thread only; too big for the stack budget
+  FrameDelta  delta;             // shared by every "delta" sink
+  char*       out;               // encode buffer, largest encoder cap
+  size_t      outCap;
+  Recognizer* rec;
+  ImageChannel* images;
+  int         imagesOn;
+  uint64_t    lastPolicyCheckUs;
+  MetShard*   met;
+  int64_t     lastTrackTs;
+  uint64_t    lastHeartbeatUs;
+  int         idle;              // polling thread only, as the two below
+  int64_t     lastHandTs;        // device time of the last frame with a hand
+  int64_t     lastBeatTs;        // device time of the last frame sent while idle
+};
+
+const char* ulmResultString(eLeapRS r) {
+  switch(r){
+    case eLeapRS_Success: return "eLeapRS_Success";
+    case eLeapRS_UnknownError: return "eLeapRS_UnknownError";
+    case eLeapRS_InvalidArgument: return "eLeapRS_InvalidArgument";
+    case eLeapRS_InsufficientResources: return "eLeapRS_InsufficientResources";
+    case eLeapRS_InsufficientBuffer: return "eLeapRS_InsufficientBuffer";
+    case eLeapRS_Timeout: return "eLeapRS_Timeout";
+    case eLeapRS_NotConnected: return "eLeapRS_NotConnected";
+    case eLeapRS_HandshakeIncomplete: return "eLeapRS_HandshakeIncomplete";
+    case eLeapRS_BufferSizeOverflow: return "eLeapRS_BufferSizeOverflow";
+    case eLeapRS_ProtocolError: return "eLeapRS_ProtocolError";
+    case eLeapRS_InvalidClientID: return "eLeapRS_InvalidClientID";
+    case eLeapRS_UnexpectedClosed: return "eLeapRS_UnexpectedClosed";
+    case eLeapRS_UnknownImageFrameRequest: return "eLeapRS_UnknownImageFrameRequest";
+    case eLeapRS_UnknownTrackingFrameID: return "eLeapRS_UnknownTrackingFrameID";
+    case eLeapRS_RoutineIsNotSeer: return "eLeapRS_RoutineIsNotSeer";
+    case eLeapRS_TimestampTooEarly: return "eLeapRS_TimestampTooEarly";
+    case eLeapRS_ConcurrentPoll: return "eLeapRS_ConcurrentPoll";
+    case eLeapRS_NotAvailable: return "eLeapRS_NotAvailable";
+    case eLeapRS_NotStreaming: return "eLeapRS_NotStreaming";
+    case eLeapRS_CannotOpenDevice: return "eLeapRS_CannotOpenDevice";
+    default: return "UnknownResult";
+  }
+}
+
+static const char* errName(int32_t code) { return ulmResultString((eLeapRS)code); }
+
+// ---------------------- Source --------------------
+static eLeapRS leapPoll(void* self, uint32_t timeoutMs, LEAP_CONNECTION_MESSAGE* msg) {
+  return LeapPollConnection((LEAP_CONNECTION)self, timeoutMs, msg);
+}
+static eLeapRS leapPolicy(void* self, uint64_t set, uint64_t clear) {
+  return LeapSetPolicyFlags((LEAP_CONNECTION)self, set, clear);
+}
+static void leapClose(void* self) {
+  LeapCloseConnection((LEAP_CONNECTION)self);
+  LeapDestroyConnection((LEAP_CONNECTION)self);
+}
+
+int ulmLeapSource(UlmSource* out) {
+  LEAP_CONNECTION conn;
+  eLeapRS r = LeapCreateConnection(NULL, &conn);
+  if (r != eLeapRS_Success) { fprintf(stderr, "ERROR: LeapCreateConnection failed (%s)\n", ulmResultString(r)); return 0; }
+  r = LeapOpenConnection(conn);
+  if (r != eLeapRS_Success) {
+    fprintf(stderr, "ERROR: LeapOpenConnection failed (%s)\n", ulmResultString(r));
+    LeapDestroyConnection(conn);
+    return 0;
+  }
+  // Background frames so the service streams regardless of focus; eLeapPolicyFlag_Images
+  // is toggled on demand by syncImagePolicy().
+  r = LeapSetPolicyFlags(conn, eLeapPolicyFlag_BackgroundFrames, 0);
+  printf("[LeapC] Set policy flags result: %s\n", ulmResultString(r)); fflush(stdout);
+  *out = (UlmSource){ .self = conn, .poll = leapPoll, .setPolicy = leapPolicy, .close = leapClose };
+  return 1;
+}
+
+// ------------------ Built-in encoders -------------
+static int encJson(void* user, const UlmFrame* f, uint32_t mask, char* out) {
+  (void)user; return frameEncodeJson(f->src, mask, out);
+}
+static int encBin(void* user, const UlmFrame* f, uint32_t mask, char* out) {
+  (void)user; return frameEncodeBin(f->src, mask, out);
+}
+static int encDelta(void* user, const UlmFrame* f, uint32_t mask, char* out) {
+  return frameEncodeDelta(user, f->src, mask, out);
+}
+// the next delta subscriber starts on a keyframe
+static void deltaIdle(void* user) { frameDeltaReset(user); }
+static int encSkeleton(void* user, const UlmFrame* f, uint32_t mask, char* out) {
+  (void)mask;
+  metAdd(((UlmCtx*)user)->met, MET_SKELETON_RECORDS, 1);
+  return skelFrameRecord(f->ev, out);
+}
+
+// ---------------------- Stages --------------------
+// Feeds the primary hand to the template recognizer and emits a gesture record on a match.
+static void recognizeStage(void* user, UlmCtx* ctx, const UlmFrame* f) {
+  Recognizer* rec = user;
+  const LEAP_TRACKING_EVENT* frame = f->ev;
+  if (frame->nHands == 0) { recReset(rec); return; }
+
+  const LEAP_HAND* hand = &frame->pHands[0];
+  float tip[3];
+  iboxNorm(&f->box, hand->digits[1].distal.next_joint, tip);
+  RecSample s = { tip[0], tip[1], hand->pinch_strength, hand->grab_strength };
+  RecMatch m;
+  if (!recFeed(rec, &s, frame->info.timestamp, &m)) return;
+
+  printf("[Recognizer] %s conf=%.2f cost=%.3f\n", m.label, m.confidence, m.cost); fflush(stdout);
+  metAdd(ctx->met, MET_GESTURES, 1);
+
+  char json[256];
+  int len = snprintf(json, sizeof(json),
+    "{\"type\": \"gesture\", \"frameId\": %lld, \"label\": \"%s\", \"confidence\": %.3f, \"cost\": %.4f}\n",
+    (long long)frame->tracking_frame_id, m.label, m.confidence, m.cost);
+  if (len > 0 && len < (int)sizeof(json)) ulmEmit(ctx, SUB_HANDS, json, len);
+}
+
+// -------------------- Context ---------------------
+void ulmDefaults(UlmConfig* c) {
+  memset(c, 0, sizeof(*c));
+  c->gestureBudgetUs = 1000;
+  c->gestureThreshold = 0.15f;
+  c->fieldMask = FM_ALL;
+  c->name = "poll";
+  c->pollTimeoutMs = 1000;
+  c->idleHeartbeatMs = 1000;
+  c->newFrames = KIN_NEW_FRAMES;
+}
+
+UlmCtx* ulmCreate(const UlmConfig* c) {
+  UlmCtx* ctx = calloc(1, sizeof(*ctx));
+  if (!ctx) return NULL;
+  ctx->cfg = *c;
+  if (!ctx->cfg.name) ctx->cfg.name = "poll";
+  if (!ctx->cfg.pollTimeoutMs) ctx->cfg.pollTimeoutMs = 1000;
+  if (!ctx->cfg.idleHeartbeatMs) ctx->cfg.idleHeartbeatMs = 1000;
+  iboxInit(&ctx->ibox, 0);
+  if (c->ibox && !iboxConfigure(&ctx->ibox, c->ibox)) { free(ctx); return NULL; }
+  kinLifeReset(&ctx->life, ctx->cfg.newFrames);
+  frameDeltaReset(&ctx->delta);
+  ctx->met = c->met ? c->met : metShard(ctx->cfg.name);
+
+  const UlmEncoder builtin[4] = {
+    { "frames",   SUB_FRAMES,   FRAME_JSON_SZ,     1, encJson,     NULL,      NULL },
+    { "binary",   SUB_BINARY,   FRAME_BIN_JSON_SZ, 1, encBin,      NULL,      NULL },
+    { "delta",    SUB_DELTA,    FRAME_BIN_JSON_SZ, 1, encDelta,    deltaIdle, &ctx->delta },
+    { "skeleton", SUB_SKELETON, SKEL_JSON_SZ,      0, encSkeleton, NULL,      ctx },
+  };
+  for (int i = 0; i < 4; ++i) ulmAddEncoder(ctx, &builtin[i]);
+
+  if (c->gesturesDir) {
+    ctx->rec = recCreate(c->gestureBudgetUs, c->gestureThreshold);
+    int n = ctx->rec ? recLoadDir(ctx->rec, c->gesturesDir) : 0;
+    printf("[Recognizer] %d template(s) from %s (budget %u us/frame)\n", n, c->gesturesDir, c->gestureBudgetUs); fflush(stdout);
+    if (n == 0) { recDestroy(ctx->rec); ctx->rec = NULL; }
+    // after the frame is on the wire
+    else ulmAddStage(ctx, &(UlmStage){ "recognizer", ULM_STAGE_POST, recognizeStage, ctx->rec });
+  }
+  return ctx;
+}
+
+void ulmDestroy(UlmCtx* ctx) {
+  if (!ctx) return;
+  ulmStop(ctx);
+  recDestroy(ctx->rec);
+  free(ctx->out);
+  free(ctx);
+}
+
+int ulmAddStage(UlmCtx* ctx, const UlmStage* s) {
+  if (ctx->started || ctx->nStages >= ULM_MAX_STAGES) return 0;
+  ctx->stages[ctx->nStages++] = *s;
+  return 1;
+}
+
+int ulmAddEncoder(UlmCtx* ctx, const UlmEncoder* e) {
+  if (ctx->started) return 0;
+  for (int i = 0; i < ctx->nEnc; ++i)
+    if (ctx->enc[i].stream == e->stream) { ctx->enc[i] = *e; return 1; }
+  if (ctx->nEnc >= ULM_MAX_ENCODERS) return 0;
+  ctx->enc[ctx->nEnc++] = *e;
+  return 1;
+}
+
+int ulmAddSink(UlmCtx* ctx, const UlmSink* s) {
+  if (ctx->started || ctx->nSinks >= ULM_MAX_SINKS) return 0;
+  ctx->sinks[ctx->nSinks++] = *s;
+  return 1;
+}
+
+void ulmAttachImages(UlmCtx* ctx, ImageChannel* ch) { ctx->images = ch; }
+
+MetShard* ulmMetrics(UlmCtx* ctx) { return ctx->met; }
+
+int ulmRunning(const UlmCtx* ctx) { return atomic_load(&ctx->running); }
+
+// -------------------- Per frame -------------------
+static int allocOut(UlmCtx* ctx) {
+  size_t cap = 0;
+  for (int i = 0; i < ctx->nEnc; ++i) if (ctx->enc[i].cap > cap) cap = ctx->enc[i].cap;
+  if (ctx->out && ctx->outCap >= cap) return 1;
+  free(ctx->out);
+  ctx->out = malloc(cap);
+  ctx->outCap = ctx->out ? cap : 0;
+  if (ctx->out && ctx->cfg.rt) rtPrefault(ctx->cfg.rt, ctx->out, cap);
+  return ctx->out != NULL;
+}
+
+static uint32_t sinksWanted(UlmCtx* ctx) {
+  uint32_t w = 0;
+  for (int i = 0; i < ctx->nSinks; ++i) w |= ctx->sinks[i].wanted(ctx->sinks[i].user);
+  return w;
+}
+
+static void sinksWrite(UlmCtx* ctx, uint32_t stream, const char* rec, int len) {
+  for (int i = 0; i < ctx->nSinks; ++i) {
+    UlmSink* s = &ctx->sinks[i];
+    if (s->wanted(s->user) & stream) s->write(s->user, stream, rec, len);
+  }
+}
+
+void ulmEmit(UlmCtx* ctx, uint32_t stream, const char* rec, int len) { sinksWrite(ctx, stream, rec, len); }
+
+// Images policy follows demand: the service only captures/ships images while a sink
+// wants them, so an idle image channel costs the tracking path nothing.
+static void syncImagePolicy(UlmCtx* ctx) {
+  uint64_t nowUs = metNowUs();
+  if (!ctx->images || !ctx->src.setPolicy || nowUs - ctx->lastPolicyCheckUs < IMAGE_POLICY_CHECK_US) return;
+  ctx->lastPolicyCheckUs = nowUs;
+
+  int want = (sinksWanted(ctx) & SUB_IMAGES) && !(ctx->idle && ctx->cfg.idleImagesOff);
+  if (want == ctx->imagesOn) return;
+  eLeapRS r = want ? ctx->src.setPolicy(ctx->src.self, eLeapPolicyFlag_Images, 0)
+                   : ctx->src.setPolicy(ctx->src.self, 0, eLeapPolicyFlag_Images);
+  printf("[LeapC] Images policy %s: %s\n", want ? "on" : "off", ulmResultString(r)); fflush(stdout);
+  if (r == eLeapRS_Success) ctx->imagesOn = want;
+}
+
+static void runStages(UlmCtx* ctx, UlmPhase phase, const UlmFrame* f) {
+  for (int i = 0; i < ctx->nStages; ++i)
+    if (ctx->stages[i].phase == phase) ctx->stages[i].run(ctx->stages[i].user, ctx, f);
+}
+
+static void setIdle(UlmCtx* ctx, int idle) {
+  ctx->idle = idle;
+  metSet(ctx->met, MET_IDLE, idle);
+  // kinematics history and hand ages span the gap otherwise; images policy follows on
+  // the next loop
+  if (!idle) { kinHistoryReset(&ctx->kin); kinLifeReset(&ctx->life, ctx->cfg.newFrames); }
+  ctx->lastPolicyCheckUs = 0;
+  printf("[LeapC] %s\n", idle ? "Idle: no hand, heartbeat frames only" : "Hand: leaving idle"); fflush(stdout);
+}
+
+// Idle mode (UlmConfig.idleMs): 1 = skip this frame. Runs on device timestamps, so a
+// scripted or replayed source idles exactly like the device. Hand entry never waits: the
+// frame that shows the hand is the one that wakes the pipeline.
+static int idleSkip(UlmCtx* ctx, const LEAP_TRACKING_EVENT* frame) {
+  int64_t ts = frame->info.timestamp;
+  if (frame->nHands) {
+    ctx->lastHandTs = ts;
+    if (ctx->idle) setIdle(ctx, 0);
+    return 0;
+  }
+  // first frame, or the device clock restarted
+  if (!ctx->lastHandTs || ts < ctx->lastHandTs) ctx->lastHandTs = ts;
+  if (!ctx->idle) {
+    if (ts - ctx->lastHandTs < (int64_t)ctx->cfg.idleMs * 1000) return 0;
+    setIdle(ctx, 1);
+    ctx->lastBeatTs = ts;       // this frame is the first heartbeat
+    return 0;
+  }
+  if (ts >= ctx->lastBeatTs && ts - ctx->lastBeatTs < (int64_t)ctx->cfg.idleHeartbeatMs * 1000) return 1;
+  ctx->lastBeatTs = ts;
+  return 0;
+}
+
+static void trackingFrame(UlmCtx* ctx, const LEAP_TRACKING_EVENT* frame) {
+  MetShard* met = ctx->met;
+  metAdd(met, MET_FRAMES_IN, 1);
+  if (ctx->lastTrackTs && frame->info.timestamp > ctx->lastTrackTs)
+    metObserve(met, MET_H_FRAME_GAP_US, (uint64_t)(frame->info.timestamp - ctx->lastTrackTs));
+  metSet(met, MET_FRAMERATE_MILLI, (int64_t)(frame->framerate * 1000.0f));
+  metSet(met, MET_HANDS, frame->nHands);
+  metSet(met, MET_LAST_FRAME_US, (int64_t)metNowUs());
+  ctx->lastTrackTs = frame->info.timestamp;
+  // idle: no stages, no gather, no encode, no sink write until the heartbeat or a hand
+  if (ctx->cfg.idleMs && idleSkip(ctx, frame)) { metAdd(met, MET_FRAMES_IDLE, 1); return; }
+
+  UlmFrame f = { .ev = frame };
+  f.nKin = frameKinematics(&ctx->kin, &ctx->life, frame, &f.kin);
+  iboxFrame(&ctx->ibox, frame, f.kin.isNew, f.nKin, &f.box);
+  f.wanted = sinksWanted(ctx);
+  runStages(ctx, ULM_STAGE_PRE, &f);
+
+  // one gather, one encode per wanted stream; encode time runs from t0 (gather included
+  // for the first frame encoding), send time is the sinks' write
+  uint64_t t0 = metNowUs();
+  for (int i = 0; i < ctx->nEnc; ++i) {
+    UlmEncoder* e = &ctx->enc[i];
+    if (!(f.wanted & e->stream)) {
+      if (e->idle) e->idle(e->user);
+      continue;
+    }
+    if (e->gather && !f.src) {
+      frameGather(frame, &f.kin, f.nKin, &f.box, &ctx->frameSrc);
+      ctx->frameSrc.heartbeat = (uint32_t)ctx->idle;
+      f.src = &ctx->frameSrc;
+    }
+    int len = e->encode(e->user, &f, ctx->cfg.fieldMask, ctx->out);
+    uint64_t t1 = metNowUs();
+    if (len > 0) sinksWrite(ctx, e->stream, ctx->out, len);
+    if (e->gather) {
+      metObserve(met, MET_H_ENCODE_US, t1 - t0);
+      metObserve(met, MET_H_SEND_US, metNowUs() - t1);
+      metAdd(met, MET_FRAMES_ENCODED, 1);
+    }
+    t0 = metNowUs();
+  }
+
+  runStages(ctx, ULM_STAGE_POST, &f);
+}
+
+void ulmProcess(UlmCtx* ctx, const LEAP_CONNECTION_MESSAGE* msg) {
+  switch (msg->type) {
+    case eLeapEventType_Connection:
+      printf("[LeapC] Connected to service.\n"); fflush(stdout);
+      break;
+
+    case eLeapEventType_ConnectionLost:
+      fprintf(stderr, "[LeapC] Connection lost.\n");
+      atomic_store(&ctx->running, 0);
+      break;
+
+    case eLeapEventType_Device:
+      printf("[LeapC] Device connected.\n"); fflush(stdout);
+      break;
+
+    case eLeapEventType_DeviceLost:
+      fprintf(stderr, "[LeapC] Device disconnected.\n");
+      break;
+
+    case eLeapEventType_Tracking:
+      if (!ctx->out && !allocOut(ctx)) return;   // ulmProcess() without ulmStart()
+      trackingFrame(ctx, msg->tracking_event);
+      break;
+
+    case eLeapEventType_Image:
+      // rate limit + one memcpy into staging; downscale/publish happen on the image thread
+      if (ctx->images) imgOffer(ctx->images, msg->image_event);
+      break;
+
+    default: /* ignore others */ break;
+  }
+}
+
+// ------------------- Polling Thread ---------------
+static void* pollThread(void* arg) {
+  UlmCtx* ctx = arg;
+  if (ctx->cfg.rt) {
+    rtApplyThread(ctx->cfg.name, &ctx->cfg.rt->poll);
+    rtPrefaultStack(ctx->cfg.rt, RT_STACK_PREFAULT);
+  }
+  MetShard* met = ctx->met;
+
+  while (atomic_load(&ctx->running)) {
+    syncImagePolicy(ctx);
+    LEAP_CONNECTION_MESSAGE msg;
+    eLeapRS res = ctx->src.poll(ctx->src.self, ctx->cfg.pollTimeoutMs, &msg);
+    if (res == eLeapRS_Timeout) {
+      metAdd(met, MET_POLL_TIMEOUTS, 1);
+      // heartbeat if no tracking yet every ~2s
+      uint64_t nowUs = metNowUs();
+      if (ctx->lastTrackTs == 0 && nowUs - ctx->lastHeartbeatUs > HEARTBEAT_US) {
+        printf("[LeapC] Waiting for tracking frames...\n"); fflush(stdout);
+        ctx->lastHeartbeatUs = nowUs;
+      }
+      continue;
+    }
+    if (res != eLeapRS_Success) {
+      fprintf(stderr, "LeapPollConnection error: %s\n", ulmResultString(res));
+      metPollError(met, (int32_t)res);
+      continue;
+    }
+    ulmProcess(ctx, &msg);
+  }
+  return NULL;
+}
+
+int ulmStart(UlmCtx* ctx, const UlmSource* src) {
+  if (ctx->started || !allocOut(ctx)) { if (src->close) src->close(src->self); return 0; }
+  ctx->src = *src;
+  kinHistoryReset(&ctx->kin);
+  kinLifeReset(&ctx->life, ctx->cfg.newFrames);
+  frameDeltaReset(&ctx->delta);
+  ctx->lastTrackTs = 0;
+  ctx->imagesOn = 0;
+  ctx->lastPolicyCheckUs = 0;
+  ctx->idle = 0;
+  ctx->lastHandTs = ctx->lastBeatTs = 0;
+  metSet(ctx->met, MET_IDLE, 0);
+  atomic_store(&ctx->running, 1);
+  if (pthread_create(&ctx->thread, NULL, pollThread, ctx) != 0) {
+    fprintf(stderr, "ERROR: Could not create LeapC polling thread\n");
+    atomic_store(&ctx->running, 0);
+    if (src->close) src->close(src->self);
+    return 0;
+  }
+  ctx->started = 1;
+  return 1;
+}
+
+void ulmStop(UlmCtx* ctx) {
+  if (!ctx->started) return;
+  atomic_store(&ctx->running, 0);
+  pthread_join(ctx->thread, NULL);
+  if (ctx->src.close) ctx->src.close(ctx->src.self);
+  memset(&ctx->src, 0, sizeof(ctx->src));
+  ctx->started = 0;
+}
+
+// ---------------------- Control -------------------
+int ulmRenderStats(UlmCtx* ctx, int json, char* out, size_t cap) {
+  char extra[2048];
+  size_t len = 0;
+  extra[0] = 0;
+  for (int i = 0; i < ctx->nSinks && len < sizeof(extra); ++i) {
+    if (!ctx->sinks[i].stats) continue;
+    if (json && len) len += (size_t)snprintf(extra + len, sizeof(extra) - len, ", ");
+    if (len < sizeof(extra)) ctx->sinks[i].stats(ctx->sinks[i].user, json, extra + len, sizeof(extra) - len);
+    len += strlen(extra + len);
+  }
+  return json ? metRenderJson(out, cap, errName, len ? extra : NULL)
+              : metRenderProm(out, cap, errName, len ? extra : NULL);
+}
+
+int ulmControl(UlmCtx* ctx, const char* line, char* reply, size_t cap) {
+  if (!strcmp(line, "stats")) {
+    if (cap < 2) return 0;
+    int len = ulmRenderStats(ctx, 1, reply, cap - 1);
+    reply[len++] = '\n';
+    return len;
+  }
+  return iboxCommand(&ctx->ibox, line, reply, (int)cap);
+}
@@ -0,0 +1,144 @@
+// pipeline.h
+// The middleware's core as a library: one context object per tracking pipeline, with no
+// process globals, so several pipelines can run in one process (the TCP middleware, the
+// Node addon, a bench) and each part can be driven on its own.
+//
+//   source  -> stages (pre) -> gather -> encoders -> sinks -> stages (post)
+//
+// Source:   where LeapC messages come from (ulmLeapSource, or a scripted/replay source).
+// Stages:   per-frame hooks on the polling thread; PRE runs before anything is encoded
+//           (logging, filtering), POST after the sinks have the frame (the recognizer).
+// Encoders: one per stream bit (subscribers.h SUB_*); built-ins cover frames, binary,
+//           delta and skeleton. Only streams some sink wants are encoded, each once.
+// Sinks:    transports (server.h's TCP subscriber list, the addon's shared slots); each
+//           reports the streams it wants and receives whole records.
+//
+// All registration happens before ulmStart(). The polling thread is the only caller of
+// stages, encoders and sink writes; ulmControl() may be called from any thread.
+
+#ifndef ULM_PIPELINE_H
+#define ULM_PIPELINE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "LeapC.h"
+#include "frame_encode.h"
+#include "frame_source.h"
+#include "ibox.h"
+#include "images.h"
+#include "metrics.h"
+#include "rt.h"
+
+#define ULM_MAX_STAGES    8
+#define ULM_MAX_ENCODERS  8
+#define ULM_MAX_SINKS     4
+#define ULM_STREAM_USER   (1u << 16)   // first stream bit free for embedder encoders
+
+typedef struct UlmCtx UlmCtx;
+
+// One tracking event on its way through the pipeline
+typedef struct {
+  const LEAP_TRACKING_EVENT* ev;
+  FrameKin       kin;
+  uint32_t       nKin;
+  IBoxView       box;
+  const FrameSrc* src;     // gathered once, only when a wanted encoder reads it (else NULL)
+  uint32_t       wanted;   // union of the sinks' streams for this frame
+} UlmFrame;
+
+typedef struct {
+  void*   self;
+  eLeapRS (*poll)(void* self, uint32_t timeoutMs, LEAP_CONNECTION_MESSAGE* msg);
+  eLeapRS (*setPolicy)(void* self, uint64_t set, uint64_t clear);
+  void    (*close)(void* self);   // also frees self
+} UlmSource;
+
+typedef enum { ULM_STAGE_PRE, ULM_STAGE_POST } UlmPhase;
+
+typedef struct {
+  const char* name;
+  UlmPhase    phase;
+  void      (*run)(void* user, UlmCtx* ctx, const UlmFrame* f);
+  void*       user;
+} UlmStage;
+
+typedef struct {
+  const char* name;
+  uint32_t    stream;      // one SUB_* (or ULM_STREAM_USER+) bit
+  size_t      cap;         // largest record encode() writes
+  int         gather;      // reads f->src (otherwise only f->ev)
+  int       (*encode)(void* user, const UlmFrame* f, uint32_t mask, char* out);
+  void      (*idle)(void* user);   // optional: a frame passed with no sink wanting the stream
+  void*       user;
+} UlmEncoder;
+
+typedef struct {
+  const char* name;
+  uint32_t  (*wanted)(void* user);
+  void      (*write)(void* user, uint32_t stream, const char* rec, int len);
+  // optional: metrics fragment for "stats" (json) and /metrics (Prometheus)
+  void      (*stats)(void* user, int json, char* out, size_t cap);
+  void*       user;
+} UlmSink;
+
+typedef struct {
+  const char* gesturesDir;        // NULL = no recognizer
+  uint32_t    gestureBudgetUs;
+  float       gestureThreshold;
+  const char* ibox;               // NULL = default fixed box, "auto", or six mm values
+  uint32_t    fieldMask;          // hand fields in every frame encoding (FM_ALL)
+  const RtConfig* rt;             // polling thread pinning/policy (NULL = none)
+  const char* name;               // metrics shard / log label (default "poll")
+  MetShard*   met;                // record into this shard (NULL = register one; shards are never freed)
+  uint32_t    pollTimeoutMs;      // bounds how long ulmStop() waits (default 1000)
+  // Idle mode: after idleMs without a hand (device time), only one frame per
+  // idleHeartbeatMs is processed and sent; the first frame with a hand wakes it and goes
+  // out in full. idleImagesOff also drops the Images policy while idle.
+  uint32_t    idleMs;             // 0 = off (default)
+  uint32_t    idleHeartbeatMs;    // default 1000
+  int         idleImagesOff;
+  // hand.isNew marks this many frames after a hand enters; meanwhile it stays out of
+  // iBox auto-fit (default KIN_NEW_FRAMES)
+  uint32_t    newFrames;
+} UlmConfig;
+
+void     ulmDefaults(UlmConfig* c);
+
+// Registers the built-in encoders and, with gesturesDir, the recognizer stage.
+// Returns NULL on a bad ibox spec or out of memory.
+UlmCtx*  ulmCreate(const UlmConfig* c);
+void     ulmDestroy(UlmCtx* ctx);   // stops first if running
+
+// Opens a LeapC connection with background frames on. Returns 0 on failure.
+int      ulmLeapSource(UlmSource* out);
+
+int      ulmAddStage(UlmCtx* ctx, const UlmStage* s);
+// Replaces the built-in encoder for the same stream, if any.
+int      ulmAddEncoder(UlmCtx* ctx, const UlmEncoder* e);
+int      ulmAddSink(UlmCtx* ctx, const UlmSink* s);
+// Image events go to ch; the Images policy follows SUB_IMAGES demand from the sinks.
+void     ulmAttachImages(UlmCtx* ctx, ImageChannel* ch);
+
+// Takes ownership of src and starts the polling thread. Returns 0 on failure (src closed).
+int      ulmStart(UlmCtx* ctx, const UlmSource* src);
+// Joins the polling thread and closes the source; the context can be started again.
+void     ulmStop(UlmCtx* ctx);
+// 0 once stopped or the service connection was lost.
+int      ulmRunning(const UlmCtx* ctx);
+
+// Runs one message through the pipeline on the calling thread (no source, no thread):
+// for tests and per-stage benches.
+void     ulmProcess(UlmCtx* ctx, const LEAP_CONNECTION_MESSAGE* msg);
+
+// Record from a stage (gesture records): written to every sink that wants stream.
+void     ulmEmit(UlmCtx* ctx, uint32_t stream, const char* rec, int len);
+
+// "stats" and the ibox.h command set; returns the NDJSON reply length (0 = not ours).
+int      ulmControl(UlmCtx* ctx, const char* line, char* reply, size_t cap);
+// Metrics plus every sink's fragment, as for "stats" (json) or /metrics.
+int      ulmRenderStats(UlmCtx* ctx, int json, char* out, size_t cap);
+
+MetShard* ulmMetrics(UlmCtx* ctx);
+const char* ulmResultString(eLeapRS r);
+
+#endif
@@ -0,0 +1,304 @@
+// recognizer.c
+// Incremental subsequence DTW (SPRING-style): every template keeps one cost column that is
+// advanced by a single sample per step, so the per-frame cost is O(len * REC_DIM) per template
+// and the match may start anywhere in the live stream.
+
+#include "recognizer.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <dirent.h>
+
+#define REC_VEL_SCALE   50.0f    // per-step tip displacement (normalized) -> feature units
+#define REC_SETTLE      3        // steps a below-threshold minimum must hold before emitting
+#define REC_COOLDOWN_US 350000   // refractory period after any match
+#define REC_MIN_LEN     4
+#define REC_WARP_PENALTY 0.02f  // per-cell cost of a non-diagonal DTW step
+
+typedef struct {
+  char   label[REC_LABEL_SZ];
+  int    len;
+  float* feat;     // len * REC_DIM, 16-byte aligned
+  float* d;        // len + 1 DTW cost column; d[0] == 0 lets a match start at any step
+  int64_t* st;     // len + 1 stream step at which each cell's best path started
+  float  best;
+  int    bestAge;
+} Template;
+
+struct Recognizer {
+  Template t[REC_MAX_TEMPLATES];
+  int      n;
+  uint32_t budgetUs;
+  float    threshold;
+  int      cursor;           // round-robin start so budget overruns starve no template
+
+  // live stream resampling
+  int64_t  step;             // resampled steps fed so far
+  int64_t  lastStepUs;
+  float    prevNx, prevNy;
+  int64_t  cooldownUntilUs;
+
+  float*   cost;             // scratch: per-sample distances for the template being advanced
+  uint64_t skipped;
+};
+
+// --------------------- Util -----------------------
+static int64_t monoUs(void) {
+  struct timespec ts; clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static float* allocFloats(size_t n) {
+  void* p = NULL;
+  size_t bytes = ((n * sizeof(float)) + 15) & ~(size_t)15;
+  if (posix_memalign(&p, 16, bytes ? bytes : 16) != 0) return NULL;
+  return (float*)p;
+}
+
+static void featureRow(float* out, float dx, float dy, float pinch, float grab) {
+  out[0] = dx * REC_VEL_SCALE;
+  out[1] = dy * REC_VEL_SCALE;
+  out[2] = pinch;
+  out[3] = grab;
+}
+
+static void resetColumn(Template* t) {
+  t->d[0] = 0.0f;
+  for (int i = 1; i <= t->len; ++i) { t->d[i] = INFINITY; t->st[i] = 0; }
+  t->st[0] = 0;
+  t->best = INFINITY; t->bestAge = 0;
+}
+
+// --------------------- API ------------------------
+Recognizer* recCreate(uint32_t budgetUs, float threshold) {
+  Recognizer* r = calloc(1, sizeof(Recognizer));
+  if (!r) return NULL;
+  r->budgetUs = budgetUs;
+  r->threshold = threshold > 0 ? threshold : 0.15f;
+  r->cost = allocFloats(REC_MAX_LEN);
+  if (!r->cost) { free(r); return NULL; }
+  return r;
+}
+
+void recDestroy(Recognizer* r) {
+  if (!r) return;
+  for (int i = 0; i < r->n; ++i) { free(r->t[i].feat); free(r->t[i].d); free(r->t[i].st); }
+  free(r->cost);
+  free(r);
+}
+
+int recTemplateCount(const Recognizer* r) { return r ? r->n : 0; }
+uint64_t recSkipped(const Recognizer* r) { return r ? r->skipped : 0; }
+
+int recAddTemplate(Recognizer* r, const char* label, const RecSample* s, const int64_t* tUs, int n) {
+  if (!r || r->n >= REC_MAX_TEMPLATES || n < REC_MIN_LEN) return 0;
+
+  // Resample onto the REC_STEP_US grid (linear interpolation), then take first differences.
+  RecSample grid[REC_MAX_LEN + 1];
+  int g = 0, j = 0;
+  for (int64_t ts = tUs[0]; ts <= tUs[n - 1] && g <= REC_MAX_LEN; ts += REC_STEP_US) {
+    while (j < n - 2 && tUs[j + 1] < ts) ++j;
+    int64_t span = tUs[j + 1] - tUs[j];
+    float a = span > 0 ? (float)(ts - tUs[j]) / (float)span : 0.0f;
+    if (a < 0) a = 0;
+    if (a > 1) a = 1;
+    grid[g].nx    = s[j].nx    + (s[j + 1].nx    - s[j].nx)    * a;
+    grid[g].ny    = s[j].ny    + (s[j + 1].ny    - s[j].ny)    * a;
+    grid[g].pinch = s[j].pinch + (s[j + 1].pinch - s[j].pinch) * a;
+    grid[g].grab  = s[j].grab  + (s[j + 1].grab  - s[j].grab)  * a;
+    ++g;
+  }
+  int len = g - 1;
+  if (len < REC_MIN_LEN) return 0;
+
+  Template* t = &r->t[r->n];
+  memset(t, 0, sizeof(*t));
+  snprintf(t->label, sizeof(t->label), "%s", label ? label : "unlabeled");
+  t->len  = len;
+  t->feat = allocFloats((size_t)len * REC_DIM);
+  t->d    = allocFloats((size_t)len + 1);
+  t->st   = malloc(sizeof(int64_t) * ((size_t)len + 1));
+  if (!t->feat || !t->d || !t->st) { free(t->feat); free(t->d); free(t->st); return 0; }
+  for (int i = 0; i < len; ++i) {
+    featureRow(&t->feat[i * REC_DIM],
+               grid[i + 1].nx - grid[i].nx, grid[i + 1].ny - grid[i].ny,
+               grid[i + 1].pinch, grid[i + 1].grab);
+  }
+  resetColumn(t);
+  r->n++;
+  return 1;
+}
+
+void recReset(Recognizer* r) {
+  if (!r) return;
+  r->lastStepUs = 0;
+  for (int i = 0; i < r->n; ++i) resetColumn(&r->t[i]);
+}
+
+// Advances one template's cost column by the feature row x at stream step `step`.
+// Returns the normalized end cost; *span receives how many stream steps the path covers.
+static float advance(Template* t, const float* x, float* c, int64_t step, int64_t* span) {
+  const int M = t->len;
+  const float* f = t->feat;
+
+  // Distances to every template sample: contiguous, fixed-width rows -> vectorizes.
+  for (int i = 0; i < M; ++i) {
+    float acc = 0.0f;
+    for (int k = 0; k < REC_DIM; ++k) { float d = f[i * REC_DIM + k] - x[k]; acc += d * d; }
+    c[i] = acc;
+  }
+
+  // Column update, in place: d[i] = c[i-1] + min(d[i-1], d[i] + P, d'[i-1] + P); starts follow
+  // the argmin. The warp penalty P keeps uniform motion on the diagonal.
+  float* d = t->d;
+  int64_t* st = t->st;
+  float left = 0.0f, diag = 0.0f;
+  int64_t leftSt = step, diagSt = st[0];
+  st[0] = step;
+  for (int i = 1; i <= M; ++i) {
+    float up = d[i]; int64_t upSt = st[i];
+    float m = diag; int64_t ms = diagSt;
+    if (up + REC_WARP_PENALTY < m)   { m = up + REC_WARP_PENALTY;   ms = upSt; }
+    if (left + REC_WARP_PENALTY < m) { m = left + REC_WARP_PENALTY; ms = leftSt; }
+    float v = c[i - 1] + m;
+    diag = up; diagSt = upSt;
+    d[i] = v; st[i] = ms;
+    left = v; leftSt = ms;
+  }
+  *span = step - st[M] + 1;
+  return d[M] / (float)M;
+}
+
+int recFeed(Recognizer* r, const RecSample* s, int64_t nowUs, RecMatch* out) {
+  if (!r || !r->n || !s) return 0;
+
+  if (r->lastStepUs == 0) { r->lastStepUs = nowUs; r->prevNx = s->nx; r->prevNy = s->ny; return 0; }
+  int64_t dt = nowUs - r->lastStepUs;
+  if (dt < REC_STEP_US) return 0;
+  if (dt > 4 * REC_STEP_US) dt = REC_STEP_US; // tracking gap: don't fabricate a huge velocity
+
+  // Per-step velocity, independent of the device frame rate.
+  const float k = (float)REC_STEP_US / (float)dt;
+  float x[REC_DIM] __attribute__((aligned(16)));
+  featureRow(x, (s->nx - r->prevNx) * k, (s->ny - r->prevNy) * k, s->pinch, s->grab);
+  r->prevNx = s->nx; r->prevNy = s->ny; r->lastStepUs = nowUs;
+  r->step++;
+
+  const int64_t startUs = monoUs();
+  int bestIdx = -1; float bestCost = INFINITY;
+  int evaluated = 0;
+
+  for (; evaluated < r->n; ++evaluated) {
+    if (r->budgetUs && evaluated > 0 && (uint64_t)(monoUs() - startUs) > r->budgetUs) break;
+    int idx = (r->cursor + evaluated) % r->n;
+    Template* t = &r->t[idx];
+    int64_t span;
+    float cost = advance(t, x, r->cost, r->step, &span);
+
+    // A match must cover a plausible share of the template in stream time; otherwise the
+    // free start lets a still hand absorb the whole template in one sample.
+    if (span * 2 < t->len || span > t->len * 2) cost = INFINITY;
+
+    if (cost < r->threshold) {
+      // Only a clear improvement restarts the settle count; a steady repetitive motion
+      // would otherwise keep shaving off noise and never emit.
+      if (cost < t->best * 0.98f) t->bestAge = 0;
+      else t->bestAge++;
+      if (cost < t->best) t->best = cost;
+    }
+    // Emit once the minimum has settled or the cost climbs back over the threshold.
+    if (t->best < r->threshold && (cost >= r->threshold || t->bestAge >= REC_SETTLE)) {
+      if (t->best < bestCost) { bestCost = t->best; bestIdx = idx; }
+    }
+  }
+  if (evaluated < r->n) {
+    r->skipped += (uint64_t)(r->n - evaluated);
+    r->cursor = (r->cursor + evaluated) % r->n;
+  }
+
+  if (bestIdx < 0) return 0;
+  if (nowUs < r->cooldownUntilUs) { resetColumn(&r->t[bestIdx]); return 0; }
+
+  Template* t = &r->t[bestIdx];
+  if (out) {
+    snprintf(out->label, sizeof(out->label), "%s", t->label);
+    out->cost = bestCost;
+    out->confidence = 1.0f - bestCost / r->threshold;
+    if (out->confidence < 0) out->confidence = 0;
+    out->templateIdx = bestIdx;
+  }
+  // One gesture per refractory window: start every template over.
+  for (int i = 0; i < r->n; ++i) resetColumn(&r->t[i]);
+  r->cooldownUntilUs = nowUs + REC_COOLDOWN_US;
+  return 1;
+}
+
+// ------------------- Trainer loader ----------------
+// Trainer rows: {"t":ms,"label":"..","hand":{"pinch":..,"grab":..,...,"indexTip":{"nx":..,"ny":..},...}}
+static int jnum(const char* from, const char* key, double* out) {
+  char pat[48]; snprintf(pat, sizeof(pat), "\"%s\"", key);
+  const char* p = from ? strstr(from, pat) : NULL;
+  if (!p) return 0;
+  p += strlen(pat);
+  while (*p == ' ' || *p == ':') ++p;
+  char* end = NULL;
+  double v = strtod(p, &end);
+  if (end == p) return 0;
+  *out = v; return 1;
+}
+
+static int loadFile(Recognizer* r, const char* path, const char* label) {
+  FILE* fp = fopen(path, "r");
+  if (!fp) return 0;
+
+  RecSample* s  = malloc(sizeof(RecSample) * 4096);
+  int64_t*   ts = malloc(sizeof(int64_t) * 4096);
+  int n = 0, added = 0;
+  double prevT = -1;
+  char* line = NULL; size_t cap = 0;
+
+  while (s && ts && getline(&line, &cap, fp) > 0) {
+    double t, pinch = 0, grab = 0, nx, ny;
+    if (!jnum(line, "t", &t)) continue;
+    const char* tip = strstr(line, "\"indexTip\"");
+    if (!tip || !jnum(tip, "nx", &nx) || !jnum(tip, "ny", &ny)) continue;
+    jnum(line, "pinch", &pinch); jnum(line, "grab", &grab);
+
+    // Segments are appended to the same label file; t restarts at 0 for each one.
+    if (t < prevT || n == 4096) { added += recAddTemplate(r, label, s, ts, n); n = 0; }
+    prevT = t;
+    s[n] = (RecSample){ (float)nx, (float)ny, (float)pinch, (float)grab };
+    ts[n] = (int64_t)(t * 1000.0);
+    ++n;
+  }
+  added += recAddTemplate(r, label, s, ts, n);
+
+  free(line); free(s); free(ts);
+  fclose(fp);
+  return added;
+}
+
+int recLoadDir(Recognizer* r, const char* dir) {
+  if (!r || !dir) return 0;
+  DIR* d = opendir(dir);
+  if (!d) { fprintf(stderr, "[Recognizer] Cannot open %s\n", dir); return 0; }
+  int total = 0;
+  struct dirent* e;
+  while ((e = readdir(d)) != NULL) {
+    size_t L = strlen(e->d_name);
+    if (L <= 7 || strcmp(e->d_name + L - 7, ".ndjson") != 0) continue;
+    char label[REC_LABEL_SZ];
+    snprintf(label, sizeof(label), "%.*s", (int)(L - 7), e->d_name);
+    char path[1024];
+    snprintf(path, sizeof(path), "%s/%s", dir, e->d_name);
+    int k = loadFile(r, path, label);
+    printf("[Recognizer] %s: %d template(s)\n", label, k);
+    total += k;
+  }
+  closedir(d);
+  fflush(stdout);
+  return total;
+}
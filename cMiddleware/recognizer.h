@@ -0,0 +1,52 @@
+// recognizer.h
+// Template-matching gesture recognizer (incremental subsequence DTW).
+// Templates are the Trainer's labeled segments (gestures/<label>.ndjson); the live
+// hand trajectory is fed one sample per frame and matched against every template.
+
+#ifndef ULM_RECOGNIZER_H
+#define ULM_RECOGNIZER_H
+
+#include <stdint.h>
+
+// Feature layout: one contiguous, 16-byte aligned row of REC_DIM floats per sample
+// (tip vx, tip vy, pinch, grab) so the distance loop vectorizes cleanly.
+#define REC_DIM          4
+#define REC_MAX_TEMPLATES 256
+#define REC_MAX_LEN      256      // samples per template after resampling
+#define REC_STEP_US      16667    // resample grid (60 Hz) for templates and live stream
+#define REC_LABEL_SZ     64
+
+typedef struct {
+  float nx, ny;        // normalized index tip (InteractionBox space, y up)
+  float pinch, grab;   // 0..1
+} RecSample;
+
+typedef struct {
+  char   label[REC_LABEL_SZ];
+  float  confidence;   // 0..1 (1 = perfect match)
+  float  cost;         // normalized DTW cost
+  int    templateIdx;
+} RecMatch;
+
+typedef struct Recognizer Recognizer;
+
+// Creates an empty recognizer. budgetUs bounds the time spent per frame (0 = unbounded);
+// threshold is the normalized DTW cost at which a match is accepted.
+Recognizer* recCreate(uint32_t budgetUs, float threshold);
+void        recDestroy(Recognizer* r);
+
+// Loads every *.ndjson in dir (one file per label, segments appended). Returns templates loaded.
+int  recLoadDir(Recognizer* r, const char* dir);
+// Adds one template from raw samples taken at tUs timestamps (microseconds, monotonic).
+int  recAddTemplate(Recognizer* r, const char* label, const RecSample* s, const int64_t* tUs, int n);
+int  recTemplateCount(const Recognizer* r);
+
+// Feeds the newest sample (nowUs = device timestamp). Fills out and returns 1 when a
+// gesture completed on this frame, 0 otherwise. Call recReset() when the hand leaves.
+int  recFeed(Recognizer* r, const RecSample* s, int64_t nowUs, RecMatch* out);
+void recReset(Recognizer* r);
+
+// Templates skipped because the per-frame budget ran out (cumulative).
+uint64_t recSkipped(const Recognizer* r);
+
+#endif
@@ -0,0 +1,138 @@
+// rt.c
+// Thread pinning / real-time policy / memory locking (see rt.h).
+
+#define _GNU_SOURCE
+#include "rt.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+
+#ifdef __APPLE__
+#include <mach/mach.h>
+#include <mach/thread_policy.h>
+#endif
+#if defined(__linux__) && defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+void rtDefaults(RtConfig* c) {
+  memset(c, 0, sizeof(*c));
+  c->poll.cpu = c->server.cpu = c->images.cpu = RT_NO_CPU;
+}
+
+const char* rtSchedName(RtSched s) {
+  switch (s) {
+    case RT_SCHED_FIFO: return "SCHED_FIFO";
+    case RT_SCHED_RR:   return "SCHED_RR";
+    default:            return "SCHED_OTHER";
+  }
+}
+
+int rtParseSched(const char* s, RtSched* out) {
+  if (!strcmp(s, "fifo")) *out = RT_SCHED_FIFO;
+  else if (!strcmp(s, "rr")) *out = RT_SCHED_RR;
+  else if (!strcmp(s, "other")) *out = RT_SCHED_OTHER;
+  else return 0;
+  return 1;
+}
+
+int rtParseCpu(const char* s, int* out) {
+  char* end;
+  long v = strtol(s, &end, 10);
+  if (end == s || *end || v < 0 || v > 1023) return 0;
+  *out = (int)v;
+  return 1;
+}
+
+// ------------------- Per thread -------------------
+static int pinSelf(int cpu) {
+#if defined(__linux__)
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+  return pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#elif defined(__APPLE__)
+  // tag 0 means "no affinity"; threads with equal tags are kept on one L2
+  thread_affinity_policy_data_t p = { cpu + 1 };
+  kern_return_t kr = thread_policy_set(pthread_mach_thread_np(pthread_self()), THREAD_AFFINITY_POLICY,
+                                       (thread_policy_t)&p, THREAD_AFFINITY_POLICY_COUNT);
+  return kr == KERN_SUCCESS ? 0 : ENOTSUP;
+#else
+  (void)cpu;
+  return ENOTSUP;
+#endif
+}
+
+int rtApplyThread(const char* name, const RtThread* t) {
+  char msg[160];
+  int len = snprintf(msg, sizeof(msg), "[RT] %s:", name);
+  int ok = 1;
+
+  if (t->cpu != RT_NO_CPU) {
+    int e = pinSelf(t->cpu);
+    len += snprintf(msg + len, sizeof(msg) - len, " cpu %d %s", t->cpu, e ? strerror(e) : "ok");
+    ok &= !e;
+  }
+
+  if (t->sched != RT_SCHED_OTHER) {
+    int policy = t->sched == RT_SCHED_FIFO ? SCHED_FIFO : SCHED_RR;
+    int lo = sched_get_priority_min(policy), hi = sched_get_priority_max(policy);
+    struct sched_param sp = { .sched_priority = t->prio < lo ? lo : t->prio > hi ? hi : t->prio };
+    int e = pthread_setschedparam(pthread_self(), policy, &sp);
+    len += snprintf(msg + len, sizeof(msg) - len, " %s/%d %s",
+                    rtSchedName(t->sched), sp.sched_priority, e ? strerror(e) : "ok");
+    ok &= !e;
+  }
+
+  if (t->cpu == RT_NO_CPU && t->sched == RT_SCHED_OTHER) return 1;  // nothing asked, nothing to say
+  printf("%s\n", msg); fflush(stdout);
+  return ok;
+}
+
+// ------------------- Process ----------------------
+int rtApplyProcess(const RtConfig* c) {
+  int ok = 1;
+  if (c->prealloc) {
+#if defined(__linux__) && defined(__GLIBC__)
+    // keep freed heap mapped and serve large blocks from it, so no later malloc faults
+    mallopt(M_TRIM_THRESHOLD, -1);
+    mallopt(M_MMAP_MAX, 0);
+#endif
+  }
+  if (c->lockMemory) {
+    if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+      struct rlimit rl = { 0, 0 };
+      getrlimit(RLIMIT_MEMLOCK, &rl);
+      printf("[RT] mlockall: %s (RLIMIT_MEMLOCK %llu KB)\n", strerror(errno),
+             rl.rlim_cur == RLIM_INFINITY ? 0ull : (unsigned long long)rl.rlim_cur / 1024);
+      ok = 0;
+    } else {
+      printf("[RT] mlockall: ok\n");
+    }
+    fflush(stdout);
+  }
+  return ok;
+}
+
+void rtPrefault(const RtConfig* c, void* buf, size_t bytes) {
+  if (!c || !c->prealloc || !buf) return;
+  long page = sysconf(_SC_PAGESIZE);
+  if (page <= 0) page = 4096;
+  volatile unsigned char* p = buf;
+  for (size_t off = 0; off < bytes; off += (size_t)page) p[off] = p[off];
+  if (bytes) p[bytes - 1] = p[bytes - 1];
+}
+
+void rtPrefaultStack(const RtConfig* c, size_t bytes) {
+  if (!c || !c->prealloc) return;
+  volatile unsigned char stack[bytes];
+  for (size_t off = 0; off < bytes; off += 1024) stack[off] = 0;
+  (void)stack[0];
+}
@@ -0,0 +1,58 @@
+// rt.h
+// Latency options for busy workstations: pin the middleware's threads to CPUs, run them
+// under SCHED_FIFO/SCHED_RR, lock the address space (mlockall) and pre-fault hot buffers
+// at startup so the tracking path never takes a page fault.
+//
+// Threads: "poll" (LeapPollConnection + JSON/skeleton encode + broadcast, one thread),
+// "server" (accept + client command lines) and "images" (downscale + publish).
+// Each thread applies its own settings when it starts and logs what it got; nothing is
+// fatal, a refused request (EPERM without CAP_SYS_NICE / rtprio limits) is reported and
+// the thread keeps the default policy.
+//
+// Platform notes: affinity is a hard pin on Linux and an affinity-tag hint on macOS
+// (threads sharing a tag share an L2); mlockall is Linux-only in practice.
+
+#ifndef ULM_RT_H
+#define ULM_RT_H
+
+#include <stddef.h>
+
+#define RT_NO_CPU        (-1)
+#define RT_DEFAULT_PRIO  80
+
+typedef enum { RT_SCHED_OTHER = 0, RT_SCHED_FIFO, RT_SCHED_RR } RtSched;
+
+typedef struct {
+  int     cpu;        // RT_NO_CPU = leave to the scheduler
+  RtSched sched;
+  int     prio;       // 1..99 for FIFO/RR (clamped to the platform range)
+} RtThread;
+
+typedef struct {
+  RtThread poll, server, images;
+  int      lockMemory;   // mlockall(MCL_CURRENT | MCL_FUTURE)
+  int      prealloc;     // pre-fault stacks/buffers, disable heap trimming
+} RtConfig;
+
+// Everything off: default scheduling, no pinning, no locking.
+void rtDefaults(RtConfig* c);
+
+// --cpu-poll / --sched style parsers; return 0 on a malformed value.
+int  rtParseSched(const char* s, RtSched* out);
+int  rtParseCpu(const char* s, int* out);
+
+// Applies one thread's settings to the calling thread and prints a "[RT] <name>: ..." line.
+// Returns 1 when everything requested was granted.
+int  rtApplyThread(const char* name, const RtThread* t);
+
+// Process-wide: mlockall and heap tuning (before threads start). Prints its own report.
+int  rtApplyProcess(const RtConfig* c);
+
+// Touches every page of buf (and, for bytes of stack, the calling thread's stack) so
+// later writes don't fault. No-op unless prealloc is on.
+void rtPrefault(const RtConfig* c, void* buf, size_t bytes);
+void rtPrefaultStack(const RtConfig* c, size_t bytes);
+
+const char* rtSchedName(RtSched s);
+
+#endif
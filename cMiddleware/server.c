@@ -0,0 +1,194 @@
+// server.c
+// Accept/command thread of the TCP middleware. The pipeline's polling thread only ever
+// touches the subscriber list through the sink (subWanted/subBroadcast); this thread adds,
+// reads and reaps clients.
+
+#include "server.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <poll.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+
+#define STATS_BUF_SZ 16384
+
+struct Server {
+  UlmCtx*  ctx;
+  SubList  subs;
+  int      fd, metricsFd;
+  uint32_t defaultStreams;
+  char     stats[STATS_BUF_SZ];   // server thread only
+};
+
+// ----------------------- Sink ---------------------
+static uint32_t sinkWanted(void* user) { return subWanted(&((Server*)user)->subs); }
+
+static void sinkWrite(void* user, uint32_t stream, const char* rec, int len) {
+  subBroadcast(&((Server*)user)->subs, stream, rec, len);
+}
+
+// Socket totals + live clients as the metrics "extra" fragment.
+static void sinkStats(void* user, int json, char* out, size_t cap) {
+  Server* srv = user;
+  SubStats st;
+  subStats(&srv->subs, &st);
+  int len = 0;
+  out[0] = 0;
+  if (json) {
+    len += snprintf(out + len, cap - len,
+      "\"sockets\": {\"recordsOut\": %llu, \"recordsDropped\": %llu, \"bytesOut\": %llu}, \"clients\": [",
+      (unsigned long long)st.sent, (unsigned long long)st.dropped, (unsigned long long)st.bytes);
+    for (int i = 0; i < st.clients && (size_t)len < cap; ++i)
+      len += snprintf(out + len, cap - len, "%s{\"id\": %u, \"streams\": %u, \"sent\": %llu, \"dropped\": %llu, \"bytes\": %llu}",
+                      i ? ", " : "", st.c[i].id, st.c[i].streams, (unsigned long long)st.c[i].sent,
+                      (unsigned long long)st.c[i].dropped, (unsigned long long)st.c[i].bytes);
+    if ((size_t)len < cap) snprintf(out + len, cap - len, "]");
+    return;
+  }
+  static const struct { const char* name; const char* help; } fam[3] = {
+    { "ulm_records_out", "Records written to clients" },
+    { "ulm_records_dropped", "Records skipped because a client socket was full" },
+    { "ulm_bytes_out", "Bytes written to clients" },
+  };
+  for (int f = 0; f < 3 && (size_t)len < cap; ++f) {
+    uint64_t total = f == 0 ? st.sent : f == 1 ? st.dropped : st.bytes;
+    len += snprintf(out + len, cap - len, "# HELP %s_total %s\n# TYPE %s_total counter\n%s_total %llu\n",
+                    fam[f].name, fam[f].help, fam[f].name, fam[f].name, (unsigned long long)total);
+    for (int i = 0; i < st.clients && (size_t)len < cap; ++i) {
+      uint64_t v = f == 0 ? st.c[i].sent : f == 1 ? st.c[i].dropped : st.c[i].bytes;
+      len += snprintf(out + len, cap - len, "%s_total{client=\"%u\"} %llu\n", fam[f].name, st.c[i].id, (unsigned long long)v);
+    }
+  }
+}
+
+void srvSink(Server* s, UlmSink* out) {
+  *out = (UlmSink){ .name = "tcp", .wanted = sinkWanted, .write = sinkWrite, .stats = sinkStats, .user = s };
+}
+
+SubList* srvSubs(Server* s) { return &s->subs; }
+
+// ---------------------- Control -------------------
+// One request per connection on the --metrics-port listener; loopback scrapes are tiny,
+// so the server thread answers inline with a short receive timeout.
+static void serveHttp(Server* srv, int fd) {
+  struct timeval tv = { 0, 200000 };
+  setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+  char req[1024];
+  ssize_t n = recv(fd, req, sizeof(req) - 1, 0);
+  if (n <= 0) { close(fd); return; }
+  req[n] = 0;
+
+  char* body = srv->stats;
+  int json = !strncmp(req, "GET /stats", 10);
+  int len = 0;
+  const char* status = "200 OK";
+  if (json || !strncmp(req, "GET /metrics", 12)) len = ulmRenderStats(srv->ctx, json, body, STATS_BUF_SZ);
+  else { status = "404 Not Found"; len = snprintf(body, STATS_BUF_SZ, "try /metrics or /stats\n"); }
+
+  char head[160];
+  int hl = snprintf(head, sizeof(head), "HTTP/1.0 %s\r\nContent-Type: %s\r\nContent-Length: %d\r\nConnection: close\r\n\r\n",
+                    status, json ? "application/json" : "text/plain; version=0.0.4", len);
+  if (send(fd, head, (size_t)hl, 0) == hl) send(fd, body, (size_t)len, 0);
+  close(fd);
+}
+
+// Control lines that aren't subscribe/unsubscribe: "stats" and the ibox.h command set.
+static void controlLine(SubList* l, Subscriber* s, const char* line, void* user) {
+  Server* srv = user;
+  int len = ulmControl(srv->ctx, line, srv->stats, STATS_BUF_SZ);
+  if (!len) len = snprintf(srv->stats, STATS_BUF_SZ, "{\"type\": \"error\", \"error\": \"unknown command\"}\n");
+  subSend(l, s, srv->stats, len);
+}
+
+// ------------------- Server Loop ------------------
+void srvRun(Server* srv) {
+  SubList* subs = &srv->subs;
+  MetShard* met = metShard("server");
+  while (ulmRunning(srv->ctx)) {
+    struct pollfd fds[SUB_MAX_CLIENTS + 2];
+    int slotOf[SUB_MAX_CLIENTS + 2];
+    int nfds = 0;
+    fds[nfds++] = (struct pollfd){ .fd = srv->fd, .events = POLLIN };
+    fds[nfds++] = (struct pollfd){ .fd = srv->metricsFd, .events = POLLIN };   // fd -1 is ignored
+    int first = nfds;
+    pthread_mutex_lock(&subs->mu);
+    for (int i = 0; i < SUB_MAX_CLIENTS; ++i) {
+      if (subs->c[i].sock < 0) continue;
+      slotOf[nfds] = i;
+      fds[nfds++] = (struct pollfd){ .fd = subs->c[i].sock, .events = POLLIN };
+    }
+    pthread_mutex_unlock(&subs->mu);
+
+    int r = poll(fds, (nfds_t)nfds, 500);
+    if (r < 0 && errno != EINTR) { perror("poll() failed"); break; }
+
+    if (r > 0 && (fds[0].revents & POLLIN)) {
+      int sock = accept(srv->fd, NULL, NULL);
+      if (sock < 0) perror("accept() failed");
+      else if (subAdd(subs, sock, srv->defaultStreams) < 0) fprintf(stderr, "[LeapC] Client rejected: %d already connected.\n", SUB_MAX_CLIENTS);
+      else {
+        metAdd(met, MET_CLIENTS_ACCEPTED, 1);
+        printf("Client connected. Streaming hand tracking data…\n"); fflush(stdout);
+      }
+    }
+    if (r > 0 && (fds[1].revents & POLLIN)) {
+      int sock = accept(srv->metricsFd, NULL, NULL);
+      if (sock >= 0) serveHttp(srv, sock);
+    }
+    for (int k = first; r > 0 && k < nfds; ++k)
+      if (fds[k].revents & (POLLIN | POLLHUP | POLLERR)) subRead(subs, slotOf[k], controlLine, srv);
+
+    int gone = subReap(subs);
+    if (gone) { printf("[LeapC] %d client(s) disconnected.\n", gone); fflush(stdout); }
+    int live = 0;
+    for (int i = 0; i < SUB_MAX_CLIENTS; ++i) live += subs->c[i].sock >= 0;   // only this thread adds/closes
+    metSet(met, MET_CLIENTS, live);
+  }
+}
+
+// Loopback TCP listener; returns the fd or -1 (error already printed).
+static int listenLocal(int port, int backlog) {
+  int fd = socket(AF_INET, SOCK_STREAM, 0);
+  if (fd < 0) { perror("socket() failed"); return -1; }
+  int optval = 1; setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &optval, sizeof(optval));
+
+  struct sockaddr_in addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  addr.sin_port = htons((uint16_t)port);
+
+  if (bind(fd, (struct sockaddr*)&addr, sizeof(addr)) < 0) { perror("bind() failed"); close(fd); return -1; }
+  if (listen(fd, backlog) < 0) { perror("listen() failed"); close(fd); return -1; }
+  return fd;
+}
+
+Server* srvCreate(UlmCtx* ctx, int port, int metricsPort, uint32_t defaultStreams) {
+  Server* srv = calloc(1, sizeof(*srv));
+  if (!srv) return NULL;
+  srv->ctx = ctx;
+  srv->defaultStreams = defaultStreams;
+  srv->metricsFd = -1;
+  subInit(&srv->subs);
+  srv->fd = listenLocal(port, SUB_MAX_CLIENTS);
+  if (srv->fd < 0) { free(srv); return NULL; }
+  if (metricsPort > 0) {
+    srv->metricsFd = listenLocal(metricsPort, 4);
+    if (srv->metricsFd >= 0) { printf("[Metrics] http://127.0.0.1:%d/metrics\n", metricsPort); fflush(stdout); }
+  }
+  return srv;
+}
+
+void srvDestroy(Server* srv) {
+  if (!srv) return;
+  subCloseAll(&srv->subs);
+  close(srv->fd);
+  if (srv->metricsFd >= 0) close(srv->metricsFd);
+  free(srv);
+}
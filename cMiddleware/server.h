@@ -0,0 +1,28 @@
+// server.h
+// TCP transport for a pipeline (pipeline.h): the loopback subscriber socket
+// (subscribers.c) as a sink, its control lines, and the optional --metrics-port HTTP
+// listener (GET /metrics: Prometheus text, GET /stats: JSON).
+
+#ifndef ULM_SERVER_H
+#define ULM_SERVER_H
+
+#include <stdint.h>
+#include "pipeline.h"
+#include "subscribers.h"
+
+typedef struct Server Server;
+
+// Listens on localhost:port (and metricsPort when > 0). New clients start subscribed to
+// defaultStreams. Returns NULL when the subscriber port can't be bound.
+Server*  srvCreate(UlmCtx* ctx, int port, int metricsPort, uint32_t defaultStreams);
+void     srvDestroy(Server* s);   // closes every client and listener
+
+// The subscriber list as a pipeline sink.
+void     srvSink(Server* s, UlmSink* out);
+// For transports that notify subscribers themselves (the image channel).
+SubList* srvSubs(Server* s);
+
+// Accepts clients and reads their command lines until the pipeline stops.
+void     srvRun(Server* s);
+
+#endif
@@ -0,0 +1,65 @@
+// skeleton.c
+// Fixed-stride skeleton packing + base64 framing (see skeleton.h for the layout).
+
+#include "skeleton.h"
+
+#include <stdio.h>
+#include <string.h>
+
+static void packBone(const LEAP_BONE* b, float* o) {
+  o[SKEL_BONE_PREV] = b->prev_joint.x; o[SKEL_BONE_PREV + 1] = b->prev_joint.y; o[SKEL_BONE_PREV + 2] = b->prev_joint.z;
+  o[SKEL_BONE_NEXT] = b->next_joint.x; o[SKEL_BONE_NEXT + 1] = b->next_joint.y; o[SKEL_BONE_NEXT + 2] = b->next_joint.z;
+  o[SKEL_BONE_WIDTH] = b->width;
+  o[SKEL_BONE_ROT] = b->rotation.x; o[SKEL_BONE_ROT + 1] = b->rotation.y;
+  o[SKEL_BONE_ROT + 2] = b->rotation.z; o[SKEL_BONE_ROT + 3] = b->rotation.w;
+}
+
+void skelPackHand(const LEAP_HAND* hand, float* out) {
+  uint32_t ext = 0;
+  for (int f = 0; f < 5; ++f) ext |= (hand->digits[f].is_extended ? 1u : 0u) << f;
+  out[SKEL_TYPE] = hand->type == eLeapHandType_Left ? 0.0f : 1.0f;
+  out[SKEL_CONFIDENCE] = hand->confidence;
+  out[SKEL_PALM_WIDTH] = hand->palm.width;
+  out[SKEL_EXTENDED] = (float)ext;
+  packBone(&hand->arm, out + SKEL_ARM);
+  for (int f = 0; f < 5; ++f)
+    for (int b = 0; b < 4; ++b)
+      packBone(&hand->digits[f].bones[b], out + SKEL_DIGITS + (f * 4 + b) * SKEL_BONE_SIZE);
+}
+
+// --------------------- Base64 ---------------------
+static const char b64[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+int base64Encode(const uint8_t* src, int n, char* dst) {
+  int o = 0, i = 0;
+  for (; i + 2 < n; i += 3) {
+    uint32_t v = (uint32_t)src[i] << 16 | (uint32_t)src[i + 1] << 8 | src[i + 2];
+    dst[o++] = b64[v >> 18]; dst[o++] = b64[(v >> 12) & 63];
+    dst[o++] = b64[(v >> 6) & 63]; dst[o++] = b64[v & 63];
+  }
+  if (i < n) {
+    uint32_t v = (uint32_t)src[i] << 16 | (i + 1 < n ? (uint32_t)src[i + 1] << 8 : 0);
+    dst[o++] = b64[v >> 18]; dst[o++] = b64[(v >> 12) & 63];
+    dst[o++] = i + 1 < n ? b64[(v >> 6) & 63] : '=';
+    dst[o++] = '=';
+  }
+  return o;
+}
+
+// ---------------------- Record --------------------
+int skelFrameRecord(const LEAP_TRACKING_EVENT* frame, char* buf) {
+  // float32 on every target we build for is IEEE-754 little endian: the bytes go out as-is
+  float packed[SKEL_MAX_HANDS * SKEL_STRIDE];
+  uint32_t n = frame->nHands < SKEL_MAX_HANDS ? frame->nHands : SKEL_MAX_HANDS;
+  for (uint32_t h = 0; h < n; ++h) skelPackHand(&frame->pHands[h], packed + h * SKEL_STRIDE);
+
+  int len = snprintf(buf, SKEL_JSON_SZ,
+    "{\"type\": \"skeleton\", \"frameId\": %lld, \"ts\": %lld, \"stride\": %d, \"ids\": [",
+    (long long)frame->tracking_frame_id, (long long)frame->info.timestamp, SKEL_STRIDE);
+  for (uint32_t h = 0; h < n; ++h)
+    len += snprintf(buf + len, SKEL_JSON_SZ - len, "%s%u", h ? ", " : "", frame->pHands[h].id);
+  len += snprintf(buf + len, SKEL_JSON_SZ - len, "], \"data\": \"");
+  len += base64Encode((const uint8_t*)packed, (int)(n * SKEL_STRIDE * sizeof(float)), buf + len);
+  memcpy(buf + len, "\"}\n", 3);
+  return len + 3;
+}
@@ -0,0 +1,44 @@
+// skeleton.h
+// Opt-in full skeleton stream: every bone of every digit plus the arm, packed per hand
+// into a fixed-stride float32 record so consumers index joints without parsing names.
+// Records travel base64-encoded inside one NDJSON line:
+//   {"type": "skeleton", "frameId": N, "ts": us, "stride": SKEL_STRIDE, "ids": [..], "data": "<b64 float32 LE>"}
+// The JS mirror of this layout is src/bridges/skeleton.js; keep both in sync.
+
+#ifndef ULM_SKELETON_H
+#define ULM_SKELETON_H
+
+#include <stdint.h>
+#include "LeapC.h"
+
+// Per bone: prev_joint xyz, next_joint xyz, width, rotation xyzw
+#define SKEL_BONE_PREV   0
+#define SKEL_BONE_NEXT   3
+#define SKEL_BONE_WIDTH  6
+#define SKEL_BONE_ROT    7
+#define SKEL_BONE_SIZE   11
+
+// Per hand: header, arm bone, 5 digits x 4 bones (metacarpal..distal)
+#define SKEL_TYPE        0     // 0 = left, 1 = right
+#define SKEL_CONFIDENCE  1
+#define SKEL_PALM_WIDTH  2
+#define SKEL_EXTENDED    3     // bit i set = digit i extended
+#define SKEL_ARM         4
+#define SKEL_DIGITS      (SKEL_ARM + SKEL_BONE_SIZE)
+#define SKEL_STRIDE      (SKEL_DIGITS + 5 * 4 * SKEL_BONE_SIZE)   // 235 floats
+
+#define SKEL_MAX_HANDS   4
+#define SKEL_JSON_SZ     (128 + SKEL_MAX_HANDS * 16 + ((SKEL_MAX_HANDS * SKEL_STRIDE * 4 + 2) / 3) * 4)
+
+// Packs one hand into out[SKEL_STRIDE].
+void skelPackHand(const LEAP_HAND* hand, float* out);
+
+// Writes the full NDJSON skeleton record (with trailing '\n') for a tracking frame into
+// buf[SKEL_JSON_SZ]. Returns its length. Hands past SKEL_MAX_HANDS are left out.
+int skelFrameRecord(const LEAP_TRACKING_EVENT* frame, char* buf);
+
+// Standard base64 (with padding) of n bytes into dst (4 * ceil(n / 3) chars, no NUL).
+// Shared with the binary frame encoders (frame_encode.c).
+int base64Encode(const uint8_t* src, int n, char* dst);
+
+#endif
@@ -0,0 +1,215 @@
+// subscribers.c
+// Client list shared by the polling thread (subBroadcast) and the server thread
+// (subAdd/subRead/subReap). Sockets are only ever closed by the server thread, so a
+// descriptor can't be recycled under a poll() that still watches it.
+
+#include "subscribers.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <unistd.h>
+#include <errno.h>
+#include <sys/socket.h>
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0   // macOS: SO_NOSIGPIPE is set per socket in subAdd()
+#endif
+
+static const struct { const char* name; uint32_t bit; } streamNames[] = {
+  { "frames", SUB_FRAMES },
+  { "skeleton", SUB_SKELETON },
+  { "images", SUB_IMAGES },
+  { "binary", SUB_BINARY },
+  { "delta", SUB_DELTA },
+};
+
+void subInit(SubList* l) {
+  memset(l, 0, sizeof(*l));
+  for (int i = 0; i < SUB_MAX_CLIENTS; ++i) l->c[i].sock = -1;
+  pthread_mutex_init(&l->mu, NULL);
+}
+
+int subAdd(SubList* l, int sock, uint32_t streams) {
+#ifdef SO_NOSIGPIPE
+  int one = 1; setsockopt(sock, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+#endif
+  int sndbuf = 1 << 20; // ~100 frames of skeleton data before a slow reader drops
+  setsockopt(sock, SOL_SOCKET, SO_SNDBUF, &sndbuf, sizeof(sndbuf));
+
+  pthread_mutex_lock(&l->mu);
+  int slot = -1;
+  for (int i = 0; i < SUB_MAX_CLIENTS; ++i) {
+    if (l->c[i].sock >= 0) continue;
+    l->c[i] = (Subscriber){ .sock = sock, .streams = streams, .id = ++l->nextId };
+    slot = i;
+    break;
+  }
+  pthread_mutex_unlock(&l->mu);
+  if (slot < 0) close(sock);
+  return slot;
+}
+
+uint32_t subWanted(SubList* l) {
+  uint32_t m = 0;
+  pthread_mutex_lock(&l->mu);
+  for (int i = 0; i < SUB_MAX_CLIENTS; ++i)
+    if (l->c[i].sock >= 0 && !l->c[i].dead) m |= l->c[i].streams;
+  pthread_mutex_unlock(&l->mu);
+  return m;
+}
+
+// A full socket (or an interrupted send) is not an error; anything else is.
+static int sendFailed(ssize_t n) {
+  return n < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR && errno != ENOBUFS;
+}
+
+static void killLocked(Subscriber* s) {
+  s->dead = 1;
+  shutdown(s->sock, SHUT_RDWR); // wakes the server thread's poll(); it closes the fd
+}
+
+// Caller holds mu. Only whole records are dropped: the unsent end of a short write is
+// kept in s->tail and flushed before the next record; while it can't be, records for
+// this client are skipped. Only a real socket error (EPIPE, ECONNRESET, ...) kills it.
+static void sendLocked(SubList* l, Subscriber* s, const char* buf, int len) {
+  if (s->tailLen) {
+    ssize_t n = send(s->sock, s->tail, (size_t)s->tailLen, MSG_DONTWAIT | MSG_NOSIGNAL);
+    if (sendFailed(n)) { killLocked(s); return; }
+    if (n > 0) { memmove(s->tail, s->tail + n, (size_t)(s->tailLen - n)); s->tailLen -= (int)n; }
+    if (s->tailLen) { s->dropped++; l->dropped++; return; }
+  }
+  ssize_t n = send(s->sock, buf, (size_t)len, MSG_DONTWAIT | MSG_NOSIGNAL);
+  if (sendFailed(n)) { killLocked(s); return; }
+  if (n <= 0) { s->dropped++; l->dropped++; return; }
+  if (n < len) {
+    int rest = len - (int)n;
+    if (rest > s->tailCap) {
+      char* t = realloc(s->tail, (size_t)rest);
+      if (!t) { killLocked(s); return; }   // can't finish the line: the stream would be corrupt
+      s->tail = t; s->tailCap = rest;
+    }
+    memcpy(s->tail, buf + n, (size_t)rest);
+    s->tailLen = rest;
+  }
+  s->sent++; s->bytes += (uint64_t)len; l->sent++; l->bytes += (uint64_t)len;
+}
+
+static void freeTail(Subscriber* s) {
+  free(s->tail);
+  s->tail = NULL;
+  s->tailLen = s->tailCap = 0;
+}
+
+void subBroadcast(SubList* l, uint32_t stream, const char* buf, int len) {
+  pthread_mutex_lock(&l->mu);
+  for (int i = 0; i < SUB_MAX_CLIENTS; ++i) {
+    Subscriber* s = &l->c[i];
+    if (s->sock >= 0 && !s->dead && (s->streams & stream)) sendLocked(l, s, buf, len);
+  }
+  pthread_mutex_unlock(&l->mu);
+}
+
+void subSend(SubList* l, Subscriber* s, const char* buf, int len) {
+  pthread_mutex_lock(&l->mu);
+  if (s->sock >= 0 && !s->dead) sendLocked(l, s, buf, len);
+  pthread_mutex_unlock(&l->mu);
+}
+
+uint32_t subParseStreams(const char* names) {
+  uint32_t m = 0;
+  char tmp[SUB_LINE_SZ];
+  snprintf(tmp, sizeof(tmp), "%s", names);
+  for (char *save = NULL, *tok = strtok_r(tmp, ", \t", &save); tok; tok = strtok_r(NULL, ", \t", &save))
+    for (size_t k = 0; k < sizeof(streamNames) / sizeof(streamNames[0]); ++k)
+      if (!strcasecmp(tok, streamNames[k].name)) m |= streamNames[k].bit;
+  return m;
+}
+
+static void ackStreams(SubList* l, Subscriber* s) {
+  char json[160];
+  int len = snprintf(json, sizeof(json), "{\"type\": \"ack\", \"streams\": [");
+  int first = 1;
+  for (size_t k = 0; k < sizeof(streamNames) / sizeof(streamNames[0]); ++k) {
+    if (!(s->streams & streamNames[k].bit)) continue;
+    len += snprintf(json + len, sizeof(json) - len, "%s\"%s\"", first ? "" : ", ", streamNames[k].name);
+    first = 0;
+  }
+  len += snprintf(json + len, sizeof(json) - len, "]}\n");
+  subSend(l, s, json, len);
+}
+
+static void handleLine(SubList* l, Subscriber* s, char* line, SubLineFn onLine, void* user) {
+  size_t n = strlen(line);
+  while (n && (line[n - 1] == '\r' || line[n - 1] == ' ')) line[--n] = 0;
+  if (!n) return;
+  if (!strncmp(line, "subscribe ", 10)) {
+    pthread_mutex_lock(&l->mu); s->streams |= subParseStreams(line + 10); pthread_mutex_unlock(&l->mu);
+    ackStreams(l, s);
+  } else if (!strncmp(line, "unsubscribe ", 12)) {
+    pthread_mutex_lock(&l->mu); s->streams &= ~subParseStreams(line + 12); pthread_mutex_unlock(&l->mu);
+    ackStreams(l, s);
+  } else if (onLine) {
+    onLine(l, s, line, user);
+  }
+}
+
+int subRead(SubList* l, int i, SubLineFn onLine, void* user) {
+  Subscriber* s = &l->c[i];
+  char buf[512];
+  ssize_t n = recv(s->sock, buf, sizeof(buf), MSG_DONTWAIT);
+  if (n == 0 || (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+    pthread_mutex_lock(&l->mu); s->dead = 1; pthread_mutex_unlock(&l->mu);
+    return -1;
+  }
+  for (ssize_t k = 0; k < n; ++k) {
+    if (buf[k] == '\n') {
+      s->line[s->lineLen] = 0;
+      handleLine(l, s, s->line, onLine, user);
+      s->lineLen = 0;
+    } else if (s->lineLen < SUB_LINE_SZ - 1) {
+      s->line[s->lineLen++] = buf[k];   // overlong commands are truncated
+    }
+  }
+  return 0;
+}
+
+int subReap(SubList* l) {
+  int removed = 0;
+  pthread_mutex_lock(&l->mu);
+  for (int i = 0; i < SUB_MAX_CLIENTS; ++i) {
+    Subscriber* s = &l->c[i];
+    if (s->sock < 0 || !s->dead) continue;
+    close(s->sock);
+    s->sock = -1;
+    freeTail(s);
+    removed++;
+  }
+  pthread_mutex_unlock(&l->mu);
+  return removed;
+}
+
+void subStats(SubList* l, SubStats* out) {
+  memset(out, 0, sizeof(*out));
+  pthread_mutex_lock(&l->mu);
+  out->sent = l->sent; out->dropped = l->dropped; out->bytes = l->bytes;
+  for (int i = 0; i < SUB_MAX_CLIENTS; ++i) {
+    const Subscriber* s = &l->c[i];
+    if (s->sock < 0 || s->dead) continue;
+    int k = out->clients++;
+    out->c[k].id = s->id; out->c[k].streams = s->streams;
+    out->c[k].sent = s->sent; out->c[k].dropped = s->dropped; out->c[k].bytes = s->bytes;
+  }
+  pthread_mutex_unlock(&l->mu);
+}
+
+void subCloseAll(SubList* l) {
+  pthread_mutex_lock(&l->mu);
+  for (int i = 0; i < SUB_MAX_CLIENTS; ++i) {
+    if (l->c[i].sock >= 0) close(l->c[i].sock);
+    l->c[i].sock = -1;
+    freeTail(&l->c[i]);
+  }
+  pthread_mutex_unlock(&l->mu);
+}
@@ -0,0 +1,76 @@
+// subscribers.h
+// Fan-out of the middleware's record streams to several TCP clients.
+// Each client picks its streams with line commands on the same socket:
+//   subscribe skeleton | unsubscribe frames | subscribe frames,skeleton
+// The polling thread broadcasts; the accept/command thread adds, reads and reaps clients.
+
+#ifndef ULM_SUBSCRIBERS_H
+#define ULM_SUBSCRIBERS_H
+
+#include <stdint.h>
+#include <pthread.h>
+
+#define SUB_MAX_CLIENTS 8
+#define SUB_LINE_SZ     256
+
+// Stream bits
+#define SUB_FRAMES   (1u << 0)   // hand frames + recognizer gesture records
+#define SUB_SKELETON (1u << 1)   // full bone chain records (skeleton.h)
+#define SUB_IMAGES   (1u << 2)   // image notifications; pixels live in the shm pool (images.h)
+#define SUB_BINARY   (1u << 3)   // hand frames as packed binary records (frame_encode.h)
+#define SUB_DELTA    (1u << 4)   // hand frames as deltas against the previous record
+#define SUB_HANDS    (SUB_FRAMES | SUB_BINARY | SUB_DELTA)   // any frame encoding; gesture records go here
+
+typedef struct {
+  int      sock;                 // -1 = free slot
+  int      dead;                 // write failed; reaped by subReap()
+  uint32_t streams;
+  char     line[SUB_LINE_SZ];    // partial command line
+  int      lineLen;
+  uint32_t id;                   // connection number, stable label for metrics
+  uint64_t sent, dropped;        // records written / skipped because the socket was full
+  uint64_t bytes;
+  char*    tail;                 // unsent end of a record a short send() cut (malloc'd)
+  int      tailLen, tailCap;
+} Subscriber;
+
+typedef struct {
+  Subscriber      c[SUB_MAX_CLIENTS];
+  pthread_mutex_t mu;
+  uint32_t        nextId;
+  uint64_t        sent, dropped, bytes;   // all clients, including disconnected ones
+} SubList;
+
+typedef struct {
+  uint64_t sent, dropped, bytes;
+  int      clients;
+  struct { uint32_t id, streams; uint64_t sent, dropped, bytes; } c[SUB_MAX_CLIENTS];
+} SubStats;
+
+typedef void (*SubLineFn)(SubList* l, Subscriber* s, const char* line, void* user);
+
+void     subInit(SubList* l);
+// Takes ownership of sock. Returns the slot, or -1 (socket closed) when full.
+int      subAdd(SubList* l, int sock, uint32_t streams);
+// Union of every live client's streams: skip building records nobody wants.
+uint32_t subWanted(SubList* l);
+// Writes one whole record to every client subscribed to stream. Never blocks: a client
+// whose socket buffer is full misses this record (counted in dropped). When the socket
+// takes only part of a record, the rest is kept and goes out ahead of the client's next
+// record, so clients only ever see whole lines.
+void     subBroadcast(SubList* l, uint32_t stream, const char* buf, int len);
+// Reply to a single client (command acks).
+void     subSend(SubList* l, Subscriber* s, const char* buf, int len);
+// Reads pending input on slot i and calls onLine per complete line; subscribe/unsubscribe
+// are handled here. Returns -1 once the client is gone.
+int      subRead(SubList* l, int i, SubLineFn onLine, void* user);
+// Closes clients marked dead. Returns how many were removed.
+int      subReap(SubList* l);
+void     subCloseAll(SubList* l);
+// Consistent copy of the socket counters (totals + live clients) for metrics.
+void     subStats(SubList* l, SubStats* out);
+
+// "frames,skeleton" -> bits (unknown names ignored)
+uint32_t subParseStreams(const char* names);
+
+#endif
@@ -0,0 +1,189 @@
+// tools/gen_frame_schema.c
+// Prints src/bridges/frameSchema.js from frame_schema.h: the field-mask bits and the
+// decoders for the "binary" and "delta" frame streams, unrolled per field so the JS does
+// no table lookups per frame. Decoded records have the JSON stream's shape, so they go
+// straight into frameView.js's pool.
+//
+//   cmake --build <dir> --target frame_schema_js      (or: gen_frame_schema > frameSchema.js)
+
+#include <stdio.h>
+#include <string.h>
+
+#include "../frame_schema.h"
+
+typedef struct { const char *name, *key, *kind; int n, prec, cond; } Field;
+
+#define ROW(NAME, KEY, KIND, N, PREC, SRC, COND) { #NAME, KEY, #KIND, N, PREC, strcmp(#COND, "1") != 0 },
+static const Field header[] = { FRAME_HEADER_FIELDS(ROW) };
+static const Field hand[] = { FRAME_HAND_FIELDS(ROW) };
+#undef ROW
+
+#define COUNT(a) (int)(sizeof(a) / sizeof((a)[0]))
+
+static int is(const Field* f, const char* kind) { return !strcmp(f->kind, kind); }
+
+// Bytes a field occupies in a binary record
+static int width(const Field* f) {
+  if (is(f, "I64")) return 8;
+  if (is(f, "HANDTYPE") || is(f, "BOOL") || is(f, "NAMEDB")) return 1;
+  return 4 * f->n;
+}
+
+// JS expression for the field's value at byte offset `o` of DataView `dv`.
+// quant: delta record (floats are int32 quanta of 10^-prec, divided back out here)
+static void value(const Field* f, int quant) {
+  const char* rd = quant ? "q" : "f";
+  static const char* const pow10[] = { "1", "10", "100", "1e3", "1e4", "1e5" };
+  char scale[16] = "";
+  if (quant) snprintf(scale, sizeof(scale), ", %s", pow10[f->prec]);
+  if (is(f, "U32"))           printf("dv.getUint32(o, true)");
+  else if (is(f, "I64"))      printf("Number(dv.getBigInt64(o, true))");
+  else if (is(f, "HANDTYPE")) printf("(dv.getUint8(o) ? 'right' : 'left')");
+  else if (is(f, "BOOL"))     printf("(dv.getUint8(o) === 1)");
+  else if (is(f, "NAMEDB"))   printf("namedB(dv.getUint8(o))");
+  else if (is(f, "F32"))      printf("%s1(dv, o%s)", rd, scale);
+  else if (is(f, "VEC"))      printf("%sN(dv, o, %d%s)", rd, f->n, scale);
+  else if (is(f, "VEC3S"))    printf("%s3s(dv, o, %d%s)", rd, f->n, scale);
+  else if (is(f, "NAMED3"))   printf("%sNamed3(dv, o%s)", rd, scale);
+}
+
+static void preamble(void) {
+  printf(
+    "// src/bridges/frameSchema.js\n"
+    "// GENERATED by cMiddleware/tools/gen_frame_schema.c from cMiddleware/frame_schema.h.\n"
+    "// Do not edit: change the schema and run `cmake --build <dir> --target frame_schema_js`.\n"
+    "//\n"
+    "// Decoders for the middleware's \"binary\" and \"delta\" frame streams\n"
+    "// ({\"type\": \"frameBin\", \"enc\": \"bin\"|\"delta\", \"data\": <base64>}). Both return the\n"
+    "// JSON stream's record shape ({ frameId, ts, framerate, ibox, displayId, hands: [...] }),\n"
+    "// so frameView.js's pool.fill() takes either. FIELD_BITS mirrors FM_* for --fields.\n"
+    "\n"
+    "const FINGER_NAMES = ['thumb', 'index', 'middle', 'ring', 'pinky'];\n"
+    "\n"
+    "const f1 = (dv, o) => dv.getFloat32(o, true);\n"
+    "const q1 = (dv, o, s) => dv.getInt32(o, true) / s;\n"
+    "function fN(dv, o, n) { const a = new Array(n); for (let i = 0; i < n; i++) a[i] = dv.getFloat32(o + i * 4, true); return a; }\n"
+    "function qN(dv, o, n, s) { const a = new Array(n); for (let i = 0; i < n; i++) a[i] = dv.getInt32(o + i * 4, true) / s; return a; }\n"
+    "function f3s(dv, o, n) { const a = new Array(n / 3); for (let i = 0; i < n / 3; i++) a[i] = fN(dv, o + i * 12, 3); return a; }\n"
+    "function q3s(dv, o, n, s) { const a = new Array(n / 3); for (let i = 0; i < n / 3; i++) a[i] = qN(dv, o + i * 12, 3, s); return a; }\n"
+    "function fNamed3(dv, o) { const r = {}; for (let i = 0; i < 5; i++) r[FINGER_NAMES[i]] = fN(dv, o + i * 12, 3); return r; }\n"
+    "function qNamed3(dv, o, s) { const r = {}; for (let i = 0; i < 5; i++) r[FINGER_NAMES[i]] = qN(dv, o + i * 12, 3, s); return r; }\n"
+    "function namedB(b) { const r = {}; for (let i = 0; i < 5; i++) r[FINGER_NAMES[i]] = ((b >> i) & 1) === 1; return r; }\n"
+    "\n");
+}
+
+static void fieldBits(void) {
+  printf("const FIELD_BITS = {\n");
+  for (int i = 0; i < COUNT(hand); ++i) printf("  %s: 0x%x,\n", hand[i].key, 1u << i);
+  printf("};\nconst ALL_FIELDS = 0x%x;\n", (1u << COUNT(hand)) - 1u);
+  printf("const HAND_FIELDS = [");
+  for (int i = 0; i < COUNT(hand); ++i) printf("%s'%s'", i ? ", " : "", hand[i].key);
+  printf("];\n\n");
+}
+
+// u32 mask, header fields, u8 hand count, u8 flags (bit 0: delta keyframe, bit 1: heartbeat)
+static void readHeader(void) {
+  printf("function readHeader(dv) {\n");
+  printf("  let o = 4;\n  const m = { mask: dv.getUint32(0, true) };\n");
+  for (int i = 0; i < COUNT(header); ++i) {
+    printf("  m.%s = ", header[i].key); value(&header[i], 0); printf("; o += %d;\n", width(&header[i]));
+  }
+  printf("  m.nHands = dv.getUint8(o); m.flags = dv.getUint8(o + 1);\n");
+  printf("  m.offset = o + 2;\n  return m;\n}\n\n");
+}
+
+static void decodeBinary(void) {
+  printf("// One \"bin\" record (Uint8Array/Buffer) -> JSON-shaped frame\n");
+  printf("function decodeBinary(bytes) {\n");
+  printf("  const dv = new DataView(bytes.buffer, bytes.byteOffset, bytes.byteLength);\n");
+  printf("  const m = readHeader(dv), mask = m.mask;\n");
+  printf("  let o = m.offset;\n");
+  printf("  const hands = new Array(m.nHands);\n");
+  printf("  for (let h = 0; h < m.nHands; h++) {\n    const r = {};\n");
+  for (int i = 0; i < COUNT(hand); ++i) {
+    const Field* f = &hand[i];
+    printf("    if (mask & 0x%x) { ", 1u << i);
+    if (f->cond) {
+      // absent conditional fields are NaN-filled
+      printf("if (!Number.isNaN(dv.getFloat32(o, true))) r.%s = ", f->key);
+    } else {
+      printf("r.%s = ", f->key);
+    }
+    value(f, 0);
+    printf("; o += %d; }\n", width(f));
+  }
+  printf("    hands[h] = r;\n  }\n");
+  printf("  return { frameId: m.frameId, ts: m.ts, framerate: m.framerate, ibox: m.ibox, displayId: m.displayId, hands, heartbeat: (m.flags & 2) === 2 };\n}\n\n");
+}
+
+static void deltaDecoder(void) {
+  printf(
+    "// Stateful decoder for one \"delta\" connection. A hand is reported once every field\n"
+    "// it carries has been seen (first appearance or a keyframe); until then it is left out.\n"
+    "// A gap in the record sequence (the middleware dropped a record for this client) voids\n"
+    "// every hand's state: decode() returns null until the next keyframe.\n"
+    "function createDeltaDecoder() {\n"
+    "  let state = new Map();   // id -> { r, synced }\n"
+    "  let seq = -1, lost = false;\n"
+    "  function decode(bytes) {\n"
+    "    const dv = new DataView(bytes.buffer, bytes.byteOffset, bytes.byteLength);\n"
+    "    const m = readHeader(dv);\n"
+    "    const key = (m.flags & 1) === 1;\n"
+    "    const n = dv.getUint32(m.offset, true);\n"
+    "    if (!key && seq >= 0 && n !== ((seq + 1) >>> 0)) { state = new Map(); lost = true; }\n"
+    "    seq = n;\n"
+    "    if (key) lost = false;\n"
+    "    if (lost) return null;\n"
+    "    let o = m.offset + 4;\n"
+    "    const next = new Map();\n"
+    "    const hands = [];\n"
+    "    for (let h = 0; h < m.nHands; h++) {\n"
+    "      const id = dv.getUint32(o, true), present = dv.getUint32(o + 4, true), changed = dv.getUint32(o + 8, true);\n"
+    "      o += 12;\n"
+    "      const s = state.get(id) || { r: { id }, synced: false };\n"
+    "      const r = s.r;\n");
+  for (int i = 1; i < COUNT(hand); ++i) {   // ID heads the hand, never in changed
+    const Field* f = &hand[i];
+    printf("      if (changed & 0x%x) { r.%s = ", 1u << i, f->key);
+    value(f, 1);
+    printf("; o += %d; }", width(f));
+    if (f->cond) printf(" else if (!(present & 0x%x)) delete r.%s;", 1u << i, f->key);
+    printf("\n");
+  }
+  printf(
+    "      s.synced = s.synced || (present & ~changed & 0x%x) === 0;\n"
+    "      next.set(id, s);\n"
+    "      if (s.synced) hands.push(r);\n"
+    "    }\n"
+    "    state = next;   // hands missing from this record are gone\n"
+    "    return { frameId: m.frameId, ts: m.ts, framerate: m.framerate, ibox: m.ibox, displayId: m.displayId, hands, keyframe: key, heartbeat: (m.flags & 2) === 2 };\n"
+    "  }\n"
+    "  function reset() { state = new Map(); seq = -1; lost = false; }\n"
+    "  return { decode, reset };\n"
+    "}\n\n", ((1u << COUNT(hand)) - 1u) & ~1u);
+}
+
+static void epilogue(void) {
+  printf(
+    "// Parsed {\"type\": \"frameBin\"} line -> JSON-shaped frame (null when the encoding is\n"
+    "// unknown). delta: a createDeltaDecoder() kept per connection.\n"
+    "function decodeRecord(msg, delta) {\n"
+    "  if (typeof msg.data !== 'string') return null;\n"
+    "  const bytes = Buffer.from(msg.data, 'base64');\n"
+    "  if (msg.enc === 'bin') return decodeBinary(bytes);\n"
+    "  if (msg.enc === 'delta' && delta) return delta.decode(bytes);\n"
+    "  return null;\n"
+    "}\n"
+    "\n"
+    "module.exports = { FIELD_BITS, ALL_FIELDS, HAND_FIELDS, decodeBinary, createDeltaDecoder, decodeRecord };\n");
+}
+
+int main(void) {
+  preamble();
+  fieldBits();
+  readHeader();
+  decodeBinary();
+  deltaDecoder();
+  epilogue();
+  return 0;
+}
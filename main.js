@@ -4,6 +4,7 @@ const path = require('path');
 const fs = require('fs');
 const { execFileSync } = require('child_process');
 const GestureEngine = require('./src/gestureEngine');
+const { createHudPublisher } = require('./src/core/hudPublisher');
 const CFG = require('./src/core/cfg'); // for live threshold updates
 
 const CONFIG_PATH = path.join(app.getPath('userData'), 'config.json');
@@ -88,7 +89,8 @@ function ensureAxwin() {
   const helperOut = path.join(__dirname, 'axwin');
   const swiftSrc  = path.join(__dirname, 'src', 'axwin.swift');
   try {
-    if (!fs.existsSync(helperOut) && fs.existsSync(swiftSrc)) {
+    const stale = fs.existsSync(helperOut) && fs.existsSync(swiftSrc) && fs.statSync(swiftSrc).mtimeMs > fs.statSync(helperOut).mtimeMs;
+    if ((stale || !fs.existsSync(helperOut)) && fs.existsSync(swiftSrc)) {
       execFileSync('swiftc', ['-O', swiftSrc, '-o', helperOut], { stdio: 'ignore' });
     }
     if (fs.existsSync(helperOut)) { fs.chmodSync(helperOut, 0o755); return helperOut; }
@@ -136,6 +138,12 @@ ensureProfilesFile();
 let tray = null, hudWindow = null, engine = null;
 let currentProfileName = 'Default';
 
+// Diffed HUD updates, at most one per HUD animation frame (HUD_COMPACT=1: packed numbers)
+const hudPub = createHudPublisher({
+  send: (p) => hudWindow && hudWindow.webContents.send('hud:update', p),
+  compact: process.env.HUD_COMPACT === '1',
+});
+
 function createHUD() {
   hudWindow = new BrowserWindow({
     width: 800, height: 600, transparent: true, frame: false, resizable: false,
@@ -144,6 +152,7 @@ function createHUD() {
   });
   hudWindow.setIgnoreMouseEvents(false);
   hudWindow.loadFile(path.join(__dirname, 'src', 'hud', 'hud.html'));
+  hudWindow.webContents.on('did-finish-load', () => hudPub.reset());
   if (!cfg.showHUD) hudWindow.setOpacity(0);
 }
 
@@ -152,6 +161,7 @@ function rebuildTray() {
     { label: 'Show HUD Overlay', type: 'checkbox', checked: cfg.showHUD, click: (i) => {
       cfg.showHUD = i.checked; saveConfig(cfg);
       if (hudWindow) { hudWindow.webContents.send('hud:toggle', cfg.showHUD); hudWindow.setOpacity(cfg.showHUD ? 1 : 0); }
+      if (cfg.showHUD) hudPub.reset();   // patches were not kept while hidden
     }},
     { label: 'Three-Finger Drag', type: 'checkbox', checked: cfg.threeFingerDrag, click: (i) => {
       cfg.threeFingerDrag = i.checked; saveConfig(cfg); engine?.setThreeFingerDrag(cfg.threeFingerDrag);
@@ -190,6 +200,12 @@ function rebuildTray() {
       { label: 'Open Gestures Folder', click: () => shell.openPath(path.join(app.getPath('userData'), 'gestures')) },
       { label: 'Replay Last Saved Segment', click: () => engine?.trainerReplayLast() },
     ]},
+    { label: 'Profiler', submenu: [
+      { label: 'Time Handlers', type: 'checkbox', checked: process.env.LEAP_PROFILE === '1', click: (i) => engine?.profilerEnable(i.checked) },
+      { label: 'Reset', click: () => engine?.profilerReset() },
+      { label: 'Export Chrome Trace', click: () => engine?.profilerExport() },
+      { label: 'Open Traces Folder', click: () => shell.openPath(path.join(app.getPath('userData'), 'traces')) },
+    ]},
     { type: 'separator' },
     { label: 'Settings…', click: () => createSettingsWindow() },
     { type: 'separator' },
@@ -222,12 +238,18 @@ function startEngine() {
       saveConfig(cfg);
     },
     onHUD: (payload) => {
-      if (hudWindow && cfg.showHUD) hudWindow.webContents.send('hud:update', payload);
+      if (hudWindow && cfg.showHUD) hudPub.patch(payload);
       if (payload?.profile?.name && payload.profile.name !== currentProfileName) {
         currentProfileName = payload.profile.name;
         rebuildTray();
       }
     },
+    onImage: (img) => {
+      // first camera only; IPC copies it, the pooled buffer is reused on the next image
+      if (!hudWindow || !cfg.showHUD) return;
+      const bytes = img.width * img.height * img.bpp;
+      hudWindow.webContents.send('hud:image', { w: img.width, h: img.height, bpp: img.bpp, px: img.pixels.subarray(0, bytes) });
+    },
     onCalState: (payload) => {
       if (payload.mode === 'done') {
         const { rect, displayId } = payload;
@@ -252,6 +274,7 @@ app.on('window-all-closed', (e) => e.preventDefault());
 app.on('before-quit', () => engine?.stop());
 
 // ---------- HUD / feature IPC ----------
+ipcMain.on('hud:ready', () => hudPub.ready());
 ipcMain.handle('cal:start',  () => engine?.startCalibration());
 ipcMain.handle('cal:cancel', () => engine?.cancelCalibration());
 
@@ -315,6 +338,7 @@ ipcMain.handle('settings:save', (_e, patch) => {
 
   if ('swipeMinVel'      in patch) CFG.swipeMinVel      = Number(patch.swipeMinVel);
   if ('moveSnapSwipeVel' in patch) CFG.moveSnapSwipeVel = Number(patch.moveSnapSwipeVel);
+  engine?.syncSettings(); // gesture worker keeps its own copy
 
   // Apply gestures live
   if (patch.gestures) {
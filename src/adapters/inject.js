@@ -0,0 +1,131 @@
+// src/adapters/inject.js
+// Batched input injection. The engine keeps calling the adapters/io surface (mouse,
+// keyboard, keyChord, window ops), but calls only queue compact commands (the
+// src/worker/remoteIO.js format): consecutive moves coalesce, consecutive scrolls sum,
+// and the queue goes to a backend as one batch per actuation tick.
+//
+// Backends: { post(cmds), stop(), stats }
+//   axwinBackend     persistent `axwin inject` (CGEvents), one stdin write per batch;
+//                    no process per chord, no per-call native round trip
+//   adapterBackend   replays batches on nut.js / robotjs (src/worker/actuator.js)
+//   createRecordingBackend   keeps the batches (tests, Linux)
+//
+// LEAP_INJECT=helper|adapter|direct picks the path in src/gestureEngine.js.
+const { spawn } = require('child_process');
+const { createRemoteIO } = require('../worker/remoteIO');
+const { createActuator } = require('../worker/actuator');
+
+// command -> `axwin inject` line (null: not for the helper)
+function encodeCommand(c) {
+  switch (c[0]) {
+    case 'm': return `m ${Math.round(c[1])} ${Math.round(c[2])}`;
+    case 's': {
+      const dx = Math.trunc(c[1]), dy = Math.trunc(c[2]);
+      return dx || dy ? `s ${dx} ${dy}` : null;
+    }
+    case 'c': case 'd': case 'u': case 'kd': case 'ku': return `${c[0]} ${c[1]}`;
+    case 'k': return c[1].length ? `k ${c[1].join('+')}` : null;
+    case 'w': return c[1] === 'snap' ? `w snap ${c[2]}` : `w ${c[1]} ${Math.round(c[2])} ${Math.round(c[3])}`;
+    default: return null;
+  }
+}
+
+function encodeBatch(cmds) {
+  let out = '';
+  for (const c of cmds) {
+    const line = encodeCommand(c);
+    if (line) out += line + '\n';
+  }
+  return out;
+}
+
+function adapterBackend(io, opts) {
+  const act = createActuator(io, opts);
+  return { post: (cmds) => act.apply(cmds), stop() {}, stats: act.stats };
+}
+
+// Spawned on the first batch. An older helper without `inject` exits at once: after a
+// few quick exits (or if it can't be spawned at all) batches go to `fallback` for good.
+// A missing helper only fails after the spawn ('error'), so the batches written before
+// it came up are kept until 'spawn' and replayed on the fallback if it never does (a
+// lost button release would leave a drag stuck).
+function axwinBackend(helperPath, { fallback = null, restartMs = 1000 } = {}) {
+  const stats = { batches: 0, commands: 0, writes: 0, restarts: 0, fellBack: false };
+  let child = null, early = null, failures = 0, retryAt = 0;   // early: batches before 'spawn'
+
+  function ensure() {
+    if (child || stats.fellBack || Date.now() < retryAt) return child;
+    const c = spawn(helperPath, ['inject'], { stdio: ['pipe', 'ignore', 'ignore'] });
+    const born = Date.now();
+    const unsent = early = [];
+    c.on('spawn', () => { unsent.length = 0; if (early === unsent) early = null; });
+    c.on('error', () => {
+      if (child === c) child = null;
+      if (early === unsent) early = null;
+      stats.fellBack = !!fallback;
+      retryAt = Date.now() + restartMs;
+      for (const cmds of unsent.splice(0)) fallback?.post(cmds);
+    });
+    c.stdin.on('error', () => {});
+    c.on('exit', () => {
+      if (child === c) child = null;
+      if (Date.now() - born > 5000) failures = 0;     // it ran: a crash, not a missing mode
+      if (++failures >= 3) stats.fellBack = !!fallback;
+      retryAt = Date.now() + restartMs;
+      stats.restarts++;
+    });
+    child = c;
+    return child;
+  }
+
+  function post(cmds) {
+    stats.batches++;
+    stats.commands += cmds.length;
+    const c = ensure();
+    // helper down (restarting or given up): this batch goes through the fallback
+    if (!c) return fallback?.post(cmds);
+    const text = encodeBatch(cmds);
+    if (!text) return;
+    stats.writes++;
+    early?.push(cmds);
+    c.stdin.write(text);
+  }
+
+  // ends the helper (stdin EOF); a later batch starts a new one
+  function stop() {
+    try { child?.stdin.end(); } catch {}
+    child = null;
+    fallback?.stop();
+  }
+
+  return { post, stop, stats };
+}
+
+function createRecordingBackend() {
+  const batches = [];
+  const stats = { batches: 0, commands: 0 };
+  return {
+    batches,
+    stats,
+    post(cmds) { stats.batches++; stats.commands += cmds.length; batches.push(cmds.map((c) => c.slice())); },
+    commands: () => batches.flat(),
+    stop() {},
+  };
+}
+
+// The io surface over a backend. `io` (the direct adapter) answers reads such as the
+// cursor position; tickMs 0 = one batch per event-loop turn.
+function createBatchedIO(backend, { io = null, tickMs = 4 } = {}) {
+  const q = createRemoteIO((m) => backend.post(m.c), { tickMs });
+  const { runBinding, ...surface } = q;   // bindings run through Profiles, not the queue
+  // reads go to the real cursor once the queued moves are out
+  if (io?.mouse?.getPosition) q.mouse.getPosition = async () => { q.flush(); return io.mouse.getPosition(); };
+  return {
+    ...surface,
+    screen: io?.screen || surface.screen,
+    backend,
+    stop() { q.flush(); backend.stop(); },
+  };
+}
+
+module.exports = { createBatchedIO, axwinBackend, adapterBackend, createRecordingBackend, encodeCommand, encodeBatch };
@@ -82,6 +82,8 @@ function withRobot() {
       // F-keys: F11 (103), F4 (118)
       if (keys.some(k => /F11/.test(k))) keyCode = 103;
       if (keys.some(k => /F4/.test(k)))  keyCode = 118;
+      if (keys.includes('L')) keyCode = 37;
+      if (keys.includes('R')) keyCode = 15;
 
       if (keyCode == null) return; // nothing to do
       await osaKeyChord(mods, keyCode);
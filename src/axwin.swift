@@ -78,9 +78,158 @@ func snapRect(_ which: String, screen: CGRect) -> CGRect {
     }
 }
 
+// Streams frontmost-app changes as lines: "front <bundleId> <pid>" (initial app first).
+// Push-based (NSWorkspace activation notifications); exits when stdin closes so the
+// helper never outlives its parent.
+func watchFront() -> Never {
+    setvbuf(stdout, nil, _IOLBF, 0)
+    func emit(_ app: NSRunningApplication?) {
+        guard let app = app else { return }
+        print("front \(app.bundleIdentifier ?? "") \(app.processIdentifier)")
+    }
+    emit(NSWorkspace.shared.frontmostApplication)
+    NSWorkspace.shared.notificationCenter.addObserver(
+        forName: NSWorkspace.didActivateApplicationNotification, object: nil, queue: .main
+    ) { note in
+        emit(note.userInfo?[NSWorkspace.applicationUserInfoKey] as? NSRunningApplication)
+    }
+    Thread.detachNewThread {
+        while readLine(strippingNewline: true) != nil {}
+        exit(0)
+    }
+    RunLoop.main.run()
+    exit(0)
+}
+
+// ---- inject: persistent input injection ----
+// Reads command lines from stdin (one batch = one write from src/adapters/inject.js)
+// and posts them as CGEvents, so the engine never spawns a process per event:
+//   m <x> <y>            move cursor (drag while a button is held)
+//   s <dx> <dy>          scroll, pixels (dy > 0 = up)
+//   c|d|u <button>       click / press / release (LEFT, RIGHT, MIDDLE)
+//   kd|ku <key>          key down / up (Key names: LeftSuper, Up, F11, A...)
+//   k <key>+<key>...     chord: modifiers held, other keys pressed in order
+//   w move|resize <a> <b> / w snap <which>   front window ops
+// Exits when stdin closes so the helper never outlives its parent.
+
+let keyCodes: [String: CGKeyCode] = [
+    "A": 0, "S": 1, "D": 2, "F": 3, "H": 4, "G": 5, "Z": 6, "X": 7, "C": 8, "V": 9,
+    "B": 11, "Q": 12, "W": 13, "E": 14, "R": 15, "Y": 16, "T": 17,
+    "Num1": 18, "Num2": 19, "Num3": 20, "Num4": 21, "Num6": 22, "Num5": 23,
+    "Num9": 25, "Num7": 26, "Num8": 28, "Num0": 29,
+    "O": 31, "U": 32, "I": 34, "P": 35, "Return": 36, "Enter": 36, "L": 37, "J": 38,
+    "K": 40, "N": 45, "M": 46, "Tab": 48, "Space": 49, "Backspace": 51, "Escape": 53,
+    "LeftSuper": 55, "LeftShift": 56, "LeftAlt": 58, "LeftControl": 59,
+    "RightSuper": 54, "RightShift": 60, "RightAlt": 61, "RightControl": 62,
+    "F5": 96, "F6": 97, "F7": 98, "F3": 99, "F8": 100, "F9": 101, "F11": 103,
+    "F10": 109, "F12": 111, "Home": 115, "PageUp": 116, "Delete": 117, "F4": 118,
+    "End": 119, "F2": 120, "PageDown": 121, "F1": 122,
+    "Left": 123, "Right": 124, "Down": 125, "Up": 126,
+]
+
+let modifierFlags: [String: CGEventFlags] = [
+    "LeftSuper": .maskCommand, "RightSuper": .maskCommand,
+    "LeftShift": .maskShift, "RightShift": .maskShift,
+    "LeftAlt": .maskAlternate, "RightAlt": .maskAlternate,
+    "LeftControl": .maskControl, "RightControl": .maskControl,
+]
+
+struct Injector {
+    let src = CGEventSource(stateID: .hidSystemState)
+    var flags: CGEventFlags = []
+    var held: CGMouseButton? = nil
+
+    func cursor() -> CGPoint { CGEvent(source: nil)?.location ?? .zero }
+
+    func button(_ name: Substring) -> (CGMouseButton, CGEventType, CGEventType) {
+        switch name {
+        case "RIGHT":  return (.right, .rightMouseDown, .rightMouseUp)
+        case "MIDDLE": return (.center, .otherMouseDown, .otherMouseUp)
+        default:       return (.left, .leftMouseDown, .leftMouseUp)
+        }
+    }
+
+    func mouse(_ type: CGEventType, _ b: CGMouseButton, _ at: CGPoint) {
+        CGEvent(mouseEventSource: src, mouseType: type, mouseCursorPosition: at, mouseButton: b)?
+            .post(tap: .cghidEventTap)
+    }
+
+    func key(_ name: Substring, down: Bool, flags: CGEventFlags) {
+        guard let code = keyCodes[String(name)] else { return }
+        let e = CGEvent(keyboardEventSource: src, virtualKey: code, keyDown: down)
+        e?.flags = flags
+        e?.post(tap: .cghidEventTap)
+    }
+
+    mutating func run(_ f: [Substring]) throws {
+        guard let op = f.first else { return }
+        switch op {
+        case "m":
+            guard f.count == 3, let x = Double(f[1]), let y = Double(f[2]) else { throw AXWError.invalidArgs }
+            let drag: CGEventType = held == .right ? .rightMouseDragged : held == .center ? .otherMouseDragged : .leftMouseDragged
+            mouse(held == nil ? .mouseMoved : drag, held ?? .left, CGPoint(x: x, y: y))
+        case "s":
+            guard f.count == 3, let dx = Int32(f[1]), let dy = Int32(f[2]) else { throw AXWError.invalidArgs }
+            // wheel2 > 0 scrolls left
+            CGEvent(scrollWheelEvent2Source: src, units: .pixel, wheelCount: 2, wheel1: dy, wheel2: -dx, wheel3: 0)?
+                .post(tap: .cghidEventTap)
+        case "c", "d", "u":
+            guard f.count == 2 else { throw AXWError.invalidArgs }
+            let (b, downType, upType) = button(f[1])
+            let at = cursor()
+            if op != "u" { mouse(downType, b, at); held = b }
+            if op != "d" { mouse(upType, b, at); held = nil }
+        case "kd", "ku":
+            guard f.count == 2 else { throw AXWError.invalidArgs }
+            if let m = modifierFlags[String(f[1])] {
+                if op == "kd" { flags.insert(m) } else { flags.remove(m) }
+            }
+            key(f[1], down: op == "kd", flags: flags)
+        case "k":
+            guard f.count == 2 else { throw AXWError.invalidArgs }
+            let keys = f[1].split(separator: "+")
+            var chord = flags
+            for k in keys { if let m = modifierFlags[String(k)] { chord.insert(m) } }
+            let plain = keys.filter { modifierFlags[String($0)] == nil }
+            for k in plain { key(k, down: true, flags: chord) }
+            for k in plain.reversed() { key(k, down: false, flags: chord) }
+        case "w":
+            guard f.count >= 3 else { throw AXWError.invalidArgs }
+            let win = try firstWindow(try frontmostApp())
+            var r = try getRect(win)
+            switch f[1] {
+            case "move":
+                guard f.count == 4, let dx = Double(f[2]), let dy = Double(f[3]) else { throw AXWError.invalidArgs }
+                r.origin.x += dx; r.origin.y += dy
+            case "resize":
+                guard f.count == 4, let dw = Double(f[2]), let dh = Double(f[3]) else { throw AXWError.invalidArgs }
+                r.size.width = max(200, r.size.width + dw); r.size.height = max(150, r.size.height + dh)
+            case "snap":
+                r = snapRect(String(f[2]), screen: activeScreenBounds())
+            default:
+                throw AXWError.invalidArgs
+            }
+            try setRect(win, r)
+        default:
+            throw AXWError.invalidArgs
+        }
+    }
+}
+
+func inject() -> Never {
+    var inj = Injector()
+    while let line = readLine(strippingNewline: true) {
+        do { try inj.run(line.split(separator: " ")) }
+        catch { fputs("ERR \(error) \(line)\n", stderr) }
+    }
+    exit(0)
+}
+
 func main() throws {
     let args = CommandLine.arguments.dropFirst()
     guard let cmd = args.first else { throw AXWError.invalidArgs }
+    if cmd == "watchFront" { watchFront() }
+    if cmd == "inject" { inject() }
 
     let app = try frontmostApp()
     let win = try firstWindow(app)
@@ -0,0 +1,166 @@
+// src/bridges/frameSchema.js
+// GENERATED by cMiddleware/tools/gen_frame_schema.c from cMiddleware/frame_schema.h.
+// Do not edit: change the schema and run `cmake --build <dir> --target frame_schema_js`.
+//
+// Decoders for the middleware's "binary" and "delta" frame streams
+// ({"type": "frameBin", "enc": "bin"|"delta", "data": <base64>}). Both return the
+// JSON stream's record shape ({ frameId, ts, framerate, ibox, displayId, hands: [...] }),
+// so frameView.js's pool.fill() takes either. FIELD_BITS mirrors FM_* for --fields.
+
+const FINGER_NAMES = ['thumb', 'index', 'middle', 'ring', 'pinky'];
+
+const f1 = (dv, o) => dv.getFloat32(o, true);
+const q1 = (dv, o, s) => dv.getInt32(o, true) / s;
+function fN(dv, o, n) { const a = new Array(n); for (let i = 0; i < n; i++) a[i] = dv.getFloat32(o + i * 4, true); return a; }
+function qN(dv, o, n, s) { const a = new Array(n); for (let i = 0; i < n; i++) a[i] = dv.getInt32(o + i * 4, true) / s; return a; }
+function f3s(dv, o, n) { const a = new Array(n / 3); for (let i = 0; i < n / 3; i++) a[i] = fN(dv, o + i * 12, 3); return a; }
+function q3s(dv, o, n, s) { const a = new Array(n / 3); for (let i = 0; i < n / 3; i++) a[i] = qN(dv, o + i * 12, 3, s); return a; }
+function fNamed3(dv, o) { const r = {}; for (let i = 0; i < 5; i++) r[FINGER_NAMES[i]] = fN(dv, o + i * 12, 3); return r; }
+function qNamed3(dv, o, s) { const r = {}; for (let i = 0; i < 5; i++) r[FINGER_NAMES[i]] = qN(dv, o + i * 12, 3, s); return r; }
+function namedB(b) { const r = {}; for (let i = 0; i < 5; i++) r[FINGER_NAMES[i]] = ((b >> i) & 1) === 1; return r; }
+
+const FIELD_BITS = {
+  id: 0x1,
+  type: 0x2,
+  palmPosition: 0x4,
+  grab: 0x8,
+  pinch: 0x10,
+  pinchDistance: 0x20,
+  grabAngle: 0x40,
+  palmStab: 0x80,
+  palmVel: 0x100,
+  palmQuat: 0x200,
+  roll: 0x400,
+  pitch: 0x800,
+  yaw: 0x1000,
+  palmNormal: 0x2000,
+  palmDir: 0x4000,
+  angVel: 0x8000,
+  palmNorm: 0x10000,
+  tipsNorm: 0x20000,
+  screen: 0x40000,
+  fingers: 0x80000,
+  fingerExtended: 0x100000,
+  confidence: 0x200000,
+  isNew: 0x400000,
+};
+const ALL_FIELDS = 0x7fffff;
+const HAND_FIELDS = ['id', 'type', 'palmPosition', 'grab', 'pinch', 'pinchDistance', 'grabAngle', 'palmStab', 'palmVel', 'palmQuat', 'roll', 'pitch', 'yaw', 'palmNormal', 'palmDir', 'angVel', 'palmNorm', 'tipsNorm', 'screen', 'fingers', 'fingerExtended', 'confidence', 'isNew'];
+
+function readHeader(dv) {
+  let o = 4;
+  const m = { mask: dv.getUint32(0, true) };
+  m.frameId = Number(dv.getBigInt64(o, true)); o += 8;
+  m.ts = Number(dv.getBigInt64(o, true)); o += 8;
+  m.framerate = f1(dv, o); o += 4;
+  m.ibox = fN(dv, o, 6); o += 24;
+  m.displayId = dv.getUint32(o, true); o += 4;
+  m.nHands = dv.getUint8(o); m.flags = dv.getUint8(o + 1);
+  m.offset = o + 2;
+  return m;
+}
+
+// One "bin" record (Uint8Array/Buffer) -> JSON-shaped frame
+function decodeBinary(bytes) {
+  const dv = new DataView(bytes.buffer, bytes.byteOffset, bytes.byteLength);
+  const m = readHeader(dv), mask = m.mask;
+  let o = m.offset;
+  const hands = new Array(m.nHands);
+  for (let h = 0; h < m.nHands; h++) {
+    const r = {};
+    if (mask & 0x1) { r.id = dv.getUint32(o, true); o += 4; }
+    if (mask & 0x2) { r.type = (dv.getUint8(o) ? 'right' : 'left'); o += 1; }
+    if (mask & 0x4) { r.palmPosition = fN(dv, o, 3); o += 12; }
+    if (mask & 0x8) { r.grab = f1(dv, o); o += 4; }
+    if (mask & 0x10) { r.pinch = f1(dv, o); o += 4; }
+    if (mask & 0x20) { r.pinchDistance = f1(dv, o); o += 4; }
+    if (mask & 0x40) { r.grabAngle = f1(dv, o); o += 4; }
+    if (mask & 0x80) { r.palmStab = fN(dv, o, 3); o += 12; }
+    if (mask & 0x100) { r.palmVel = fN(dv, o, 3); o += 12; }
+    if (mask & 0x200) { r.palmQuat = fN(dv, o, 4); o += 16; }
+    if (mask & 0x400) { if (!Number.isNaN(dv.getFloat32(o, true))) r.roll = f1(dv, o); o += 4; }
+    if (mask & 0x800) { if (!Number.isNaN(dv.getFloat32(o, true))) r.pitch = f1(dv, o); o += 4; }
+    if (mask & 0x1000) { if (!Number.isNaN(dv.getFloat32(o, true))) r.yaw = f1(dv, o); o += 4; }
+    if (mask & 0x2000) { if (!Number.isNaN(dv.getFloat32(o, true))) r.palmNormal = fN(dv, o, 3); o += 12; }
+    if (mask & 0x4000) { if (!Number.isNaN(dv.getFloat32(o, true))) r.palmDir = fN(dv, o, 3); o += 12; }
+    if (mask & 0x8000) { if (!Number.isNaN(dv.getFloat32(o, true))) r.angVel = fN(dv, o, 3); o += 12; }
+    if (mask & 0x10000) { r.palmNorm = fN(dv, o, 3); o += 12; }
+    if (mask & 0x20000) { r.tipsNorm = f3s(dv, o, 15); o += 60; }
+    if (mask & 0x40000) { if (!Number.isNaN(dv.getFloat32(o, true))) r.screen = fN(dv, o, 2); o += 8; }
+    if (mask & 0x80000) { r.fingers = fNamed3(dv, o); o += 60; }
+    if (mask & 0x100000) { r.fingerExtended = namedB(dv.getUint8(o)); o += 1; }
+    if (mask & 0x200000) { r.confidence = f1(dv, o); o += 4; }
+    if (mask & 0x400000) { r.isNew = (dv.getUint8(o) === 1); o += 1; }
+    hands[h] = r;
+  }
+  return { frameId: m.frameId, ts: m.ts, framerate: m.framerate, ibox: m.ibox, displayId: m.displayId, hands, heartbeat: (m.flags & 2) === 2 };
+}
+
+// Stateful decoder for one "delta" connection. A hand is reported once every field
+// it carries has been seen (first appearance or a keyframe); until then it is left out.
+// A gap in the record sequence (the middleware dropped a record for this client) voids
+// every hand's state: decode() returns null until the next keyframe.
+function createDeltaDecoder() {
+  let state = new Map();   // id -> { r, synced }
+  let seq = -1, lost = false;
+  function decode(bytes) {
+    const dv = new DataView(bytes.buffer, bytes.byteOffset, bytes.byteLength);
+    const m = readHeader(dv);
+    const key = (m.flags & 1) === 1;
+    const n = dv.getUint32(m.offset, true);
+    if (!key && seq >= 0 && n !== ((seq + 1) >>> 0)) { state = new Map(); lost = true; }
+    seq = n;
+    if (key) lost = false;
+    if (lost) return null;
+    let o = m.offset + 4;
+    const next = new Map();
+    const hands = [];
+    for (let h = 0; h < m.nHands; h++) {
+      const id = dv.getUint32(o, true), present = dv.getUint32(o + 4, true), changed = dv.getUint32(o + 8, true);
+      o += 12;
+      const s = state.get(id) || { r: { id }, synced: false };
+      const r = s.r;
+      if (changed & 0x2) { r.type = (dv.getUint8(o) ? 'right' : 'left'); o += 1; }
+      if (changed & 0x4) { r.palmPosition = qN(dv, o, 3, 10); o += 12; }
+      if (changed & 0x8) { r.grab = q1(dv, o, 1e3); o += 4; }
+      if (changed & 0x10) { r.pinch = q1(dv, o, 1e3); o += 4; }
+      if (changed & 0x20) { r.pinchDistance = q1(dv, o, 100); o += 4; }
+      if (changed & 0x40) { r.grabAngle = q1(dv, o, 1e3); o += 4; }
+      if (changed & 0x80) { r.palmStab = qN(dv, o, 3, 10); o += 12; }
+      if (changed & 0x100) { r.palmVel = qN(dv, o, 3, 1); o += 12; }
+      if (changed & 0x200) { r.palmQuat = qN(dv, o, 4, 1e5); o += 16; }
+      if (changed & 0x400) { r.roll = q1(dv, o, 1e4); o += 4; } else if (!(present & 0x400)) delete r.roll;
+      if (changed & 0x800) { r.pitch = q1(dv, o, 1e4); o += 4; } else if (!(present & 0x800)) delete r.pitch;
+      if (changed & 0x1000) { r.yaw = q1(dv, o, 1e4); o += 4; } else if (!(present & 0x1000)) delete r.yaw;
+      if (changed & 0x2000) { r.palmNormal = qN(dv, o, 3, 1e4); o += 12; } else if (!(present & 0x2000)) delete r.palmNormal;
+      if (changed & 0x4000) { r.palmDir = qN(dv, o, 3, 1e4); o += 12; } else if (!(present & 0x4000)) delete r.palmDir;
+      if (changed & 0x8000) { r.angVel = qN(dv, o, 3, 1e3); o += 12; } else if (!(present & 0x8000)) delete r.angVel;
+      if (changed & 0x10000) { r.palmNorm = qN(dv, o, 3, 1e4); o += 12; }
+      if (changed & 0x20000) { r.tipsNorm = q3s(dv, o, 15, 1e4); o += 60; }
+      if (changed & 0x40000) { r.screen = qN(dv, o, 2, 10); o += 8; } else if (!(present & 0x40000)) delete r.screen;
+      if (changed & 0x80000) { r.fingers = qNamed3(dv, o, 10); o += 60; }
+      if (changed & 0x100000) { r.fingerExtended = namedB(dv.getUint8(o)); o += 1; }
+      if (changed & 0x200000) { r.confidence = q1(dv, o, 100); o += 4; }
+      if (changed & 0x400000) { r.isNew = (dv.getUint8(o) === 1); o += 1; }
+      s.synced = s.synced || (present & ~changed & 0x7ffffe) === 0;
+      next.set(id, s);
+      if (s.synced) hands.push(r);
+    }
+    state = next;   // hands missing from this record are gone
+    return { frameId: m.frameId, ts: m.ts, framerate: m.framerate, ibox: m.ibox, displayId: m.displayId, hands, keyframe: key, heartbeat: (m.flags & 2) === 2 };
+  }
+  function reset() { state = new Map(); seq = -1; lost = false; }
+  return { decode, reset };
+}
+
+// Parsed {"type": "frameBin"} line -> JSON-shaped frame (null when the encoding is
+// unknown). delta: a createDeltaDecoder() kept per connection.
+function decodeRecord(msg, delta) {
+  if (typeof msg.data !== 'string') return null;
+  const bytes = Buffer.from(msg.data, 'base64');
+  if (msg.enc === 'bin') return decodeBinary(bytes);
+  if (msg.enc === 'delta' && delta) return delta.decode(bytes);
+  return null;
+}
+
+module.exports = { FIELD_BITS, ALL_FIELDS, HAND_FIELDS, decodeBinary, createDeltaDecoder, decodeRecord };
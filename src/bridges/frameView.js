@@ -0,0 +1,233 @@
+// src/bridges/frameView.js
+// Pooled, typed-array backed frames for the LeapC bridge.
+// Every hand is a fixed Float32Array/Uint8Array record; the objects the engine sees
+// (hand, fingers, vectors) are created once per slot and re-filled in place each frame,
+// so steady-state tracking allocates nothing beyond the parsed JSON message.
+//
+// Vectors are Float32Array views (index like arrays, but Array.isArray() is false):
+// consumers that need plain arrays (JSON rows, recordings) should Array.from() them.
+// The stabilized palm and every tip carry a `normalized` twin (interaction box space,
+// filled once per frame from the middleware's palmNorm/tipsNorm or computed here), which
+// interactionBox.normalizePoint() returns without recomputing.
+
+const { createInteractionBox } = require('../core/interactionBox');
+
+const FINGER_NAMES = ['thumb', 'index', 'middle', 'ring', 'pinky'];
+
+// Float32 layout per hand
+const F = {
+  PALM: 0,        // palmPosition xyz
+  VEL: 3,         // palmVelocity xyz
+  STAB: 6,        // palmStabilized xyz
+  QUAT: 9,        // palmQuaternion xyzw
+  PINCH_DIST: 13,
+  GRAB_ANGLE: 14,
+  PINCH: 15,
+  GRAB: 16,
+  TIPS: 17,       // 5 x xyz
+  ROLL: 32,       // radians (LeapJS conventions)
+  PITCH: 33,
+  YAW: 34,
+  NORMAL: 35,     // palmNormal xyz
+  DIR: 38,        // direction xyz
+  ANGVEL: 41,     // angular velocity xyz, rad/s
+  NORM_STAB: 44,  // normalized palmStabilized xyz
+  NORM_TIPS: 47,  // 5 x normalized tip xyz
+  SCREEN: 62,     // index tip on the active display (px), valid when U.SCREEN_OK
+  CONF: 64,       // tracking confidence 0..1
+  SIZE: 65,
+};
+// Uint8 layout per hand; NEW: 1 entering, 0 settled, 2 not sent (older middleware, replays)
+const U = { EXT: 0, TYPE: 5, SCREEN_OK: 6, NEW: 7, SIZE: 8 };
+
+class FingerView {
+  constructor(u8, type, tip, norm) {
+    this._u8 = u8;
+    this.type = type;
+    this.stabilizedTipPosition = tip;
+    tip.normalized = norm;
+  }
+  get extended() { return this._u8[U.EXT + this.type] === 1; }
+}
+
+class HandView {
+  constructor(f32, u8, interactionBox) {
+    this._f = f32;
+    this._u = u8;
+    this._box = interactionBox;
+    this.id = 0;
+
+    this.palmPosition   = f32.subarray(F.PALM, F.PALM + 3);
+    this.palmVelocity   = f32.subarray(F.VEL, F.VEL + 3);
+    this.palmStabilized = f32.subarray(F.STAB, F.STAB + 3);
+    this.palmQuaternion = f32.subarray(F.QUAT, F.QUAT + 4);
+    this.stabilizedPalmPosition = this.palmStabilized; // LeapJS name
+    this.palmStabilized.normalized = f32.subarray(F.NORM_STAB, F.NORM_STAB + 3);
+    this.screen = f32.subarray(F.SCREEN, F.SCREEN + 2);
+    this.palmNormal      = f32.subarray(F.NORMAL, F.NORMAL + 3);
+    this.direction       = f32.subarray(F.DIR, F.DIR + 3);
+    this.angularVelocity = f32.subarray(F.ANGVEL, F.ANGVEL + 3);
+
+    this.fingers = FINGER_NAMES.map((_, i) =>
+      new FingerView(u8, i, f32.subarray(F.TIPS + i * 3, F.TIPS + i * 3 + 3), f32.subarray(F.NORM_TIPS + i * 3, F.NORM_TIPS + i * 3 + 3)));
+    this.indexFinger = this.fingers[1];
+  }
+
+  get type()          { return this._u[U.TYPE]; }        // 0 = left, 1 = right
+  get pinchDistance() { return this._f[F.PINCH_DIST]; }
+  get grabAngle()     { return this._f[F.GRAB_ANGLE]; }
+  get pinchStrength() { return this._f[F.PINCH]; }
+  get grabStrength()  { return this._f[F.GRAB]; }
+  // index tip in active-display pixels when the middleware holds its calibration, else null
+  get screenPoint()   { return this._u[U.SCREEN_OK] ? this.screen : null; }
+  // first frames since the hand entered (middleware KinLife); undefined when not sent
+  get isNew()         { const v = this._u[U.NEW]; return v === 2 ? undefined : v === 1; }
+  get confidence()    { return this._f[F.CONF]; }
+
+  // methods, like LeapJS hands
+  roll()  { return this._f[F.ROLL]; }
+  pitch() { return this._f[F.PITCH]; }
+  yaw()   { return this._f[F.YAW]; }
+
+  // raw: one hand of the middleware JSON record
+  fill(raw) {
+    const f = this._f, u = this._u;
+    this.id = raw.id;
+    u[U.TYPE] = raw.type === 'left' ? 0 : 1;
+
+    const palm = raw.palmPosition;
+    vec(f, F.PALM, palm, 0, 0, 0);
+    vec(f, F.VEL, raw.palmVel, 0, 0, 0);
+    if (raw.palmStab) vec(f, F.STAB, raw.palmStab, 0, 0, 0); else vec(f, F.STAB, palm, 0, 0, 0);
+    const q = raw.palmQuat;
+    if (q && q.length >= 4) { f[F.QUAT] = q[0]; f[F.QUAT + 1] = q[1]; f[F.QUAT + 2] = q[2]; f[F.QUAT + 3] = q[3]; }
+    else { f[F.QUAT] = 0; f[F.QUAT + 1] = 0; f[F.QUAT + 2] = 0; f[F.QUAT + 3] = 1; }
+
+    // derived in C by current middleware; older builds only send palmQuat
+    if (typeof raw.roll === 'number' && raw.palmNormal && raw.palmDir) {
+      f[F.ROLL] = raw.roll; f[F.PITCH] = raw.pitch; f[F.YAW] = raw.yaw;
+      vec(f, F.NORMAL, raw.palmNormal, 0, -1, 0);
+      vec(f, F.DIR, raw.palmDir, 0, 0, -1);
+    } else {
+      orientFromQuat(f, 0);
+    }
+    vec(f, F.ANGVEL, raw.angVel, 0, 0, 0);
+
+    f[F.PINCH_DIST] = typeof raw.pinchDistance === 'number' ? raw.pinchDistance : 0;
+    f[F.GRAB_ANGLE] = typeof raw.grabAngle === 'number' ? raw.grabAngle : 0;
+    f[F.PINCH]      = typeof raw.pinch === 'number' ? raw.pinch : 0;
+    f[F.GRAB]       = typeof raw.grab === 'number' ? raw.grab : 0;
+    f[F.CONF]       = typeof raw.confidence === 'number' ? raw.confidence : 1;
+    u[U.NEW]        = raw.isNew === undefined ? 2 : raw.isNew ? 1 : 0;
+
+    const tips = raw.fingers, ext = raw.fingerExtended;
+    for (let i = 0; i < 5; i++) {
+      const name = FINGER_NAMES[i];
+      const tip = tips && tips[name];
+      // missing tip falls back to the palm, as the legacy mapper did
+      if (tip && tip.length >= 3) vec(f, F.TIPS + i * 3, tip, 0, 0, 0);
+      else { f[F.TIPS + i * 3] = f[F.PALM]; f[F.TIPS + i * 3 + 1] = f[F.PALM + 1]; f[F.TIPS + i * 3 + 2] = f[F.PALM + 2]; }
+      u[U.EXT + i] = ext && ext[name] ? 1 : 0;
+    }
+
+    // normalized once here: by the middleware's box when it sent them, else by ours
+    const tn = raw.tipsNorm;
+    if (raw.palmNorm && tn && tn.length === 5) {
+      vec(f, F.NORM_STAB, raw.palmNorm, 0.5, 0.5, 0.5);
+      for (let i = 0; i < 5; i++) vec(f, F.NORM_TIPS + i * 3, tn[i], 0.5, 0.5, 0.5);
+    } else {
+      normalizeAll(f, 0, this._box);
+    }
+    const sp = raw.screen;
+    if (sp && sp.length >= 2) { f[F.SCREEN] = sp[0]; f[F.SCREEN + 1] = sp[1]; u[U.SCREEN_OK] = 1; }
+    else u[U.SCREEN_OK] = 0;
+    return this;
+  }
+}
+
+function vec(f, at, src, x, y, z) {
+  if (src && src.length >= 3) { f[at] = src[0]; f[at + 1] = src[1]; f[at + 2] = src[2]; }
+  else { f[at] = x; f[at + 1] = y; f[at + 2] = z; }
+}
+
+// Palm normal (-Y) and direction (-Z) rotated by the hand quaternion, then LeapJS's
+// roll/pitch/yaw; mirrors kinematics.c for middleware builds that don't send them.
+function orientFromQuat(f, at) {
+  const x = f[at + F.QUAT], y = f[at + F.QUAT + 1], z = f[at + F.QUAT + 2], w = f[at + F.QUAT + 3];
+  const nx = -2 * (x * y - w * z), ny = -(1 - 2 * (x * x + z * z)), nz = -2 * (y * z + w * x);
+  const dx = -2 * (x * z + w * y), dy = -2 * (y * z - w * x), dz = -(1 - 2 * (x * x + y * y));
+  f[at + F.NORMAL] = nx; f[at + F.NORMAL + 1] = ny; f[at + F.NORMAL + 2] = nz;
+  f[at + F.DIR] = dx; f[at + F.DIR + 1] = dy; f[at + F.DIR + 2] = dz;
+  f[at + F.ROLL] = Math.atan2(nx, -ny);
+  f[at + F.PITCH] = Math.atan2(dy, -dz);
+  f[at + F.YAW] = Math.atan2(dx, -dz);
+}
+
+// Stabilized palm + tips of the hand record at `at` through box (unclamped, like LeapJS)
+function normalizeAll(f, at, box) {
+  if (!box?.normalizeInto) return;
+  box.normalizeInto(f, at + F.NORM_STAB, f[at + F.STAB], f[at + F.STAB + 1], f[at + F.STAB + 2]);
+  for (let i = 0; i < 5; i++) {
+    const t = at + F.TIPS + i * 3;
+    box.normalizeInto(f, at + F.NORM_TIPS + i * 3, f[t], f[t + 1], f[t + 2]);
+  }
+}
+
+class FrameView {
+  constructor(maxHands, interactionBox) {
+    this.type = 'frame';
+    this.id = 0;
+    this.fps = undefined;
+    this.timestamp = 0;   // device time in us (LeapJS naming); 0 = unknown
+    this.interactionBox = interactionBox;
+    this.displayId = 0;   // display the hands' screenPoint refers to (0 = none)
+    this.heartbeat = false; // idle heartbeat: the middleware skipped the frames before it
+    this._f32 = new Float32Array(maxHands * F.SIZE);
+    this._u8  = new Uint8Array(maxHands * U.SIZE);
+    this._views = Array.from({ length: maxHands }, (_, h) =>
+      new HandView(this._f32.subarray(h * F.SIZE, (h + 1) * F.SIZE), this._u8.subarray(h * U.SIZE, (h + 1) * U.SIZE), interactionBox));
+    // one fixed hands array per hand count, so switching counts never reallocates
+    this._byCount = Array.from({ length: maxHands + 1 }, (_, n) => this._views.slice(0, n));
+    this.hands = this._byCount[0];
+    this._refs = 0;
+  }
+
+  // Held by a consumer (e.g. the engine's frame scheduler): the pool won't refill it
+  retain() { this._refs++; }
+  release() { if (this._refs > 0) this._refs--; }
+}
+
+// Ring of frames: a slot is reused only after `slots` newer frames, and never while a
+// consumer has retained it (unless every slot is retained).
+// Without a box of its own the pool normalizes against the default bounds.
+function createFramePool({ slots = 4, maxHands = 2, interactionBox = createInteractionBox() } = {}) {
+  const frames = Array.from({ length: slots }, () => new FrameView(maxHands, interactionBox));
+  let next = 0;
+
+  // msg: parsed middleware record { frameId, ts, framerate, ibox, displayId, heartbeat?, hands:[...] }
+  function fill(msg) {
+    let frame = frames[next];
+    for (let i = 0; i < slots && frame._refs > 0; i++) {
+      next = (next + 1) % slots;
+      frame = frames[next];
+    }
+    next = (next + 1) % slots;
+
+    const raw = Array.isArray(msg.hands) ? msg.hands : null;
+    const n = raw ? Math.min(raw.length, maxHands) : 0;
+    frame.id = msg.frameId;
+    frame.fps = typeof msg.framerate === 'number' ? msg.framerate : undefined;
+    frame.timestamp = typeof msg.ts === 'number' ? msg.ts : 0;
+    frame.displayId = msg.displayId || 0;
+    frame.heartbeat = msg.heartbeat === true;
+    // the box the middleware normalized with (auto-fit moves it); keeps our fallback in step
+    if (msg.ibox) interactionBox?.setBounds?.(msg.ibox);
+    for (let h = 0; h < n; h++) frame._views[h].fill(raw[h]);
+    frame.hands = frame._byCount[n];
+    return frame;
+  }
+
+  return { fill };
+}
+
+module.exports = { createFramePool, createInteractionBox, orientFromQuat, normalizeAll, FrameView, FINGER_NAMES, FRAME_LAYOUT: { F, U } };
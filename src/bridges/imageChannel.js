@@ -0,0 +1,61 @@
+// src/bridges/imageChannel.js
+// Reader for the middleware's IR image pool (cMiddleware/images.h). The socket only
+// carries {"type":"image", slot, seq, ...} notifications; pixels are read straight from
+// the file-backed pool into one reused buffer, under the slot's sequence lock: a slot
+// the middleware rewrote while we copied it is reported as torn and skipped.
+
+const fs = require('fs');
+
+const DEFAULT_PATH = '/tmp/ultraleap_images.shm';
+const HDR = 64;       // file header and per-slot header size
+const MAGIC = 'ULMIMG01';
+
+function createImageReader({ path = DEFAULT_PATH } = {}) {
+  let fd = null, slotBytes = 0, slots = 0, pixels = null;
+  const hdr = Buffer.alloc(HDR);
+  const stats = { images: 0, torn: 0, missing: 0 };
+  const image = { type: 'image', id: 0, ts: 0, width: 0, height: 0, count: 0, bpp: 1, pixels: null };
+
+  function open() {
+    if (fd !== null) return true;
+    try { fd = fs.openSync(path, 'r'); } catch { stats.missing++; return false; }
+    fs.readSync(fd, hdr, 0, HDR, 0);
+    if (hdr.toString('latin1', 0, 8) !== MAGIC) { close(); stats.missing++; return false; }
+    slots = hdr.readUInt32LE(8);
+    slotBytes = hdr.readUInt32LE(12);
+    pixels = Buffer.allocUnsafeSlow(hdr.readUInt32LE(16));
+    return true;
+  }
+
+  function close() {
+    if (fd !== null) { try { fs.closeSync(fd); } catch {} }
+    fd = null;
+  }
+
+  const seqAt = (at) => { fs.readSync(fd, hdr, 0, HDR, at); return hdr.readUInt32LE(0); };
+
+  // msg: parsed notification. Returns the shared image object (valid until the next
+  // read) or null when the slot is gone, torn or the pool isn't there.
+  function read(msg) {
+    if (!open() || msg.slot >= slots) return null;
+    const at = HDR + msg.slot * slotBytes;
+    const seq = seqAt(at);
+    if (seq !== msg.seq) { stats.torn++; return null; }   // already overwritten / in progress
+    const bytes = hdr.readUInt32LE(20);
+    if (bytes > pixels.length) return null;
+    const w = hdr.readUInt32LE(4), h = hdr.readUInt32LE(8), count = hdr.readUInt32LE(12), bpp = hdr.readUInt32LE(16);
+    fs.readSync(fd, pixels, 0, bytes, at + HDR);
+    if (seqAt(at) !== seq) { stats.torn++; return null; }
+
+    stats.images++;
+    image.id = msg.frameId;
+    image.ts = msg.ts;
+    image.width = w; image.height = h; image.count = count; image.bpp = bpp;
+    image.pixels = pixels.subarray(0, bytes);  // count images of w*h*bpp, stacked
+    return image;
+  }
+
+  return { read, close, stats };
+}
+
+module.exports = { createImageReader, DEFAULT_IMAGE_PATH: DEFAULT_PATH };
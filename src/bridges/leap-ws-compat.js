@@ -1,6 +1,7 @@
 // src/bridges/leap-ws-compat.js
 const { EventEmitter } = require('events');
 const WebSocket = require('ws');
+const { createInteractionBox, DEFAULT_BOUNDS } = require('../core/interactionBox');
 
 class LeapWSCompat extends EventEmitter {
   constructor({ url, protocols, timeoutMs = 3000 }) {
@@ -10,6 +11,7 @@ class LeapWSCompat extends EventEmitter {
     this.timeoutMs = timeoutMs;
     this.ws = null;
     this._ka = null;
+    this._iBox = createInteractionBox(DEFAULT_BOUNDS, { acceptUnit: true });
   }
 
   _blastVersions() {
@@ -47,20 +49,10 @@ class LeapWSCompat extends EventEmitter {
       else if (Array.isArray(msg?.hands)) frame = msg;
       if (!frame) return;
 
-      const iBox = frame.interactionBox && typeof frame.interactionBox.normalizePoint === 'function'
-        ? frame.interactionBox
-        : { normalizePoint: (pt, clamp = true) => {
-            const x = Array.isArray(pt) ? pt[0] : (pt?.x ?? 0);
-            const y = Array.isArray(pt) ? pt[1] : (pt?.y ?? 0);
-            const z = Array.isArray(pt) ? pt[2] : (pt?.z ?? 0);
-            const looksUnit = Math.abs(x) <= 1.2 && Math.abs(y) <= 1.2 && Math.abs(z) <= 1.2;
-            let nx = looksUnit ? x : (x + 120) / 240;
-            let ny = looksUnit ? y : (y + 120) / 240;
-            let nz = looksUnit ? z : (z + 120) / 240;
-            if (clamp) { nx=Math.max(0,Math.min(1,nx)); ny=Math.max(0,Math.min(1,ny)); nz=Math.max(0,Math.min(1,nz)); }
-            return [nx,ny,nz];
-          } };
-      frame.interactionBox = iBox;
+      // the service's own box when it sends one, else the shared default (interactionBox.js)
+      if (!(frame.interactionBox && typeof frame.interactionBox.normalizePoint === 'function')) {
+        frame.interactionBox = this._iBox;
+      }
 
       if (Array.isArray(frame.hands)) {
         for (const h of frame.hands) {
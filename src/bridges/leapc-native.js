@@ -0,0 +1,98 @@
+// src/bridges/leapc-native.js
+// In-process LeapC: the N-API addon (cMiddleware/addon/leap_addon.c) polls LeapC on its
+// own thread and writes packed binary frame records (frame_schema.h) into slots of one
+// preallocated ArrayBuffer; a threadsafe function names the newest slot, which is decoded
+// (frameSchema.js) straight into the pooled frames (frameView.js). No middleware process,
+// no socket, no reconnect loop. Exposes the same surface as leapc-tcp.js; skeleton, image
+// and recognizer streams stay with the TCP middleware.
+
+const path = require('path');
+const { EventEmitter } = require('events');
+const { createFramePool } = require('./frameView');
+const { createInteractionBox, DEFAULT_BOUNDS } = require('../core/interactionBox');
+const { decodeBinary } = require('./frameSchema');
+
+const DEFAULT_ADDON = path.join(__dirname, '../../cMiddleware/build/leap_addon.node');
+
+function loadAddon(addonPath) {
+  return require(addonPath || process.env.LEAPC_ADDON || DEFAULT_ADDON);
+}
+
+function createLeapCNative({
+  mmBounds = DEFAULT_BOUNDS,
+  maxHands = 2,
+  // 'auto' or [x0, x1, y0, y1, z0, z1] (mm)
+  ibox = undefined,
+  // hand fields to extract, e.g. 'id,type,palmNorm,tipsNorm,pinch' (default all)
+  fields = undefined,
+  // heartbeat-only frames after this long with no hand (0 = off; pipeline.h idleMs)
+  idleMs = 0,
+  addonPath = undefined,
+  // injected for tests; otherwise the compiled addon
+  addon = loadAddon(addonPath),
+} = {}) {
+  const bus = new EventEmitter();
+  const iBox = createInteractionBox(mmBounds);
+  const pool = createFramePool({ maxHands, interactionBox: iBox });
+  const stats = { records: 0, coalesced: 0 };
+  let closed = false;
+
+  const control = (line) => {
+    const reply = addon.control(line);
+    if (!reply) return;
+    let msg;
+    try { msg = JSON.parse(reply); } catch { return; }
+    if (msg.type === 'ack' && Array.isArray(msg.ibox)) iBox.setBounds(msg.ibox);
+    if (msg.type === 'error') bus.emit('error', new Error(`[leapc] ${msg.error || 'control command rejected'}`));
+  };
+  const num = (v) => (Number.isFinite(+v) ? String(+v) : '0');
+
+  function setInteractionBox(b) {
+    if (b === 'auto' || b === 'reset') return control(`ibox ${b}`);
+    const a = Array.isArray(b) ? b : [...b.x, ...b.y, ...b.z];
+    return control(`ibox ${a.map(num).join(' ')}`);
+  }
+
+  let shared = null;
+  function onFrame(slot, length, coalesced) {
+    if (closed) return;
+    // the addon never rewrites this slot until the callback returns
+    const rec = decodeBinary(new Uint8Array(shared.buffer, slot * shared.slotSize, length));
+    stats.records++;
+    stats.coalesced = coalesced;
+    bus.emit('frame', pool.fill(rec));
+  }
+
+  shared = addon.start({ fields: fields || undefined, idleMs: idleMs || undefined }, onFrame);
+  if (ibox) setInteractionBox(ibox);
+  // no socket to wait for: 'connect' on the next tick, once listeners are attached
+  setImmediate(() => { if (!closed) bus.emit('connect'); });
+
+  return {
+    on(...args) { bus.on(...args); return this; },
+    // { records, coalesced }: coalesced counts records replaced before JS got to them
+    stats: () => ({ ...stats }),
+    imageStats: () => null,
+    subscribe() {},
+    unsubscribe() {},
+    setInteractionBox,
+    calibrate(displayId, { w, h, rect }) {
+      const r = rect || { x0: 0, x1: 1, y0: 0, y1: 1 };
+      control(`calibrate ${displayId >>> 0} ${[w, h, r.x0, r.x1, r.y0, r.y1].map(num).join(' ')}`);
+    },
+    selectDisplay(displayId) { control(`display ${displayId >>> 0}`); },
+    requestStats() {
+      try { bus.emit('stats', JSON.parse(addon.stats())); } catch {}
+    },
+    reportFocus() {},
+    setBackground() {},
+    disconnect() {
+      if (closed) return;
+      closed = true;
+      addon.stop();
+      bus.emit('disconnect');
+    },
+  };
+}
+
+module.exports = { createLeapCNative, loadAddon };
@@ -1,130 +1,173 @@
 // src/bridges/leapc-tcp.js
 // Reads newline-delimited JSON frames from the C middleware and maps to a LeapJS-ish frame.
+// Also relays recognizer matches ({type:"gesture"}) as 'gesture' events.
+// Framing is incremental over Buffers (lineFramer.js); with latestWins a burst of
+// queued frames collapses to the newest one.
+// With skeleton: true the bridge subscribes to the middleware's full-skeleton stream
+// and emits decoded records (skeleton.js) as 'skeleton' events; with images: true it
+// subscribes to IR image notifications and emits images read from the shared pool.
+// The interaction box and screen calibration live in the middleware: setInteractionBox(),
+// calibrate() and selectDisplay() send control lines, replayed after every reconnect.
+// encoding: 'binary' | 'delta' swaps the JSON frame stream for the packed records
+// generated from cMiddleware/frame_schema.h (decoded by frameSchema.js into the same shape).
 
 const net = require('net');
 const { EventEmitter } = require('events');
+const { createFramePool } = require('./frameView');
+const { createInteractionBox, DEFAULT_BOUNDS } = require('../core/interactionBox');
+const { createLineFramer } = require('./lineFramer');
+const { createSkeletonDecoder } = require('./skeleton');
+const { createImageReader } = require('./imageChannel');
+const { createDeltaDecoder, decodeRecord } = require('./frameSchema');
+
+const ENCODINGS = { json: 'frames', binary: 'binary', delta: 'delta' };
 
 function createLeapCBridge({
   host = '127.0.0.1',
   port = 8000,
-  // Rough desktop bounds to normalize InteractionBox mapping
-  mmBounds = { x: [-120, 120], y: [0, 300], z: [-120, 120] },
+  // Starting box; the middleware's own (--ibox / auto-fit) replaces it with every frame
+  mmBounds = DEFAULT_BOUNDS,
+  // LeapC tracks at most two hands per device
+  maxHands = 2,
+  // Skip stale frames when several arrive in one read (a cursor only needs the newest)
+  latestWins = false,
+  // Opt into the full bone chain stream (~10x the frame payload)
+  skeleton = false,
+  // IR images (middleware started with --images); pixels come from the pool file
+  images = false,
+  imagePath = undefined,
+  // 'auto' or [x0, x1, y0, y1, z0, z1] (mm); unset keeps the middleware's --ibox
+  ibox = undefined,
+  // frame stream: 'json' (default), 'binary' (~half the bytes) or 'delta' (changed fields only)
+  encoding = 'json',
 } = {}) {
   const bus = new EventEmitter();
-  let sock = null, buf = '';
-
-  const iBox = {
-    normalizePoint(pt, clamp = true) {
-      const x = Array.isArray(pt) ? pt[0] : (pt?.x ?? 0);
-      const y = Array.isArray(pt) ? pt[1] : (pt?.y ?? 0);
-      const z = Array.isArray(pt) ? pt[2] : (pt?.z ?? 0);
-      const nx = (x - mmBounds.x[0]) / (mmBounds.x[1] - mmBounds.x[0]);
-      const ny = (y - mmBounds.y[0]) / (mmBounds.y[1] - mmBounds.y[0]);
-      const nz = (z - mmBounds.z[0]) / (mmBounds.z[1] - mmBounds.z[0]);
-      const clip = v => (clamp ? Math.max(0, Math.min(1, v)) : v);
-      return [clip(nx), clip(ny), clip(nz)];
-    },
-  };
-
-  function mapHand(raw) {
-    // raw:
-    // { id, type:"left"|"right", palmPosition:[x,y,z],
-    //   grab, pinch, pinchDistance, grabAngle,
-    //   palmStab:[x,y,z], palmVel:[x,y,z], palmQuat:[x,y,z,w],
-    //   fingers:{ thumb:[x,y,z], ... }, fingerExtended:{ thumb:true, ... } }
-
-    const order = ['thumb', 'index', 'middle', 'ring', 'pinky'];
-    const mkTip = (name) => {
-      const tip = raw.fingers?.[name];
-      if (Array.isArray(tip) && tip.length >= 3) return [tip[0], tip[1], tip[2]];
-      const p = raw.palmPosition || [0, 0, 0];
-      return [p[0], p[1], p[2]];
-    };
-    const mkExt = (name) => (raw.fingerExtended && Object.prototype.hasOwnProperty.call(raw.fingerExtended, name))
-      ? !!raw.fingerExtended[name] : false;
-
-    const fingers = order.map((name) => ({
-      type: name === 'thumb' ? 0 :
-            name === 'index' ? 1 :
-            name === 'middle' ? 2 :
-            name === 'ring' ? 3 : 4,
-      stabilizedTipPosition: mkTip(name),
-      extended: mkExt(name),
-    }));
-
-    // Provide indexFinger shortcut used by engine
-    const indexTip = mkTip('index');
-
-    return {
-      id: raw.id,
-      type: raw.type === 'left' ? 0 : 1,
-      palmPosition: raw.palmPosition || [0, 0, 0],
-
-      // New goodies (optional; engine can adopt gradually)
-      palmVelocity:   raw.palmVel   || [0, 0, 0],
-      palmStabilized: raw.palmStab  || raw.palmPosition || [0, 0, 0],
-      palmQuaternion: raw.palmQuat  || [0, 0, 0, 1],
-      pinchDistance:  typeof raw.pinchDistance === 'number' ? raw.pinchDistance : 0,
-      grabAngle:      typeof raw.grabAngle     === 'number' ? raw.grabAngle     : 0,
-
-      pinchStrength:  typeof raw.pinch === 'number' ? raw.pinch : 0,
-      grabStrength:   typeof raw.grab  === 'number' ? raw.grab  : 0,
-
-      indexFinger: { stabilizedTipPosition: indexTip },
-      fingers,
-    };
+  let sock = null, closed = false;
+  const frameStream = ENCODINGS[encoding] || 'frames';
+  const streams = new Set([
+    ...(frameStream !== 'frames' ? [frameStream] : []),
+    ...(skeleton ? ['skeleton'] : []), ...(images ? ['images'] : []),
+  ]);
+  const delta = createDeltaDecoder();
+  const skel = createSkeletonDecoder();
+  const imgs = images ? createImageReader({ path: imagePath }) : null;
+  // last control state per key ('ibox', 'calibrate <id>', 'display'), replayed on connect
+  const control = new Map();
+
+  const iBox = createInteractionBox(mmBounds);
+
+  // Hands/fingers/vectors are pooled typed-array views (see frameView.js); the legacy
+  // shape (hand.fingers[i].extended, stabilizedTipPosition, palmVelocity, ...) is kept.
+  const pool = createFramePool({ maxHands, interactionBox: iBox });
+
+  function onRecord(buf, start, end) {
+    let msg;
+    try { msg = JSON.parse(buf.toString('utf8', start, end)); } catch { return; }
+
+    // Template matches from the middleware recognizer (--gestures <dir>)
+    if (msg.type === 'gesture') {
+      bus.emit('gesture', { label: msg.label, confidence: msg.confidence, frameId: msg.frameId });
+      return;
+    }
+    if (msg.type === 'skeleton') {
+      const s = skel.decode(msg);
+      if (s) bus.emit('skeleton', s);
+      return;
+    }
+    if (msg.type === 'image') {
+      const img = imgs?.read(msg);
+      if (img) bus.emit('image', img);
+      return;
+    }
+    if (msg.type === 'ack') {
+      // control replies carry the middleware's current box; frames do too, this just
+      // makes the change visible before the next one
+      if (Array.isArray(msg.ibox)) iBox.setBounds(msg.ibox);
+      return;
+    }
+    if (msg.type === 'stats') { bus.emit('stats', msg); return; } // reply to requestStats()
+    if (msg.type === 'error') {
+      bus.emit('error', new Error(`[leapc] ${msg.error || 'control command rejected'}`));
+      return;
+    }
+
+    let rec = msg;
+    if (msg.type === 'frameBin') {
+      rec = decodeRecord(msg, delta);
+      if (!rec) return;
+    }
+    const frame = pool.fill(rec);
+
+    // Uncomment to inspect the first mapped hand:
+    // if (!createLeapCBridge._dbg && frame.hands.length) {
+    //   createLeapCBridge._dbg = true;
+    //   console.log('[leapc-tcp] sample hand:', frame.hands[0]);
+    // }
+
+    bus.emit('frame', frame);
   }
 
+  // latest-wins only ever skips frame records; skeleton records arrive in order
+  const framer = createLineFramer({ onRecord, latestWins });
+
+  const command = (line) => { if (sock && !sock.connecting && !sock.destroyed) sock.write(line + '\n'); };
+
   function connect() {
     sock = net.createConnection({ host, port }, () => {
+      // subscriptions are per connection: replay them after every reconnect
+      if (streams.size) command(`subscribe ${[...streams].join(',')}`);
+      if (frameStream !== 'frames') command('unsubscribe frames');
+      for (const line of control.values()) command(line);
       bus.emit('connect');
     });
 
-    sock.on('data', (data) => {
-      buf += data.toString('utf8');
-      const parts = buf.split('\n');
-      buf = parts.pop(); // keep remainder
-
-      for (const line of parts) {
-        if (!line) continue;
-        let msg;
-        try { msg = JSON.parse(line); } catch { continue; }
-
-        const hands = Array.isArray(msg.hands) ? msg.hands.map(mapHand) : [];
-        const frame = {
-          type: 'frame',
-          id: msg.frameId,
-          hands,
-          interactionBox: iBox,
-          // fps is optional; engine can read it if desired
-          fps: typeof msg.framerate === 'number' ? msg.framerate : undefined,
-        };
-
-        // Uncomment to inspect the first mapped hand:
-        // if (!createLeapCBridge._dbg && hands.length) {
-        //   createLeapCBridge._dbg = true;
-        //   console.log('[leapc-tcp] sample hand:', JSON.stringify(hands[0], null, 2));
-        // }
-
-        bus.emit('frame', frame);
-      }
-    });
+    framer.reset();
+    delta.reset();   // the middleware starts each new delta subscriber from a keyframe
+    sock.on('data', (data) => framer.push(data));
 
     sock.on('close', () => {
       bus.emit('disconnect');
-      setTimeout(connect, 500);
+      if (!closed) setTimeout(connect, 500);
     });
 
     sock.on('error', (e) => bus.emit('error', e));
   }
 
+  const setControl = (key, line) => { control.set(key, line); command(line); };
+  const num = (v) => (Number.isFinite(+v) ? String(+v) : '0');
+
+  function setInteractionBox(b) {
+    if (b === 'auto' || b === 'reset') return setControl('ibox', `ibox ${b}`);
+    const a = Array.isArray(b) ? b : [...b.x, ...b.y, ...b.z];
+    setControl('ibox', `ibox ${a.map(num).join(' ')}`);
+  }
+
+  if (ibox) setInteractionBox(ibox);
   connect();
 
   return {
     on: (...args) => { bus.on(...args); return this; },
+    // { records, dropped, overflows } from the line framer
+    stats: () => ({ ...framer.stats }),
+    imageStats: () => (imgs ? { ...imgs.stats } : null),
+    // middleware streams beyond frames ('skeleton', 'images')
+    subscribe(name) { streams.add(name); command(`subscribe ${name}`); },
+    unsubscribe(name) { streams.delete(name); command(`unsubscribe ${name}`); },
+    // interaction box: 'auto' | 'reset' | [x0,x1,y0,y1,z0,z1] | { x, y, z }
+    setInteractionBox,
+    // screen calibration for one display: normalized rect {x0,x1,y0,y1} -> w x h pixels
+    calibrate(displayId, { w, h, rect }) {
+      const r = rect || { x0: 0, x1: 1, y0: 0, y1: 1 };
+      setControl(`calibrate ${displayId}`,
+        `calibrate ${displayId >>> 0} ${[w, h, r.x0, r.x1, r.y0, r.y1].map(num).join(' ')}`);
+    },
+    // which calibrated display the middleware projects "screen" points onto
+    selectDisplay(displayId) { setControl('display', `display ${displayId >>> 0}`); },
+    // middleware metrics snapshot, answered with a 'stats' event
+    requestStats() { command('stats'); },
     reportFocus() {},
     setBackground() {},
-    disconnect() { try { sock?.destroy(); } catch {} },
+    disconnect() { closed = true; try { sock?.destroy(); } catch {} imgs?.close(); },
   };
 }
 
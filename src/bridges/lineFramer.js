@@ -0,0 +1,112 @@
+// src/bridges/lineFramer.js
+// Incremental newline framing over Buffer chunks (NDJSON from the C middleware).
+// Each chunk is scanned once for '\n' offsets and complete records are handed out as
+// (buf, start, end) ranges into the chunk itself; only a record split across chunks is
+// ever copied. Cost is linear in bytes received, however large a burst gets.
+//
+// latestWins: when one chunk carries several complete frame records (the consumer fell
+// behind and the socket coalesced them), only the newest frame is delivered; stale ones
+// are counted and skipped without being decoded. Non-frame records (e.g. gesture
+// matches) are always delivered, in order.
+
+const NL = 0x0a;
+const FRAME_PREFIX = Buffer.from('{"frameId"');
+
+function isFrameRecord(buf, start, end) {
+  const n = FRAME_PREFIX.length;
+  return end - start >= n && FRAME_PREFIX.compare(buf, start, start + n) === 0;
+}
+
+function createLineFramer({
+  onRecord,                      // (buf, start, end) => void; valid only during the call
+  latestWins = false,
+  isDroppable = isFrameRecord,   // which records latest-wins may skip
+  maxRecordBytes = 1 << 20,      // a partial record larger than this is discarded
+} = {}) {
+  const stats = { records: 0, dropped: 0, overflows: 0 };
+  let tail = [];                 // chunks of the record still waiting for its '\n'
+  let tailLen = 0;
+  let skipping = false;          // dropping an oversized record up to its '\n'
+
+  function emit(buf, start, end) {
+    if (end > start && buf[end - 1] === 0x0d) end--; // tolerate CRLF
+    if (end <= start) return;
+    stats.records++;
+    onRecord(buf, start, end);
+  }
+
+  function push(chunk) {
+    let pos = 0;
+    if (tailLen || skipping) {
+      const nl = chunk.indexOf(NL, 0);
+      if (nl === -1) { keep(chunk, 0); return; }
+      pos = nl + 1;
+      if (skipping) skipping = false;
+      else {
+        // finish the record carried over from earlier chunks (the only copy we make)
+        tail.push(chunk.subarray(0, nl));
+        const joined = Buffer.concat(tail, tailLen + nl);
+        tail = []; tailLen = 0;
+        if (latestWins && isDroppable(joined, 0, joined.length) && hasDroppable(chunk, pos)) stats.dropped++;
+        else emit(joined, 0, joined.length);
+      }
+    }
+    deliverFrom(chunk, pos);
+  }
+
+  // Delivers every complete record of chunk[from..], keeps the partial remainder.
+  function deliverFrom(chunk, from) {
+    let pos = from;
+    if (!latestWins) {
+      for (let nl = chunk.indexOf(NL, pos); nl !== -1; nl = chunk.indexOf(NL, pos)) {
+        emit(chunk, pos, nl);
+        pos = nl + 1;
+      }
+      keep(chunk, pos);
+      return;
+    }
+
+    // latest-wins: find the start of the newest droppable record first (backwards from
+    // the last '\n'), then walk forward delivering everything else.
+    const lastNl = chunk.lastIndexOf(NL);
+    let newest = -1;
+    for (let end = lastNl; end >= pos;) {
+      const prev = end > pos ? chunk.lastIndexOf(NL, end - 1) : -1;
+      const start = prev >= pos ? prev + 1 : pos;
+      if (isDroppable(chunk, start, end)) { newest = start; break; }
+      end = prev;
+    }
+    for (let nl = chunk.indexOf(NL, pos); nl !== -1; nl = chunk.indexOf(NL, pos)) {
+      if (pos < newest && isDroppable(chunk, pos, nl)) stats.dropped++;
+      else emit(chunk, pos, nl);
+      pos = nl + 1;
+    }
+    keep(chunk, pos);
+  }
+
+  function hasDroppable(chunk, pos) {
+    for (let nl = chunk.indexOf(NL, pos); nl !== -1; nl = chunk.indexOf(NL, pos)) {
+      if (isDroppable(chunk, pos, nl)) return true;
+      pos = nl + 1;
+    }
+    return false;
+  }
+
+  function keep(chunk, from) {
+    if (skipping || from >= chunk.length) return;
+    if (tailLen + chunk.length - from > maxRecordBytes) {
+      stats.overflows++;
+      tail = []; tailLen = 0;
+      skipping = true;
+      return;
+    }
+    tail.push(chunk.subarray(from));
+    tailLen += chunk.length - from;
+  }
+
+  function reset() { tail = []; tailLen = 0; skipping = false; }
+
+  return { push, reset, stats };
+}
+
+module.exports = { createLineFramer, isFrameRecord };
@@ -0,0 +1,71 @@
+// src/bridges/skeleton.js
+// Decoder for the middleware's opt-in skeleton stream ("subscribe skeleton").
+// Each record carries every bone of every digit plus the arm as fixed-stride float32
+// (layout mirrors cMiddleware/skeleton.h; keep both in sync). The base64 payload is
+// decoded into one reused buffer and exposed through views created once per slot, so
+// like frameView.js a decoded frame is only valid until the next decode().
+
+const BONE = { PREV: 0, NEXT: 3, WIDTH: 6, ROT: 7, SIZE: 11 };
+const S = {
+  TYPE: 0,          // 0 = left, 1 = right
+  CONFIDENCE: 1,
+  PALM_WIDTH: 2,
+  EXTENDED: 3,      // bitmask, bit i = digit i
+  ARM: 4,
+  DIGITS: 4 + BONE.SIZE,
+  STRIDE: 4 + BONE.SIZE + 5 * 4 * BONE.SIZE,
+};
+const BONE_NAMES = ['metacarpal', 'proximal', 'intermediate', 'distal'];
+
+class BoneView {
+  constructor(f32) {
+    this._f = f32;
+    this.prevJoint = f32.subarray(BONE.PREV, BONE.PREV + 3);
+    this.nextJoint = f32.subarray(BONE.NEXT, BONE.NEXT + 3);
+    this.rotation  = f32.subarray(BONE.ROT, BONE.ROT + 4);   // xyzw
+  }
+  get width() { return this._f[BONE.WIDTH]; }
+}
+
+class SkeletonHand {
+  constructor(f32) {
+    this._f = f32;
+    this.id = 0;
+    this.arm = new BoneView(f32.subarray(S.ARM, S.ARM + BONE.SIZE));
+    // digits[d][b]: thumb..pinky x metacarpal..distal
+    this.digits = Array.from({ length: 5 }, (_, d) => BONE_NAMES.map((_, b) => {
+      const at = S.DIGITS + (d * 4 + b) * BONE.SIZE;
+      return new BoneView(f32.subarray(at, at + BONE.SIZE));
+    }));
+  }
+  get type()       { return this._f[S.TYPE]; }
+  get confidence() { return this._f[S.CONFIDENCE]; }
+  get palmWidth()  { return this._f[S.PALM_WIDTH]; }
+  extended(d)      { return ((this._f[S.EXTENDED] | 0) >> d & 1) === 1; }
+}
+
+function createSkeletonDecoder({ maxHands = 4 } = {}) {
+  // own ArrayBuffer at offset 0, so the Float32Array view is always aligned
+  const bytes = Buffer.allocUnsafeSlow(maxHands * S.STRIDE * 4);
+  const f32 = new Float32Array(bytes.buffer, bytes.byteOffset, maxHands * S.STRIDE);
+  const slots = Array.from({ length: maxHands }, (_, h) =>
+    new SkeletonHand(f32.subarray(h * S.STRIDE, (h + 1) * S.STRIDE)));
+  const byCount = Array.from({ length: maxHands + 1 }, (_, n) => slots.slice(0, n));
+  const frame = { type: 'skeleton', id: 0, ts: 0, hands: byCount[0] };
+
+  // msg: parsed {"type":"skeleton", frameId, ts, stride, ids, data}; null on a layout mismatch
+  function decode(msg) {
+    if (msg.stride !== S.STRIDE || typeof msg.data !== 'string') return null;
+    const written = bytes.write(msg.data, 0, 'base64');
+    const n = Math.min(Math.floor(written / (S.STRIDE * 4)), maxHands, msg.ids?.length ?? 0);
+    for (let h = 0; h < n; h++) slots[h].id = msg.ids[h];
+    frame.id = msg.frameId;
+    frame.ts = msg.ts;
+    frame.hands = byCount[n];
+    return frame;
+  }
+
+  return { decode };
+}
+
+module.exports = { createSkeletonDecoder, SKELETON_LAYOUT: { S, BONE }, BONE_NAMES };
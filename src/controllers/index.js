@@ -1,10 +1,39 @@
 // src/controllers/index.js
 const { createLeapCBridge } = require('../bridges/leapc-tcp');
+const { createLeapCNative } = require('../bridges/leapc-native');
 const { LeapWSCompat } = require('../bridges/leap-ws-compat');
 
+// LEAPC_IBOX=auto | x0,x1,y0,y1,z0,z1 (mm)
+function parseIBox(v) {
+  if (!v) return undefined;
+  if (v === 'auto') return 'auto';
+  const a = v.split(',').map(Number);
+  return a.length === 6 && a.every(Number.isFinite) ? a : undefined;
+}
+
+// USE_LEAPC_BRIDGE=1: middleware over TCP | native: in-process addon | unset: LeapJS WS
 function createController() {
+  if (process.env.USE_LEAPC_BRIDGE === 'native') {
+    return createLeapCNative({
+      ibox: parseIBox(process.env.LEAPC_IBOX),
+      fields: process.env.LEAPC_FIELDS || undefined,
+      idleMs: Number(process.env.LEAPC_IDLE_MS) || 0,
+      addonPath: process.env.LEAPC_ADDON || undefined,
+    });
+  }
   const useLeapC = process.env.USE_LEAPC_BRIDGE === '1';
-  if (useLeapC) return createLeapCBridge({ host: '127.0.0.1', port: 8000 });
+  if (useLeapC) {
+    return createLeapCBridge({
+      host: '127.0.0.1', port: 8000,
+      latestWins: process.env.LEAPC_LATEST_WINS === '1',
+      skeleton: process.env.LEAPC_SKELETON === '1',
+      images: process.env.LEAPC_IMAGES === '1',
+      imagePath: process.env.LEAPC_IMAGE_SHM || undefined,
+      ibox: parseIBox(process.env.LEAPC_IBOX),
+      // json | binary | delta (see cMiddleware/frame_schema.h)
+      encoding: process.env.LEAPC_ENCODING || 'json',
+    });
+  }
 
   // WS fallback (versioned endpoint first)
   const ctl = new LeapWSCompat({ url: 'ws://127.0.0.1:6437/v7.json' });
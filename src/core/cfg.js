@@ -18,6 +18,19 @@ module.exports = {
   zoomDistOff: 0.008,
   zoomDistToWheelScale: 300,
 
+  // Which hand drives the one-hand gestures when both are in view (src/core/hands.js):
+  // 'right' | 'left' (that hand whenever present) | 'first' (the one tracked longest)
+  primaryHand: 'right',
+  handSmoothing: 0.5,          // per-hand palm smoothing for two-hand gestures (0..1)
+  // Hand entry: while the primary hand is new (hand.isNew / its first frames) the cursor
+  // is set to where it points rather than smoothed from where the last hand left it.
+  // Entry frames below this tracking confidence leave the cursor alone.
+  entryMinConfidence: 0.2,
+
+  // Two-hand pinch (src/gestures/bimanual.js): zoom by hand spread, rotate by tilt
+  bimanualZoomScale: 200,      // wheel notches per unit of normalized spread change
+  bimanualRotateStepDeg: 20,   // one rotate chord per this many degrees
+
 
   // Dwell: cancel if palm velocity exceeds this (mm/s)
   minPalmVelForDwellCancel: 120,
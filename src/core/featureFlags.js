@@ -2,7 +2,8 @@
 const DEFAULTS = {
   cursor: true, pinchClick: true, drag: true, threeFingerDrag: true,
   scroll: true, osSwipes: true, windowMove: true, windowResize: true,
-  snapCycle: true, showDesktop: true, launchpad: true, dwellClick: true
+  snapCycle: true, showDesktop: true, launchpad: true, dwellClick: true,
+  bimanual: true
 };
 
 function ensureGestures(persisted) {
@@ -18,6 +19,7 @@ function attachFlagAPI(engine) {
       // keep base snapshot aligned so profile resets don't re-enable it
       if (engine._base?.persist?.gestures) engine._base.persist.gestures[name] = !!value;
       engine.onSave?.({ persist: engine.persist });
+      engine.syncSettings?.();
       engine._hudPatch?.({ settings: { gestures: engine.persist.gestures } });
     },
     listGestures: () => ({ ...engine.persist.gestures })
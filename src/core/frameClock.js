@@ -0,0 +1,39 @@
+// src/core/frameClock.js
+// Engine time taken from the tracking device. Frames carry the device timestamp
+// (`timestamp`, us: the LeapC middleware's `ts`, LeapJS frames), which advances by
+// exactly the time between samples however late or bunched up the frames arrive here.
+// Gesture timing (scroll velocity, dwell, swipe cooldowns, ...) reads ctx.now(), so it
+// is integrated over device time and comes out the same at 60, 90 or 120 Hz.
+//
+// The clock stays on the wall clock's timeline (values mix with Date.now()-based ones):
+// it is anchored to the wall clock at the first frame and re-anchored when the device
+// clock jumps (device restart, recording replay) or drifts more than maxSkewMs away.
+// Between frames it runs on with the wall clock; frames without a timestamp use it too.
+// Neither frame() nor now() ever returns less than the last value either handed out.
+
+function createFrameClock({ now = Date.now, maxSkewMs = 1000 } = {}) {
+  let anchorWall = 0, anchorDev = -1;   // wall ms <-> device us at the anchor
+  let cur = 0, curWall = 0;              // time of the latest frame, and when it came
+  let last = 0;                          // latest value handed out
+
+  return {
+    // Frame arrived: device timestamp (us, <= 0 / missing = unknown) -> engine ms
+    frame(ts) {
+      const w = now();
+      let t;
+      if (!(ts > 0)) {
+        t = Math.max(w, cur);
+      } else {
+        t = anchorDev >= 0 ? anchorWall + (ts - anchorDev) / 1000 : NaN;
+        if (!(t >= cur) || Math.abs(t - w) > maxSkewMs) { t = Math.max(w, cur, last); anchorWall = t; anchorDev = ts; }
+      }
+      cur = t; curWall = w;
+      // now() ran on wall time since the last frame; a frame that came late is held there
+      return (last = Math.max(t, last));
+    },
+    // Engine time: the latest frame's, plus wall time since it came
+    now() { return (last = Math.max(curWall ? cur + (now() - curWall) : now(), last)); },
+  };
+}
+
+module.exports = { createFrameClock };
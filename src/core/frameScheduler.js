@@ -0,0 +1,86 @@
+const { now } = require('./utils');
+
+// Latest-wins frame scheduler: runs at most one (async) frame handler at a time and,
+// when it finishes, continues with the newest frame that arrived meanwhile. Older
+// waiting frames are superseded ("coalesced"); frames that never reached the engine
+// (id gaps from the bridge/middleware) are counted as "dropped". Idle heartbeats
+// (frame.heartbeat) follow frames the middleware skipped on purpose: no gap is counted
+// into or out of them.
+//
+// Pooled frames (bridges/frameView.js) are retained while pending/in flight so the
+// bridge does not refill them under the handler.
+class FrameScheduler {
+  constructor(handler, { onError = (e) => console.error('Frame handler error:', e) } = {}) {
+    this.handler = handler;
+    this.onError = onError;
+    this.busy = false;
+    this.pending = null;
+    this.lastId = null;
+    this.arrivals = 0;   // frames received while the current handler runs
+    this.stats = { frames: 0, handled: 0, coalesced: 0, dropped: 0, depth: 0, maxDepth: 0, lastMs: 0, avgMs: 0, maxMs: 0 };
+  }
+
+  push(frame) {
+    const s = this.stats;
+    s.frames++;
+    const id = frame && frame.id;
+    if (frame && frame.heartbeat) this.lastId = null;
+    else {
+      if (typeof id === 'number' && typeof this.lastId === 'number' && id > this.lastId + 1) s.dropped += id - this.lastId - 1;
+      if (typeof id === 'number') this.lastId = id;
+    }
+
+    if (!this.busy) { this._running = this._run(frame); return; }
+    this.arrivals++;
+    if (this.pending) { s.coalesced++; release(this.pending); }
+    retain(frame);
+    this.pending = frame;
+  }
+
+  async _run(frame) {
+    this.busy = true;
+    retain(frame);
+    let f = frame;
+    while (f) {
+      this.arrivals = 0;
+      const t0 = now();
+      try { await this.handler(f); } catch (e) { this.onError(e); }
+      this._account(now() - t0);
+      release(f);
+
+      f = this.pending;       // already retained when queued
+      this.pending = null;
+    }
+    this.busy = false;
+  }
+
+  _account(ms) {
+    const s = this.stats;
+    s.handled++;
+    s.lastMs = ms;
+    s.avgMs = s.handled === 1 ? ms : s.avgMs * 0.9 + ms * 0.1;
+    if (ms > s.maxMs) s.maxMs = ms;
+    s.depth = this.arrivals;
+    if (this.arrivals > s.maxDepth) s.maxDepth = this.arrivals;
+  }
+
+  // Resolves once the handler has caught up with every pushed frame
+  idle() { return this.busy ? this._running : Promise.resolve(); }
+
+  // Compact HUD view
+  hud() {
+    const s = this.stats;
+    return { q: s.depth, qMax: s.maxDepth, dropped: s.dropped, coalesced: s.coalesced, ms: +s.avgMs.toFixed(1), maxMs: +s.maxMs.toFixed(1) };
+  }
+
+  reset() {
+    if (this.pending) release(this.pending);
+    this.pending = null;
+    this.lastId = null;
+  }
+}
+
+function retain(f) { if (f && f.retain) f.retain(); }
+function release(f) { if (f && f.release) f.release(); }
+
+module.exports = FrameScheduler;
@@ -0,0 +1,522 @@
+// src/core/gestureCore.js
+// Electron-free gesture engine: store, ctx, composed middleware and the per-frame
+// logic. GestureEngine (main process) extends it with display polling, the controller
+// and profile switching; the gesture worker (src/worker) runs it off the main thread
+// with a remote actuation surface.
+const path = require('path');
+const CFG = require('./cfg');
+const GCR = require('./gcr');
+const { now, avg, clamp01, lerp, OS } = require('./utils');
+const { createState } = require('./state');
+const { createBus } = require('./bus');
+const { compose } = require('./pipeline');
+const FrameScheduler = require('./frameScheduler');
+const { createFrameClock } = require('./frameClock');
+const { createHandTracker } = require('./hands');
+const { createProfiler } = require('./profiler');
+const { ensureGestures, attachFlagAPI } = require('./featureFlags');
+
+const gestureMW = require('../gestures');
+const functionMW = require('../functions');
+const { stepScrollInertia } = require('../gestures/scroll');
+
+class GestureCore {
+  constructor(opts) {
+    this.onHUD = opts.onHUD || (()=>{});
+    this.onCalState = opts.onCalState || (()=>{});
+    this.onSave = opts.onSave || (()=>{});
+
+    // Actuation surface: adapters/io on the main thread, worker/remoteIO in the gesture worker
+    this.io = opts.io;
+
+    // 0 = cursor smoothing on setImmediate (main thread); >0 = fixed tick in ms (worker)
+    this.animIntervalMs = opts.animIntervalMs || 0;
+
+    this.helperPath   = opts.helperPath || null;
+    this.userDataPath = opts.userDataPath || process.cwd();
+
+    const persisted = opts.persisted || {};
+    this.opts = {
+      threeFingerDrag: !!persisted.threeFingerDrag,
+      zoomWithCmdScrollOnPinch: !!persisted.zoomWithCmdScrollOnPinch,
+      windowMoveScale: persisted.windowMoveScale ?? 1.0,
+      windowResizeScale: persisted.windowResizeScale ?? 1.0,
+    };
+    this.persist = {
+      calibration: (persisted.calibration && persisted.calibration.rect) || { x0:0,y0:0,x1:1,y1:1 },
+      perDisplay: persisted.perDisplay || {},
+      clicks: persisted.clicks || { doublePinchMs: 350, enableMiddleTriple: true },
+      dwell: persisted.dwell || { enabled: true, ms: 650, radiusPx: 10, cooldownMs: 800 },
+      pointerGain: persisted.pointerGain || { enabled: true, gainMin:1.0, gainMax:2.2, velLow:200, velHigh:1000 },
+      scrollInertia: persisted.scrollInertia || { enabled: true, decay:0.90, minStep:1, burstScale:0.05 },
+      gestures: ensureGestures(persisted.gestures) // NEW
+    };
+    this._base = JSON.parse(JSON.stringify({ opts: this.opts, persist: this.persist }));
+
+    // Profiles (main) or a snapshot proxy (gesture worker); see gestureEngine.js / worker
+    this.profiles = opts.profiles;
+    this.frontBundleId = '';
+    this._lastTwoCenter = null;
+
+    this.store = createState({
+      displayId: null,
+      displayBounds: { x:0, y:0, w:0, h:0 },
+      screen: { w: 0, h: 0 },
+      pos: { x: 0, y: 0 }, target: { x: 0, y: 0 }, lastPt: { x: 0, y: 0 },
+      isPinching: false, pinchStartTs: 0, dragging: false,
+      threeDrag: false, lastSwipeTs: 0, fiveOpenStart: 0, lastFivePinchTs: 0,
+      windowMode: 'none', windowRefPt: null, lastWindowTick: 0,
+      resizeBaseline: { roll: 0, pitch: 0 },
+      cal: { active:false, step:'idle', A:null, B:null, rect: this.persist.calibration },
+      gcr: new GCR(),
+      tapCount: 0, lastTapTs: 0, tapTimer: null,
+      dwellAnchor: null, dwellStartTs: 0, dwellCooldownTs: 0,
+      inertia: { vx: 0, vy: 0, active: false },
+      lastPalmVel: 0,
+      lastSnapTapTs: 0, snapIndex: 0,
+      snapOrder: ["left","right","top","bottom","tl","tr","bl","br","third-left","third-center","third-right","center","max"],
+      rec: { enabled:false, stream:null, started:0, lastFile:null, replay:null },
+      trainer: { enabled:false, capturing:false, label:'', started:0, seg:[], lastSaved:null }
+    });
+
+    // device-timestamp clock: ctx.now() is the frame's time (frameClock.js)
+    this.clock = createFrameClock();
+    // per-hand slices by hand.id; picks the hand the one-hand gestures follow (hands.js)
+    this.hands = createHandTracker();
+
+    // opt-in handler/frame timing (profiler.js); LEAP_PROFILE=1 starts with it on
+    this.prof = createProfiler({
+      enabled: opts.profile ?? process.env.LEAP_PROFILE === '1',
+      onPanel: (p) => this.onHUD({ prof: p }),
+    });
+    this._animate = this.prof.wrap('animate', this._animate);
+
+    // shared ctx
+    this.ctx = {
+      CFG, now: () => this.clock.now(), avg, clamp01, lerp,
+      mouse: this.io.mouse, Button: this.io.Button, keyboard: this.io.keyboard, Key: this.io.Key,
+      screen: this.io.screen, Point: this.io.Point, keyChord: this.io.keyChord, OS,
+      _axMoveBy: (dx,dy)=>this.io.moveWindow?.(dx,dy),
+      _axResizeBy: (dw,dh)=>this.io.resizeWindow?.(dw,dh),
+      _axSnap: (which)=>this.io.snapWindow?.(which),
+      hands: this.hands,
+      state: this.store.get(), getState: this.store.get, setState: this.store.set, sel: this.store.sel,
+      opts: this.opts, persist: this.persist,
+      profiles: this.profiles,
+      onSave: this.onSave, onHUD: this.onHUD, onCalState: this.onCalState,
+      userDataPath: this.userDataPath, helperPath: this.helperPath,
+      bus: this.prof.bus(createBus()),
+      tutor: (m)=>this._tutor(m),
+      _hudPatch: (p)=>this._hudPatch(p),
+      _onReplayFrame: (f)=>this._onReplayFrame(f),
+      _mapToScreen: (nx,ny)=>{ const st = this.store.get(); const r = st.cal.rect, W = st.screen.w, H = st.screen.h;
+        const tx = Math.max(0, Math.min(1, (nx - r.x0) / (r.x1 - r.x0)));
+        const ty = Math.max(0, Math.min(1, (ny - r.y0) / (r.y1 - r.y0)));
+        return { x: tx * W, y: (1 - ty) * H }; }
+    };
+
+    // attach flags API into ctx
+    attachFlagAPI(this); // isOn / setGesture / listGestures
+
+    const run = compose(this.prof.middleware([ ...functionMW, ...gestureMW ]));
+    this.run = async (ctx) => { await run(ctx); this.prof.attach(ctx); };
+    this._kaTimer = null;
+
+    // one _onFrame at a time; frames arriving meanwhile collapse to the newest
+    const onFrame = this.prof.wrap('frame', (f) => this._onFrame(f));
+    this.frames = new FrameScheduler((f) => { this.prof.tick(); return onFrame(f); });
+  }
+
+  _tutor(label){ this.onHUD({ tutor: label }); }
+  _hudPatch(p){ this.onHUD(p); }
+
+  // Per-frame HUD line (+ scheduler queue depth / handler time); hands: tracked hand count
+  _emitHUD(ext, pinch, grab, pt, hands) {
+    const st = this.store.get();
+    this.onHUD({
+      hands, ext, pinch:+(pinch||0).toFixed(2), grab:+(grab||0).toFixed(2),
+      x: Math.round(pt.x), y: Math.round(pt.y),
+      windowMode: st.windowMode, dragging: st.dragging || st.threeDrag,
+      calStep: st.cal.step, displayId: st.displayId, gcr: st.gcr.current(),
+      profile: this.profiles.current(), sched: this.frames.hud()
+    });
+  }
+
+  // Active display geometry (polled by GestureEngine, forwarded to the worker)
+  // (each display keeps its own calibration rect; the global one is the fallback)
+  setDisplay({ id, bounds, w, h }) {
+    const st = this.store.get();
+    const rect = (id && this.persist.perDisplay?.[String(id)]?.rect) || this.persist.calibration;
+    this.store.set({ displayId: id, displayBounds: bounds, screen: { w, h }, cal: { ...st.cal, rect } });
+  }
+
+  // Settings mirrored from the main process (mutates in place: ctx holds these objects)
+  applySettings({ opts, persist, cfg } = {}) {
+    if (cfg) Object.assign(CFG, cfg);
+    if (opts) Object.assign(this.opts, opts);
+    if (persist) for (const k of Object.keys(persist)) {
+      const v = persist[k];
+      if (v && typeof v === 'object' && this.persist[k] && typeof this.persist[k] === 'object') Object.assign(this.persist[k], v);
+      else this.persist[k] = v;
+    }
+  }
+
+  // Constructor-shaped copy of the current settings (seeds the gesture worker)
+  persistedSnapshot() {
+    return JSON.parse(JSON.stringify({ ...this.opts, ...this.persist, calibration: { rect: this.store.get().cal.rect } }));
+  }
+
+  stopCore() {
+    if (this._animHandle) (this.animIntervalMs ? clearTimeout : clearImmediate)(this._animHandle);
+    this._animHandle = null;
+    this._animTs = 0;
+    this.frames.reset();
+    this.hands.reset();
+    this.ctx.bus.removeAll();
+  }
+
+  // passthroughs used elsewhere
+  startRecording() { this.ctx.recorder?.start?.(); }
+  stopRecording()  { this.ctx.recorder?.stop?.(); }
+  playLastRecording() { this.ctx.recorder?.play?.(); }
+  trainerEnable(v){ this.ctx.trainer?.enable?.(v); }
+  trainerSetLabel(s){ this.ctx.trainer?.setLabel?.(s); }
+  trainerStart(){ this.ctx.trainer?.start?.(); }
+  trainerStopAndSave(){ this.ctx.trainer?.stopSave?.(); }
+  trainerReplayLast(){ this.ctx.trainer?.replayLast?.(); }
+  startCalibration(){ this.ctx.calib?.start?.(); }
+  cancelCalibration(){ this.ctx.calib?.cancel?.(); }
+  _finishCalibration(){ this.ctx.calib?.finish?.(); }
+
+  profilerEnable(v) {
+    this.prof.setEnabled(v);
+    if (!v) this.onHUD({ prof: null });
+    this._tutor(`Profiler ${v ? 'ON' : 'OFF'}`);
+  }
+  profilerReset() { this.prof.reset(); }
+  profilerExport() {
+    const file = this.prof.exportTrace(path.join(this.userDataPath, 'traces'));
+    this._tutor(`Trace saved: ${path.basename(file)}`);
+    return file;
+  }
+
+  _adaptiveGain() {
+    const P = this.persist.pointerGain; if (!P.enabled) return 1.0;
+    const st = this.store.get();
+    const t = Math.max(0, Math.min(1, (st.lastPalmVel - P.velLow) / (P.velHigh - P.velLow)));
+    return lerp(P.gainMin, P.gainMax, t);
+  }
+
+  async _moveMouseSmooth(target){ this.store.set({ target }); }
+
+  // Entering hand: the cursor and its filter state (pos, target, lastPt) go straight to
+  // the hand's point, so _animate doesn't ease over from where the last hand left them
+  _snapCursor(pt, confidence = 1) {
+    if (confidence < CFG.entryMinConfidence) return;
+    const st = this.store.get();
+    this.io.mouse.setPosition(new this.io.Point(Math.round(st.displayBounds.x + pt.x), Math.round(st.displayBounds.y + pt.y)));
+    this.store.set({ pos: { x: pt.x, y: pt.y }, target: { x: pt.x, y: pt.y }, lastPt: { x: pt.x, y: pt.y } });
+  }
+
+  _animate() {
+    const st = this.store.get();
+    const gain = this._adaptiveGain();
+    const pos = { x: avg(st.pos.x, st.target.x, CFG.smoothing), y: avg(st.pos.y, st.target.y, CFG.smoothing) };
+    const dx = (pos.x - st.lastPt.x) * gain;
+    const dy = (pos.y - st.lastPt.y) * gain;
+
+    if (Math.hypot(dx, dy) > CFG.deadzonePx) {
+      const abs = new this.io.Point(Math.round(st.displayBounds.x + st.lastPt.x + dx), Math.round(st.displayBounds.y + st.lastPt.y + dy));
+      this.io.mouse.setPosition(abs);
+      this.store.set({ pos, lastPt: { x: st.lastPt.x + dx, y: st.lastPt.y + dy } });
+    } else {
+      this.store.set({ pos });
+    }
+
+    // scroll tail, over the wall time since the last tick (any tick rate coasts as far)
+    const t = now();
+    const dt = this._animTs ? t - this._animTs : 0;
+    this._animTs = t;
+    if (this.persist.scrollInertia.enabled && st.inertia.active) {
+      const { stepX, stepY } = stepScrollInertia(st.inertia, this.persist.scrollInertia, dt);
+      if (stepY) (stepY > 0 ? this.io.mouse.scrollUp(stepY) : this.io.mouse.scrollDown(-stepY));
+      if (stepX) (stepX > 0 ? this.io.mouse.scrollRight(stepX) : this.io.mouse.scrollLeft(-stepX));
+    }
+
+    this._animHandle = this.animIntervalMs
+      ? setTimeout(() => this._animate(), this.animIntervalMs)
+      : setImmediate(() => this._animate());
+  }
+
+  // Template match from the middleware recognizer (trainer-labeled segments)
+  _onGesture(g) {
+    if (!g || !g.label) return;
+    this.ctx.bus.emit('gesture:template', g);
+    this._hudPatch({ gesture: { label: g.label, confidence: +(g.confidence || 0).toFixed(2) } });
+    this._tutor(`Gesture: ${g.label} (${Math.round((g.confidence || 0) * 100)}%)`);
+  }
+
+  async _onReplayFrame(f) {
+    const st = this.store.get();
+    const h = f.hand;
+    this.store.set({ lastPalmVel: Math.hypot(h.palmVelocity?.[0]||0,h.palmVelocity?.[1]||0,h.palmVelocity?.[2]||0) });
+
+    const ext = h.ext|0, pinch = h.pinch||0, grab = h.grab||0;
+    const pt = this.ctx._mapToScreen(h.indexTip?.nx ?? h.palm?.nx ?? 0.5, h.indexTip?.ny ?? h.palm?.ny ?? 0.5);
+    await this._moveMouseSmooth(pt);
+
+    // calibration mimic
+    if (st.cal.active) {
+      if (st.cal.step === 'A' && pinch > 0.85) { st.cal.A = { nx: h.indexTip.nx, ny: h.indexTip.ny }; st.cal.step = 'B'; this.onCalState({ mode:'progress', step:'B' }); }
+      else if (st.cal.step === 'B' && pinch > 0.85) { st.cal.B = { nx: h.indexTip.nx, ny: h.indexTip.ny }; this._finishCalibration(); }
+      this._emitHUD(ext, pinch, grab, pt, 1); return;
+    }
+
+    if (ext === 4) {
+      if (pinch >= 0.8 && st.windowMode !== 'move' && st.gcr.canSwitch(ext)) this.ctx.window.enter('move', { x: pt.x, y: pt.y }, { roll:()=>h.roll, pitch:()=>h.pitch });
+      if (pinch <= 0.6 && st.windowMode === 'move') { this.ctx.window.exit(); st.gcr.release(); }
+    } else if (ext >= 5) {
+      if (pinch >= 0.8 && st.windowMode !== 'resize' && st.gcr.canSwitch(ext)) this.ctx.window.enter('resize', { x: pt.x, y: pt.y }, { roll:()=>h.roll, pitch:()=>h.pitch });
+      if (pinch <= 0.6 && st.windowMode === 'resize') { this.ctx.window.exit(); st.gcr.release(); }
+    } else if (ext <= 3 && st.windowMode !== 'none') {
+      this.ctx.window.exit(); st.gcr.release();
+    }
+
+    await this.ctx.window.tick({ x: pt.x, y: pt.y }, { roll:()=>h.roll, pitch:()=>h.pitch });
+
+    if (ext === 4 && st.windowMode === 'none') {
+      await this.ctx.os.swipes(h);
+    }
+
+    this._emitHUD(ext, pinch, grab, pt, 1);   // a replayed frame carries one hand
+  }
+
+  // Ends whatever the hand driving the one-hand gestures held (hand lost or replaced)
+  async _endHandModes(st) {
+    try { await this.ctx.bus.emit('gesture:pinch', false); } catch {}
+    if (st.dragging) { await this.io.mouse.releaseButton(this.io.Button.LEFT); this.store.set({ dragging: false }); }
+    await this.ctx.drag.end3?.();
+    this._lastTwoCenter = null;
+
+    this.ctx.window.exit?.();
+    st.gcr.release();
+
+    this.store.set({ dwellAnchor: null, dwellStartTs: 0, dwellCooldownTs: 0 });
+    this.ctx.dwell?.stop?.();
+
+    this.store.set({ fiveOpenStart: 0, lastFivePinchTs: 0 });
+    try { await this.ctx.window.snapCycle?.(false, 0); } catch {}
+  }
+
+  async _onFrame(frame) {
+  const st = this.store.get();
+  const hands = Array.isArray(frame.hands) ? frame.hands.length : 0;
+  const iBox = frame.interactionBox;
+  const t = this.clock.frame(frame.timestamp);
+
+  // Hands by id; the primary one drives everything below but the two-hand gestures
+  const sel = this.hands.update(frame.hands, t, iBox, CFG.primaryHand, CFG.handSmoothing);
+
+  // ---- No hands: hard reset and exit
+  if (!sel.primary) {
+    this.ctx.bimanual?.stop?.();
+    await this._endHandModes(st);
+    this.onHUD({ hands: 0, profile: this.profiles.current(), sched: this.frames.hud() });
+    return;
+  }
+
+  // Another hand took over: what the last one held ends, and its lock goes with it
+  if (sel.changed) {
+    this.ctx.bimanual?.stop?.(sel.primary, sel.secondary);
+    await this._endHandModes(st);
+    this.store.set({ gcr: sel.primary.gcr });
+  }
+
+  // velocity for smoothing / dwell cancel
+  this.store.set({ lastPalmVel: sel.primary.palmVel });
+
+  // ---- Primary hand data
+  const hand  = sel.primary.hand;
+  const pinch = hand.pinchStrength || hand.pinch || 0;
+  const grab  = hand.grabStrength  || hand.grab  || 0;
+  const fingers = Array.isArray(hand.fingers) ? hand.fingers : [];
+  const ext   = fingers.filter(f => f.extended).length;
+
+  // Cursor mapping (always compute localPt for HUD; move only when allowed).
+  // The LeapC middleware sends the index tip already in pixels once this display's
+  // calibration is uploaded (GestureEngine._uploadCalibration); otherwise map here.
+  let localPt, nx, ny;
+  {
+    const tip = (hand.indexFinger && hand.indexFinger.stabilizedTipPosition) || hand.stabilizedPalmPosition || [0.5,0.5,0];
+    const n = iBox.normalizePoint(tip, true);
+    nx = Math.max(0, Math.min(1, n[0]));
+    ny = Math.max(0, Math.min(1, n[1]));
+    const sp = hand.screenPoint;
+    localPt = (sp && frame.displayId && frame.displayId === st.displayId && !st.cal.active)
+      ? { x: sp[0], y: sp[1] }
+      : this.ctx._mapToScreen(nx, ny);
+  }
+
+  // Open-palm heuristic (ignore thumb) + deadman grab + clutch (thumb+pinky)
+  const thumb = fingers.find(f => f.type === 0);
+  const pinky = fingers.find(f => f.type === 4);
+  const nonThumbExtended = fingers.filter(f => f.type !== 0 && f.extended).length; // index/middle/ring/pinky
+  const palmOpen  = (nonThumbExtended >= 3) && (grab <= 0.2);
+  const deadman   = (grab >= 0.7);
+  const clutchOn  = !!(thumb?.extended && pinky?.extended); // disable click modes while true
+
+  if (this.ctx.isOn('cursor') && palmOpen && !deadman) {
+    if (sel.primary.entering) this._snapCursor(localPt, sel.primary.confidence);
+    else await this._moveMouseSmooth(localPt);
+  }
+
+  // recorder + trainer capture
+  this.ctx.recorder?.capture?.(iBox, hand);
+  this.ctx.trainer?.capture?.(iBox, hand);
+
+  // calibration flow
+  if (st.cal.active) {
+    if (st.cal.step === 'A' && pinch > 0.85) { st.cal.A = { nx, ny }; st.cal.step = 'B'; this.onCalState({ mode:'progress', step:'B' }); }
+    else if (st.cal.step === 'B' && pinch > 0.85) { st.cal.B = { nx, ny }; this._finishCalibration(); }
+    this._emitHUD(ext, pinch, grab, localPt, sel.count); return;
+  }
+
+  // two-hand pinch zoom / rotate: while engaged the one-hand gestures sit out
+  if (sel.secondary && this.ctx.isOn('bimanual')) {
+    if (await this.ctx.bimanual.handle(sel.primary, sel.secondary)) { this._emitHUD(ext, pinch, grab, localPt, sel.count); return; }
+  } else {
+    this.ctx.bimanual?.stop?.(sel.primary);
+  }
+
+  // enter/exit window modes
+  if (ext === 4 && this.ctx.isOn('windowMove')) {
+    if (pinch >= 0.8 && st.windowMode !== 'move' && st.gcr.canSwitch(ext)) this.ctx.window.enter('move', { x: localPt.x, y: localPt.y }, hand);
+    if (pinch <= 0.6 && st.windowMode === 'move') { this.ctx.window.exit(); st.gcr.release(); }
+  } else if (ext >= 5 && this.ctx.isOn('windowResize')) {
+    if (pinch >= 0.8 && st.windowMode !== 'resize' && st.gcr.canSwitch(ext)) this.ctx.window.enter('resize', { x: localPt.x, y: localPt.y }, hand);
+    if (pinch <= 0.6 && st.windowMode === 'resize') { this.ctx.window.exit(); st.gcr.release(); }
+  } else if (ext <= 3 && st.windowMode !== 'none') {
+    this.ctx.window.exit();
+    st.gcr.release();
+  }
+
+  await this.ctx.window.tick({ x: localPt.x, y: localPt.y }, hand);
+
+  // profile three-swipe bindings (when 3F-drag disabled)
+  if (await this.ctx.threeSwipe?.maybe?.(hand, ext)) {
+    this._emitHUD(ext, pinch, grab, localPt, sel.count);
+    return;
+  }
+
+  // regular gestures
+  if (ext === 1) {
+    // Index-only click (thumb ignored), require a bit of grip
+    const index = hand.indexFinger || fingers.find(f => f.type === 1) || null;
+    const othersExtended = fingers.filter(f => f !== index && f.type !== 0 && f.extended).length;
+    const gripEnough = (grab >= 0.35);
+    const indexOnly  = !!(index && index.extended && othersExtended === 0 && gripEnough && !clutchOn);
+
+    if (
+      this.ctx.isOn('drag') &&
+      (grab >= CFG.grabOn || st.dragging) &&
+      (st.gcr.current() ? st.gcr.current() === 'drag' : st.gcr.acquire('drag', ext))
+    ) {
+      await this.ctx.drag.maybeStart?.();
+      await this.ctx.bus.emit('gesture:pinch', false);
+    } else {
+      if (
+        this.ctx.isOn('pinchClick') &&
+        !st.dragging &&
+        (st.gcr.current() ? st.gcr.current() === 'pinch' : st.gcr.acquire('pinch', ext))
+      ) {
+        await this.ctx.bus.emit('gesture:pinch', indexOnly);
+      } else {
+        await this.ctx.bus.emit('gesture:pinch', false);
+      }
+
+      if (grab <= CFG.grabOff && st.dragging) {
+        await this.io.mouse.releaseButton(this.io.Button.LEFT);
+        this.store.set({ dragging: false });
+        st.gcr.release();
+        this._tutor('Drag end');
+      }
+    }
+
+    this._lastTwoCenter = null;
+    await this.ctx.drag.end3?.();
+  }
+  else if (ext === 2 && this.ctx.isOn('scroll')) {
+    // Try zoom first; if zoom handled the frame, skip scroll
+    const didZoom = await this.ctx.zoom?.handle?.(hand, iBox);
+    if (!didZoom) {
+      if (st.gcr.canSwitch(ext) && !st.gcr.current()) st.gcr.acquire('scroll', ext);
+      if (st.gcr.current() === 'scroll') {
+        await this.ctx.bus.emit('gesture:pinch', false);
+        await this.ctx.drag.end3?.();
+        await this.ctx.scroll.handle(hand, iBox);
+
+        if (st.windowMode === 'move') {
+          if (!this._lastTwoCenter) this._lastTwoCenter = localPt;
+          const dx = (localPt.x - this._lastTwoCenter.x);
+          const dy = (localPt.y - this._lastTwoCenter.y);
+          await this.ctx.window.snapSwipes(hand, dx, dy);
+        }
+      }
+      this._lastTwoCenter = localPt;
+    }
+  }
+  else if (ext === 3 && this.opts.threeFingerDrag && this.ctx.isOn('threeFingerDrag')) {
+    if (st.gcr.canSwitch(ext) && !st.gcr.current()) st.gcr.acquire('threeDrag', ext);
+    if (st.gcr.current() === 'threeDrag') {
+      await this.ctx.bus.emit('gesture:pinch', false);
+      await this.ctx.drag.start3?.();
+      this._lastTwoCenter = null;
+    }
+  } else if (ext !== 3 && this.opts.threeFingerDrag) {
+    await this.ctx.drag.end3?.();
+    if (st.gcr.current() === 'threeDrag') st.gcr.release();
+  }
+
+  // OS swipes when not in window modes
+  if (this.ctx.isOn('osSwipes') && ext === 4 && st.windowMode === 'none' && (!st.gcr.current() || st.gcr.current() === 'windowMove')) {
+    await this.ctx.os.swipes(hand);
+  }
+
+  // snap cycle tap (4F quick pinch)
+  if (this.ctx.isOn('snapCycle')) {
+    await this.ctx.window.snapCycle((pinch >= CFG.pinchOn && pinch <= 0.9), ext);
+  }
+
+  // 5F utilities (show desktop / launchpad) when not resizing
+  if (ext >= 5 && st.windowMode !== 'resize') {
+    const extF = fingers.filter(f=>f.extended).length;
+    if (extF >= 5) {
+      if (!st.fiveOpenStart) this.store.set({ fiveOpenStart: t });
+      if (t - this.store.get().fiveOpenStart >= CFG.fiveHoldMs) {
+        this.store.set({ fiveOpenStart: 0 });
+        if (this.ctx.isOn('showDesktop')) { await this.io.keyChord(OS.showDesktop); this._tutor('Show Desktop'); }
+      }
+    } else {
+      this.store.set({ fiveOpenStart: 0 });
+    }
+    if (extF >= 4 && pinch > 0.9 && t - st.lastFivePinchTs > 1200) {
+      this.store.set({ lastFivePinchTs: t });
+      if (this.ctx.isOn('launchpad')) { await this.io.keyChord(OS.launchpad); this._tutor('Launchpad'); }
+    }
+  } else {
+    this.store.set({ fiveOpenStart: 0 });
+  }
+
+  // Dwell click (only when feature enabled, hands present, and not clutching)
+  if (hands > 0 && this.ctx.isOn('dwellClick') && this.persist.dwell?.enabled && !clutchOn) {
+    await this.ctx.dwell.tick();
+  } else {
+    this.ctx.dwell?.stop?.();
+  }
+
+  this._emitHUD(ext, pinch, grab, localPt, sel.count);
+}
+
+}
+
+module.exports = GestureCore;
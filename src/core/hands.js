@@ -0,0 +1,129 @@
+// src/core/hands.js
+// Per-hand engine state keyed by the tracker's stable hand.id, and the choice of the hand
+// that drives the one-hand gestures (cursor, clicks, scroll, window modes, ...). LeapC
+// lists hands in no particular order, so taking hands[0] hands control back and forth
+// when both are in view. The primary hand is picked by policy (CFG.primaryHand) and kept
+// while it stays tracked:
+//   'right' / 'left'  the hand of that type whenever one is in view, else the other one
+//   'first'           the hand that has been tracked the longest
+// The other hand is the secondary one (two-handed gestures, src/gestures/bimanual.js).
+//
+// Each tracked hand owns a slice: its GCR lock, palm speed, strengths and a smoothed
+// palm point in box coordinates. Slices are recycled; a steady set of hands allocates
+// nothing per frame.
+//
+// A slice is `entering` for the hand's first frames: the middleware's hand.isNew when it
+// sends one (LeapC middleware, --new-frames), else the slice's own first `entryFrames`.
+// The engine sets state from an entering hand instead of smoothing toward it.
+
+const GCR = require('./gcr');
+
+const isLeft = (h) => h.type === 'left' || h.type === 0;
+const clip01 = (v) => (v < 0 ? 0 : v > 1 ? 1 : v);
+
+function newSlice() {
+  return {
+    id: -1, type: 'right', since: 0, lastTs: 0, seen: false,
+    frames: 0, entering: false, confidence: 1,   // frames since entry; see above
+    hand: null,            // this frame's hand object (pooled views: valid for the frame)
+    gcr: new GCR(),        // gesture lock of this hand
+    palmVel: 0, pinch: 0, grab: 0,
+    nx: 0.5, ny: 0.5, nz: 0.5, smoothed: false,   // smoothed palm, normalized box coords
+  };
+}
+
+function createHandTracker({ maxHands = 2, entryFrames = 6 } = {}) {
+  const active = [];       // slices of the hands in view
+  const free = [];
+  let primary = null, primaryId = null;   // by id: a recycled slice may be another hand
+  const out = { primary: null, secondary: null, changed: false, count: 0 };
+
+  function take(hand, t) {
+    for (let i = 0; i < active.length; i++) if (active[i].id === hand.id) return active[i];
+    const s = free.pop() || newSlice();
+    s.id = hand.id; s.since = t; s.smoothed = false; s.frames = 0;
+    s.gcr.release();
+    active.push(s);
+    return s;
+  }
+
+  // older first; equal age: lower id (deterministic whatever order LeapC lists them in)
+  const older = (a, b) => (a.since !== b.since ? a.since < b.since : a.id < b.id);
+
+  function pick(policy) {
+    const want = policy === 'left' || policy === 'right' ? policy : null;
+    let best = null;
+    for (let i = 0; i < active.length; i++) {
+      const s = active[i];
+      if (!best) { best = s; continue; }
+      const sw = want && s.type === want, bw = want && best.type === want;
+      if (sw !== bw) { if (sw) best = s; continue; }
+      // same standing: stay with the current primary, else the older hand
+      if (s.id === primaryId) best = s;
+      else if (best.id !== primaryId && older(s, best)) best = s;
+    }
+    return best;
+  }
+
+  // hands: frame.hands; t: engine ms; iBox: the frame's box; alpha: palm smoothing 0..1
+  function update(hands, t, iBox, policy = 'right', alpha = 0.5) {
+    for (let i = 0; i < active.length; i++) active[i].seen = false;
+    const n = Math.min(hands ? hands.length : 0, maxHands);
+    for (let h = 0; h < n; h++) {
+      const hand = hands[h];
+      const s = take(hand, t);
+      s.seen = true;
+      s.hand = hand;
+      s.type = isLeft(hand) ? 'left' : 'right';
+      s.lastTs = t;
+      s.frames++;
+      s.entering = typeof hand.isNew === 'boolean' ? hand.isNew : s.frames <= entryFrames;
+      s.confidence = typeof hand.confidence === 'number' ? hand.confidence : 1;
+      const v = hand.palmVelocity;
+      s.palmVel = v ? Math.hypot(v[0] || 0, v[1] || 0, v[2] || 0) : 0;
+      s.pinch = hand.pinchStrength || hand.pinch || 0;
+      s.grab = hand.grabStrength || hand.grab || 0;
+      const p = hand.stabilizedPalmPosition || hand.palmPosition;
+      // pooled vectors carry their normalized twin; anything else goes through the box
+      const q = p?.normalized || (p && iBox?.normalizePoint ? iBox.normalizePoint(p, true) : null);
+      if (q) {
+        const x = clip01(q[0]), y = clip01(q[1]), z = clip01(q[2]);
+        if (!s.smoothed) { s.nx = x; s.ny = y; s.nz = z; s.smoothed = true; }
+        else { s.nx += (x - s.nx) * alpha; s.ny += (y - s.ny) * alpha; s.nz += (z - s.nz) * alpha; }
+      }
+    }
+    for (let i = active.length - 1; i >= 0; i--) {
+      const s = active[i];
+      if (s.seen) continue;
+      s.hand = null;
+      free.push(s);
+      active[i] = active[active.length - 1];
+      active.pop();
+    }
+
+    const prevId = primaryId;
+    primary = pick(policy);
+    primaryId = primary ? primary.id : null;
+    let secondary = null;
+    for (let i = 0; i < active.length; i++) {
+      const s = active[i];
+      if (s !== primary && (!secondary || older(s, secondary))) secondary = s;
+    }
+    out.primary = primary;
+    out.secondary = secondary;
+    out.changed = primaryId !== prevId;
+    out.count = active.length;
+    return out;
+  }
+
+  return {
+    update,
+    get: (id) => active.find((s) => s.id === id) || null,
+    primary: () => primary,
+    secondary: () => out.secondary,
+    list: () => active,
+    reset() { while (active.length) { const s = active.pop(); s.hand = null; free.push(s); } primary = primaryId = null; out.primary = out.secondary = null; out.count = 0; },
+  };
+}
+
+module.exports = { createHandTracker };
@@ -0,0 +1,122 @@
+// src/core/hudPublisher.js
+// HUD update channel between the engine and the HUD window. The engine patches HUD
+// state on every frame (and from calibration, zoom, trainer...); sending each patch as
+// its own IPC message structured-clones a fresh object per tracking frame. Patches are
+// merged here instead, and only fields that differ from what the HUD already shows go
+// out, at most once per HUD animation frame: after a message the publisher waits for the
+// renderer's `ready()` (sent from its next requestAnimationFrame) before sending again.
+//
+// Toasts (`tutor`) are events, not state: every one is delivered, batched as an array.
+// `compact: true` packs the hot per-frame numbers into one number array `n`, with the key
+// order sent once as `nk` (expandHudPatch() undoes it on the receiving side).
+
+const HOT_FIELDS = ['hands', 'ext', 'pinch', 'grab', 'x', 'y'];
+const EVENT_FIELDS = new Set(['tutor']);
+
+const isPlain = (v) => v !== null && typeof v === 'object' && !Array.isArray(v) && !ArrayBuffer.isView(v);
+
+// Value equality for HUD fields: primitives, arrays and small plain objects
+function same(a, b, depth = 0) {
+  if (a === b || (a !== a && b !== b)) return true;
+  if (depth > 3 || a === null || b === null || typeof a !== 'object' || typeof b !== 'object') return false;
+  if (Array.isArray(a)) {
+    if (!Array.isArray(b) || a.length !== b.length) return false;
+    for (let i = 0; i < a.length; i++) if (!same(a[i], b[i], depth + 1)) return false;
+    return true;
+  }
+  if (!isPlain(a) || !isPlain(b)) return false;
+  const ka = Object.keys(a);
+  if (ka.length !== Object.keys(b).length) return false;
+  for (const k of ka) if (!same(a[k], b[k], depth + 1)) return false;
+  return true;
+}
+
+function createHudPublisher({
+  send,
+  compact = false,
+  // no ready() for this long (renderer reloaded or throttled): send anyway
+  staleMs = 1000,
+  now = Date.now,
+} = {}) {
+  const state = {};        // latest value of every field
+  const shown = {};        // what the HUD has
+  const dirty = new Set();
+  let toasts = [];
+  let credit = true;       // the renderer is waiting for a message
+  let lastSendTs = 0;
+  let hotKeysSent = false;
+  const stats = { patches: 0, messages: 0, unchanged: 0 };
+
+  function flush() {
+    const out = {};
+    let n = 0, hot = false;
+    for (const k of dirty) {
+      if (same(state[k], shown[k])) continue;
+      shown[k] = state[k];
+      n++;
+      if (compact && HOT_FIELDS.includes(k)) hot = true;
+      else out[k] = state[k];
+    }
+    dirty.clear();
+    if (hot) {
+      const v = new Array(HOT_FIELDS.length);
+      for (let i = 0; i < HOT_FIELDS.length; i++) v[i] = +(state[HOT_FIELDS[i]] ?? NaN);
+      out.n = v;
+      if (!hotKeysSent) { out.nk = HOT_FIELDS; hotKeysSent = true; }
+    }
+    if (toasts.length) { out.tutor = toasts.length === 1 ? toasts[0] : toasts; toasts = []; n++; }
+    if (!n) { stats.unchanged++; return false; }
+    credit = false;
+    lastSendTs = now();
+    stats.messages++;
+    send(out);
+    return true;
+  }
+
+  return {
+    patch(p) {
+      if (!p) return;
+      stats.patches++;
+      for (const k in p) {
+        const v = p[k];
+        if (EVENT_FIELDS.has(k)) { if (v) toasts.push(v); continue; }
+        const cur = state[k];
+        state[k] = isPlain(v) && isPlain(cur) ? { ...cur, ...v } : v;
+        dirty.add(k);
+      }
+      if (credit || now() - lastSendTs > staleMs) flush();
+    },
+
+    // Renderer drew the last message (from its requestAnimationFrame): send what piled up
+    ready() {
+      credit = true;
+      if (dirty.size || toasts.length) flush();
+    },
+
+    // HUD (re)loaded or shown again: it has nothing, resend every field
+    reset() {
+      for (const k of Object.keys(shown)) delete shown[k];
+      for (const k of Object.keys(state)) dirty.add(k);
+      hotKeysSent = false;
+      credit = true;
+      flush();
+    },
+
+    state: () => state,
+    // { patches, messages, unchanged }: unchanged = flushes where nothing differed
+    stats: () => ({ ...stats }),
+  };
+}
+
+// Receiving side of `compact`: copies n[] back onto the named fields. hotKeys carries
+// the key order between calls ({ keys }).
+function expandHudPatch(p, hotKeys) {
+  if (p && p.nk) hotKeys.keys = p.nk;
+  if (p && p.n && hotKeys.keys) {
+    const keys = hotKeys.keys;
+    for (let i = 0; i < keys.length; i++) if (p.n[i] === p.n[i]) p[keys[i]] = p.n[i];   // NaN: never set
+  }
+  return p;
+}
+
+module.exports = { createHudPublisher, expandHudPatch, HOT_FIELDS };
@@ -0,0 +1,56 @@
+// src/core/interactionBox.js
+// The one physical -> normalized mapping on the JS side. The LeapC middleware owns the
+// live box (fixed or auto-fit, see cMiddleware/ibox.h) and sends pre-normalized palm/tip
+// points plus the box it used; pooled frames link each point to its normalized twin
+// (`pt.normalized`), so normalizePoint() is a lookup there. Anything else (LeapJS/WS
+// frames, replayed vectors) is computed here against the same bounds.
+
+const DEFAULT_BOUNDS = { x: [-120, 120], y: [0, 300], z: [-120, 120] };
+
+const clip01 = (v) => (v < 0 ? 0 : v > 1 ? 1 : v);
+
+// acceptUnit: points that already look normalized (|v| <= 1.2 on every axis) pass
+// through; the WS service sometimes sends them that way.
+function createInteractionBox(bounds = DEFAULT_BOUNDS, { acceptUnit = false } = {}) {
+  const b = { x: [...bounds.x], y: [...bounds.y], z: [...bounds.z] };
+
+  function normalizeInto(out, at, x, y, z) {
+    if (acceptUnit && Math.abs(x) <= 1.2 && Math.abs(y) <= 1.2 && Math.abs(z) <= 1.2) {
+      out[at] = x; out[at + 1] = y; out[at + 2] = z;
+      return out;
+    }
+    out[at]     = (x - b.x[0]) / (b.x[1] - b.x[0]);
+    out[at + 1] = (y - b.y[0]) / (b.y[1] - b.y[0]);
+    out[at + 2] = (z - b.z[0]) / (b.z[1] - b.z[0]);
+    return out;
+  }
+
+  return {
+    bounds: b,
+    normalizeInto,
+
+    normalizePoint(pt, clamp = true) {
+      const pre = pt?.normalized;
+      let out;
+      if (pre) out = [pre[0], pre[1], pre[2]];
+      else {
+        // arrays and the pooled Float32Array vectors both index as [x,y,z]
+        const indexed = typeof pt?.length === 'number';
+        out = normalizeInto([0, 0, 0], 0,
+          indexed ? pt[0] : (pt?.x ?? 0), indexed ? pt[1] : (pt?.y ?? 0), indexed ? pt[2] : (pt?.z ?? 0));
+      }
+      if (clamp) { out[0] = clip01(out[0]); out[1] = clip01(out[1]); out[2] = clip01(out[2]); }
+      return out;
+    },
+
+    // [xmin,xmax,ymin,ymax,zmin,zmax] as sent by the middleware; true if it changed
+    setBounds(a) {
+      if (!a || a.length < 6) return false;
+      if (a[0] === b.x[0] && a[1] === b.x[1] && a[2] === b.y[0] && a[3] === b.y[1] && a[4] === b.z[0] && a[5] === b.z[1]) return false;
+      b.x[0] = a[0]; b.x[1] = a[1]; b.y[0] = a[2]; b.y[1] = a[3]; b.z[0] = a[4]; b.z[1] = a[5];
+      return true;
+    },
+  };
+}
+
+module.exports = { createInteractionBox, DEFAULT_BOUNDS };
@@ -0,0 +1,200 @@
+// src/core/profiler.js
+// Opt-in timing of the engine's per-frame work: the composed middleware, the ctx
+// handlers it installs (ctx.scroll.handle, ctx.zoom.handle, ctx.window.tick, ...), bus
+// listeners, the frame handler and the cursor tick. Each series keeps a rolling
+// histogram (two windows of `windowMs`, quarter-octave µs buckets) in preallocated typed
+// arrays; each thread profiles its own core, so the single writer needs no lock. Spans
+// also go to a ring buffer that exports as Chrome trace JSON (chrome://tracing,
+// Perfetto).
+//
+// Off (the default), ctx handlers are the original functions (timed wrappers are
+// swapped in on enable and out on disable) and the few fixed wrappers — frame, cursor
+// tick, bus listeners, middleware — cost one flag check.
+const fs = require('fs');
+const path = require('path');
+const { performance } = require('perf_hooks');
+const { threadId } = require('worker_threads');
+
+const BUCKETS = 64;    // bucket i (>0) holds [2^((i-1)/4), 2^(i/4)) µs; 0 is < 1 µs
+
+// ctx namespaces filled in by src/gestures and src/functions
+const NAMESPACES = ['scroll', 'zoom', 'window', 'os', 'dwell', 'drag', 'threeSwipe', 'bimanual', 'recorder', 'trainer', 'calib'];
+
+const bucketOf = (us) => (us < 1 ? 0 : Math.min(BUCKETS - 1, 1 + Math.floor(Math.log2(us) * 4)));
+const bucketTop = (i) => 2 ** (i / 4);
+
+function createProfiler({ enabled = false, windowMs = 5000, traceEvents = 32768, panelMs = 500, onPanel = null } = {}) {
+  const P = { on: !!enabled };
+  const names = [];
+  const ids = new Map();
+  // per series: 2 windows x (n, sumUs, maxUs) and 2 x BUCKETS counts
+  let sums = new Float64Array(0), counts = new Uint32Array(0);
+  let win = 0, winStart = performance.now(), lastPanel = 0;
+
+  // trace ring
+  const tName = new Uint16Array(traceEvents), tTs = new Float64Array(traceEvents), tDur = new Float32Array(traceEvents);
+  let tHead = 0, tLen = 0;
+
+  function series(name) {
+    let id = ids.get(name);
+    if (id !== undefined) return id;
+    id = names.length;
+    names.push(name);
+    ids.set(name, id);
+    const s = new Float64Array(names.length * 6); s.set(sums); sums = s;
+    const c = new Uint32Array(names.length * 2 * BUCKETS); c.set(counts); counts = c;
+    return id;
+  }
+
+  function rotate(t) {
+    if (t - winStart < windowMs) return;
+    win ^= 1;
+    winStart = t;
+    for (let id = 0; id < names.length; id++) {
+      sums.fill(0, id * 6 + win * 3, id * 6 + win * 3 + 3);
+      counts.fill(0, (id * 2 + win) * BUCKETS, (id * 2 + win + 1) * BUCKETS);
+    }
+  }
+
+  function record(id, t0) {
+    const t1 = performance.now();
+    const us = (t1 - t0) * 1e3;
+    rotate(t1);
+    const o = id * 6 + win * 3;
+    sums[o]++; sums[o + 1] += us; if (us > sums[o + 2]) sums[o + 2] = us;
+    counts[(id * 2 + win) * BUCKETS + bucketOf(us)]++;
+    tName[tHead] = id; tTs[tHead] = t0 * 1e3; tDur[tHead] = us;
+    tHead = (tHead + 1) % traceEvents;
+    if (tLen < traceEvents) tLen++;
+  }
+
+  // timed call; async results are timed until they settle
+  function timed(id, fn, self, a, b, c) {
+    const t0 = performance.now();
+    let r;
+    try { r = fn.call(self, a, b, c); }
+    catch (e) { record(id, t0); throw e; }
+    if (r && typeof r.then === 'function') {
+      return r.then((v) => { record(id, t0); return v; }, (e) => { record(id, t0); throw e; });
+    }
+    record(id, t0);
+    return r;
+  }
+
+  // Always-installed wrapper (frame handler, cursor tick, bus listeners, middleware)
+  function wrap(name, fn) {
+    const id = series(name);
+    return function (a, b, c) { return P.on ? timed(id, fn, this, a, b, c) : fn.call(this, a, b, c); };
+  }
+
+  const middleware = (list) => list.map((mw) => wrap(`mw:${mw.name || 'anonymous'}`, mw));
+
+  // bus.on() that times each listener as bus:<event>
+  function bus(b) {
+    const on = b.on;
+    return { ...b, on: (evt, fn) => on(evt, wrap(`bus:${evt}`, fn)) };
+  }
+
+  // ctx handlers: swapped for timed versions while enabled
+  let ctx = null;
+  const originals = [];
+  function instrument() {
+    if (!ctx || originals.length) return;
+    for (const ns of NAMESPACES) {
+      const o = ctx[ns];
+      if (!o || typeof o !== 'object') continue;
+      for (const k of Object.keys(o)) {
+        const fn = o[k];
+        if (typeof fn !== 'function') continue;
+        const id = series(`${ns}.${k}`);
+        originals.push([o, k, fn]);
+        o[k] = function (a, b, c) { return timed(id, fn, this, a, b, c); };
+      }
+    }
+  }
+  function restore() {
+    for (const [o, k, fn] of originals) o[k] = fn;
+    originals.length = 0;
+  }
+
+  function attach(c) { restore(); ctx = c; if (P.on) instrument(); }
+
+  function setEnabled(v) {
+    P.on = !!v;
+    if (P.on) instrument(); else restore();
+  }
+
+  function stats(id) {
+    const n = sums[id * 6] + sums[id * 6 + 3];
+    if (!n) return null;
+    const sum = sums[id * 6 + 1] + sums[id * 6 + 4];
+    const max = Math.max(sums[id * 6 + 2], sums[id * 6 + 5]);
+    const q = [0.5, 0.95, 0.99], out = [0, 0, 0];
+    let seen = 0, j = 0;
+    const a = id * 2 * BUCKETS, b = a + BUCKETS;
+    for (let i = 0; i < BUCKETS && j < 3; i++) {
+      seen += counts[a + i] + counts[b + i];
+      while (j < 3 && seen >= q[j] * n) out[j++] = Math.min(bucketTop(i), max);
+    }
+    const r1 = (v) => Math.round(v * 10) / 10;
+    return { name: names[id], n, avg: r1(sum / n), p50: r1(out[0]), p95: r1(out[1]), p99: r1(out[2]), max: r1(max) };
+  }
+
+  // Rolling stats, slowest (p99) first; µs
+  function snapshot() {
+    const list = [];
+    for (let id = 0; id < names.length; id++) { const s = stats(id); if (s) list.push(s); }
+    list.sort((x, y) => y.p99 - x.p99);
+    return list;
+  }
+
+  // HUD panel: frame / cursor tick plus the slowest handlers (called once per frame)
+  function panel(limit = 8) {
+    const all = snapshot();
+    const pick = (n) => all.find((s) => s.name === n) || null;
+    return {
+      frame: pick('frame'), animate: pick('animate'),
+      handlers: all.filter((s) => s.name !== 'frame' && s.name !== 'animate' && !s.name.startsWith('mw:')).slice(0, limit),
+    };
+  }
+
+  function tick() {
+    if (!P.on || !onPanel) return;
+    const t = performance.now();
+    if (t - lastPanel < panelMs) return;
+    lastPanel = t;
+    onPanel(panel());
+  }
+
+  // Chrome trace JSON (complete 'X' events, µs)
+  function trace() {
+    const pid = process.pid, tid = threadId;
+    const ev = [{ name: 'thread_name', ph: 'M', pid, tid, args: { name: tid ? 'gesture worker' : 'engine' } }];
+    for (let k = 0; k < tLen; k++) {
+      const i = (tHead - tLen + k + traceEvents) % traceEvents;
+      ev.push({ name: names[tName[i]], cat: 'gesture', ph: 'X', ts: tTs[i], dur: tDur[i], pid, tid });
+    }
+    return { traceEvents: ev, displayTimeUnit: 'ms' };
+  }
+
+  function exportTrace(dir) {
+    fs.mkdirSync(dir, { recursive: true });
+    const file = path.join(dir, `trace-${new Date().toISOString().replace(/[:.]/g, '-')}.json`);
+    fs.writeFileSync(file, JSON.stringify(trace()));
+    return file;
+  }
+
+  function reset() {
+    sums.fill(0); counts.fill(0);
+    tHead = tLen = 0;
+    winStart = performance.now();
+  }
+
+  return {
+    get on() { return P.on; },
+    wrap, middleware, bus, attach, setEnabled, tick,
+    snapshot, panel, trace, exportTrace, reset,
+  };
+}
+
+module.exports = { createProfiler, bucketOf, bucketTop, NAMESPACES };
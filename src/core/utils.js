@@ -7,9 +7,13 @@ const clamp01 = (v) => Math.max(0, Math.min(1, v));
 const lerp = (a,b,t) => a + (b-a)*t;
 const invLerp = (a,b,v) => (v - a) / (b - a);
 
-// Try to get keyChord from our IO adapter
-let io = null;
-try { io = require('../adapters/io'); } catch { io = null; }
+// Try to get keyChord from our IO adapter (loaded on first use, so modules that only
+// need the helpers, e.g. the gesture worker, never load the native input backends)
+let io;
+function adapter() {
+  if (io === undefined) { try { io = require('../adapters/io'); } catch { io = null; } }
+  return io;
+}
 
 async function osaKeyChord(mods = [], keyCode) {
   const using = mods.length ? ` using {${mods.join(', ')}}` : '';
@@ -21,8 +25,9 @@ async function osaKeyChord(mods = [], keyCode) {
 
 async function keyChord(keys) {
   // Prefer adapter (nut-js or robot fallback)
-  if (io && typeof io.keyChord === 'function') {
-    return io.keyChord(keys);
+  const a = adapter();
+  if (a && typeof a.keyChord === 'function') {
+    return a.keyChord(keys);
   }
   // Final fallback: minimal AppleScript handling for the specific chords we use
   const mods = [];
@@ -39,6 +44,8 @@ async function keyChord(keys) {
   if (keys.some(k => /Right$/.test(k)))keyCode = 124;
   if (keys.some(k => /F11/.test(k)))   keyCode = 103;
   if (keys.some(k => /F4/.test(k)))    keyCode = 118;
+  if (keys.includes('L'))              keyCode = 37;
+  if (keys.includes('R'))              keyCode = 15;
 
   if (keyCode == null) return;
   await osaKeyChord(mods, keyCode);
@@ -52,6 +59,8 @@ const OS = {
   prevDesktop:         ['LeftControl','Left'],
   showDesktop:         ['F11'],
   launchpad:           ['F4'],
+  rotateLeft:          ['LeftSuper','L'],   // Preview / Photos
+  rotateRight:         ['LeftSuper','R'],
 };
 
 module.exports = { now, avg, clamp01, lerp, invLerp, keyChord, OS };
@@ -28,6 +28,7 @@ function finishCalibration(ctx) {
     ctx.onSave({ calibration:{rect}, perDisplay: ctx.persist.perDisplay });
     ctx.onCalState({ mode:'done', rect, displayId: ctx.state.displayId });
   } else { ctx.onSave({ calibration:{rect} }); ctx.onCalState({ mode:'done', rect }); }
+  ctx.state.cal.rect = rect;
   ctx.state.cal.active = false; ctx.state.cal.step = 'done';
 }
 
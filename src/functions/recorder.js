@@ -60,7 +60,7 @@ function recorderCapture(ctx, iBox, hand) {
       ext:   ctx.extCount(hand),
       roll:  hand.roll() || 0,
       pitch: hand.pitch() || 0,
-      palmVelocity: hand.palmVelocity || [0,0,0],
+      palmVelocity: Array.from(hand.palmVelocity || [0,0,0]),
       indexTip, palm, fingers, twoCenter
     }
   };
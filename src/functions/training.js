@@ -75,7 +75,7 @@ function trainerCapture(ctx, iBox, hand) {
   ctx.state.trainer.seg.push({
     t, label: ctx.state.trainer.label || 'unlabeled',
     hand: { pinch: hand.pinchStrength||0, grab: hand.grabStrength||0, roll: hand.roll()||0, pitch: hand.pitch()||0,
-            palmVelocity: hand.palmVelocity||[0,0,0], indexTip, palm, twoCenter }
+            palmVelocity: Array.from(hand.palmVelocity||[0,0,0]), indexTip, palm, twoCenter }
   });
 }
 
@@ -0,0 +1,73 @@
+// src/gestures/bimanual.js
+// Two-handed pinch: pinch with both hands, then
+// - spread / bring the hands together → zoom (Cmd+Scroll, as src/gestures/zoom.js)
+// - turn the line between the hands → rotate (OS.rotateLeft / rotateRight per step)
+// Works on the hand slices from src/core/hands.js (smoothed palm points, box coords).
+// While engaged it holds both hands' GCR locks and the one-hand gestures sit out.
+
+const LOCK = 'bimanual';
+
+async function handleBimanual(ctx, a, b) {
+  const { CFG, keyboard, Key, mouse, keyChord, OS, state, tutor } = ctx;
+  const bi = state.bimanual || (state.bimanual = { active: false, dist: 0, angle: 0, zoomAcc: 0, rotAcc: 0 });
+
+  const onThresh  = CFG?.pinchZoomOn  ?? 0.75;
+  const offThresh = CFG?.pinchZoomOff ?? 0.55;
+  if (!bi.active) {
+    if (a.pinch < onThresh || b.pinch < onThresh) return false;
+    if (!a.gcr.acquire(LOCK, 0)) return false;          // the primary hand is busy (drag, window mode...)
+    if (!b.gcr.acquire(LOCK, 0)) { a.gcr.release(); return false; }
+    // left hand first, so the angle doesn't depend on which hand is primary
+    const [l, r] = a.type === 'left' ? [a, b] : [b, a];
+    Object.assign(bi, { active: true, dist: span(l, r), angle: tilt(l, r), zoomAcc: 0, rotAcc: 0 });
+    tutor?.('Two-hand zoom / rotate');
+    return true;
+  }
+  if (a.pinch <= offThresh || b.pinch <= offThresh) { stopBimanual(ctx, a, b); return false; }
+
+  const [l, r] = a.type === 'left' ? [a, b] : [b, a];
+  const dist = span(l, r), angle = tilt(l, r);
+
+  // Zoom: distance change -> wheel notches (fractions carry over)
+  bi.zoomAcc += (dist - bi.dist) * (CFG?.bimanualZoomScale ?? 200);
+  bi.dist = dist;
+  const stepY = Math.trunc(bi.zoomAcc);
+  if (stepY) {
+    bi.zoomAcc -= stepY;
+    await keyboard.pressKey(Key.LeftSuper);
+    try {
+      if (stepY > 0) await mouse.scrollUp(stepY);
+      else           await mouse.scrollDown(-stepY);
+    } finally {
+      await keyboard.releaseKey(Key.LeftSuper);
+    }
+  }
+
+  // Rotate: counter-clockwise (as seen by the user) is positive
+  let d = angle - bi.angle;
+  if (d > Math.PI) d -= 2 * Math.PI; else if (d < -Math.PI) d += 2 * Math.PI;
+  bi.angle = angle;
+  bi.rotAcc += d * 180 / Math.PI;
+  const stepDeg = CFG?.bimanualRotateStepDeg ?? 20;
+  if (Math.abs(bi.rotAcc) >= stepDeg) {
+    const left = bi.rotAcc > 0;
+    bi.rotAcc -= left ? stepDeg : -stepDeg;
+    await keyChord(left ? OS.rotateLeft : OS.rotateRight);
+    ctx.bus?.emit?.('gesture:rotate', left ? stepDeg : -stepDeg);
+    tutor?.(left ? 'Rotate left' : 'Rotate right');
+  }
+  return true;
+}
+
+// Releases the locks (a / b: slices still in view, if any)
+function stopBimanual(ctx, a, b) {
+  const bi = ctx.state.bimanual;
+  if (!bi || !bi.active) return;
+  bi.active = false;
+  for (const s of [a, b]) if (s && s.gcr.current() === LOCK) s.gcr.release();
+}
+
+function span(l, r) { return Math.hypot(r.nx - l.nx, r.ny - l.ny); }
+function tilt(l, r) { return Math.atan2(r.ny - l.ny, r.nx - l.nx); }
+
+module.exports = { handleBimanual, stopBimanual };
@@ -8,6 +8,7 @@ const { maybeSnapCycle, maybeMoveModeSnapSwipes } = require('./snapCycle');
 const { tickDwell } = require('./dwellClick');
 const { maybeThreeSwipeBinding } = require('./threeSwipeBindings');
 const { handleTwoFingerZoom } = require('./zoom'); 
+const { handleBimanual, stopBimanual } = require('./bimanual');
 
 // Pinch bus + init
 function mwPinch(ctx, next){ ctx.bus.on('gesture:pinch', (v)=>handlePinchClick(ctx, v)); pinchClickInit(ctx.state, ctx.persist, ctx.tutor); return next(); }
@@ -51,6 +52,12 @@ function mwZoom(ctx, next) {
   return next();
 }
 
+// Two-handed pinch zoom / rotate (hand slices from src/core/hands.js)
+function mwBimanual(ctx, next) {
+  ctx.bimanual = { handle: (a, b) => handleBimanual(ctx, a, b), stop: (a, b) => stopBimanual(ctx, a, b) };
+  return next();
+}
+
 module.exports = [
   mwPinch,
   mwDrag,
@@ -60,4 +67,5 @@ module.exports = [
   mwThreeSwipeBindings,
   mwDwell,
   mwZoom,
+  mwBimanual,
 ];
@@ -3,6 +3,13 @@
 // - Quantized "notches" for wheel feel
 // - Velocity-based impulse feeding your engine's inertia
 // - NO zoom logic here; zoom is handled by src/gestures/zoom.js
+// Everything is a rate per 16 ms step integrated over the elapsed (device) time, with
+// fractional notches carried over: the same hand motion scrolls the same amount, and
+// the tail coasts as far, at any tracking or animation rate.
+
+const STEP_MS = 16;     // rates and the inertia decay are per 16 ms
+const RAMP_MS = 100;    // ramp-in after the fingers land (~6 frames at 60 Hz)
+const MAX_DT_MS = 100;  // longer gaps (dropped frames) count as this
 
 async function handleTwoFingerScroll(ctx, hand, iBox) {
   const { persist, state, tutor, CFG } = ctx;
@@ -11,7 +18,7 @@ async function handleTwoFingerScroll(ctx, hand, iBox) {
   const extF = (hand.fingers || []).filter(f => f.extended);
   if (extF.length < 2) {
     ctx._lastTwoCenter = null;
-    state.scrollRampTicks = 0;
+    state.scrollRampMs = 0;
     state._scrollLastTs = undefined;
     return;
   }
@@ -25,76 +32,102 @@ async function handleTwoFingerScroll(ctx, hand, iBox) {
   const c  = { nx: (n1[0] + n2[0]) / 2, ny: (n1[1] + n2[1]) / 2 };
   const p  = ctx._mapToScreen(c.nx, c.ny);
 
-  // Framerate-normalized timing
+  // Device time (ctx.now() follows the frames' timestamps)
   const now = ctx.now();
   const lastTs = state._scrollLastTs;
   state._scrollLastTs = now;
 
-  if (ctx._lastTwoCenter) {
+  if (ctx._lastTwoCenter && typeof lastTs === 'number') {
     // pixel deltas (invert Y so up is positive)
     const dxPx = (p.x - ctx._lastTwoCenter.x);
     const dyPx = (p.y - ctx._lastTwoCenter.y) * -1;
 
-    // Normalize velocity to ~per-16ms frame so fast flicks boost more
-    let vX = 0, vY = 0;
-    if (typeof lastTs === 'number') {
-      const dtMs = Math.max(1, now - lastTs);
-      const norm = 16 / dtMs; // scale deltas to a 60fps-equivalent impulse
-      vX = dxPx * norm;
-      vY = dyPx * norm;
-    }
+    // Velocity as pixels per 16 ms, so fast flicks boost more at any frame rate
+    const dtMs = Math.max(1, Math.min(MAX_DT_MS, now - lastTs));
+    const norm = STEP_MS / dtMs;
+    const vX = dxPx * norm;
+    const vY = dyPx * norm;
 
     // Gentle ramp-in to avoid first-frame burst
-    state.scrollRampTicks = Math.min(6, (state.scrollRampTicks || 0) + 1);
-    const ramp = state.scrollRampTicks / 6;
+    state.scrollRampMs = Math.min(RAMP_MS, (state.scrollRampMs || 0) + dtMs);
+    const ramp = state.scrollRampMs / RAMP_MS;
 
     // ---------- Convert to wheel "notches" ----------
     const notchGain      = CFG?.scrollFlickGain      ?? 0.22; // steps per (normalized) pixel
     const notchMin       = CFG?.scrollStepMin        ?? 1;    // minimum per tick
-    const notchMax       = CFG?.scrollStepMax        ?? 6;    // clamp per-frame burst
+    const notchMax       = CFG?.scrollStepMax        ?? 6;    // clamp burst (per 16 ms)
     const expo           = CFG?.scrollExpo           ?? 1.0;  // >1 exaggerates flicks
     const inertiaBoost   = CFG?.scrollInertiaBoost   ?? 1.0;  // feed kinetic tail
 
-    // Base from displacement (slow drags)
-    const baseX = Math.sign(dxPx) * Math.pow(Math.abs(dxPx) * notchGain, expo) * ramp;
-    const baseY = Math.sign(dyPx) * Math.pow(Math.abs(dyPx) * notchGain, expo) * ramp;
-
-    // Extra from velocity (flicks)
-    const velX  = Math.sign(vX) * Math.pow(Math.abs(vX) * notchGain * 0.6, expo);
-    const velY  = Math.sign(vY) * Math.pow(Math.abs(vY) * notchGain * 0.6, expo);
+    // Notches per 16 ms: displacement (slow drags) + velocity (flicks)
+    const rateX = notchRate(vX, notchGain, expo, ramp, notchMax);
+    const rateY = notchRate(vY, notchGain, expo, ramp, notchMax);
 
-    // Combine & quantize to integer wheel steps
-    const rawX = baseX + velX;
-    const rawY = baseY + velY;
-
-    const stepX = quantizeNotches(rawX, notchMin, notchMax);
-    const stepY = quantizeNotches(rawY, notchMin, notchMax);
+    // Integrate over dt; whole notches go out, the remainder waits for the next frame
+    state._scrollAccX = (state._scrollAccX || 0) + rateX * dtMs / STEP_MS;
+    state._scrollAccY = (state._scrollAccY || 0) + rateY * dtMs / STEP_MS;
+    const stepX = takeNotches(state._scrollAccX, notchMin);
+    const stepY = takeNotches(state._scrollAccY, notchMin);
+    state._scrollAccX -= stepX;
+    state._scrollAccY -= stepY;
 
     // Output (no Cmd modifier here; zoom is handled elsewhere)
     if (stepY) (stepY > 0 ? ctx.mouse.scrollUp(stepY) : ctx.mouse.scrollDown(-stepY));
     if (stepX) (stepX > 0 ? ctx.mouse.scrollRight(stepX) : ctx.mouse.scrollLeft(-stepX));
 
-    // Kinetic tail (engine decays in _animate)
+    // Kinetic tail, notches per 16 ms (engine decays it in _animate: stepScrollInertia)
     if (persist.scrollInertia?.enabled) {
-      state.inertia.vx = Math.trunc(stepX * inertiaBoost);
-      state.inertia.vy = Math.trunc(stepY * inertiaBoost);
-      state.inertia.active = (Math.abs(state.inertia.vx) + Math.abs(state.inertia.vy)) > 0;
+      const vx = rateX * inertiaBoost, vy = rateY * inertiaBoost;
+      const active = Math.max(Math.abs(vx), Math.abs(vy)) >= (persist.scrollInertia.minStep ?? 1);
+      Object.assign(state.inertia, { vx, vy, active, accX: 0, accY: 0 });
     }
 
     if (Math.abs(stepX) + Math.abs(stepY) > 0) tutor('Scroll');
   } else {
-    state.scrollRampTicks = 0;
+    state.scrollRampMs = 0;
+    state._scrollAccX = 0;
+    state._scrollAccY = 0;
   }
 
   ctx._lastTwoCenter = p;
 }
 
-// Quantize continuous value into wheel-like integer steps with a minimum notch
-function quantizeNotches(value, minStep, maxStep) {
-  const s = Math.round(value);
-  if (s === 0) return 0;
-  const abs = Math.max(minStep, Math.min(Math.abs(s), maxStep));
-  return s > 0 ? abs : -abs;
+// Signed notches per 16 ms for a velocity in px per 16 ms, clamped to maxStep
+function notchRate(v, gain, expo, ramp, maxStep) {
+  const a = Math.abs(v);
+  const rate = Math.pow(a * gain, expo) * ramp + Math.pow(a * gain * 0.6, expo);
+  return Math.sign(v) * Math.min(rate, maxStep);
+}
+
+// Whole wheel notches in an accumulator, once at least minStep of them have built up
+function takeNotches(acc, minStep) {
+  const s = Math.trunc(acc);
+  return Math.abs(s) >= Math.max(1, minStep) ? s : 0;
+}
+
+// Advances the scroll tail by dtMs: the velocity decays by P.decay per 16 ms and the
+// notches it covers in that time (the exact integral) are returned; stops below
+// P.minStep. inertia: { vx, vy, active, accX, accY } (mutated).
+function stepScrollInertia(inertia, P, dtMs) {
+  if (!inertia.active || !(dtMs > 0)) return { stepX: 0, stepY: 0 };
+  const decay = Math.max(0, Math.min(1, P.decay ?? 0.9));
+  const k = dtMs / STEP_MS;
+  const r = Math.pow(decay, k);
+  // integral of v * decay^(t/16) dt/16 over [0, dt]
+  const cover = decay > 0 && decay < 1 ? (1 - r) / -Math.log(decay) : (decay === 1 ? k : 0);
+  inertia.accX = (inertia.accX || 0) + inertia.vx * cover;
+  inertia.accY = (inertia.accY || 0) + inertia.vy * cover;
+  inertia.vx *= r;
+  inertia.vy *= r;
+  const stepX = Math.trunc(inertia.accX), stepY = Math.trunc(inertia.accY);
+  inertia.accX -= stepX;
+  inertia.accY -= stepY;
+  const minStep = P.minStep ?? 1;
+  if (Math.abs(inertia.vx) < minStep && Math.abs(inertia.vy) < minStep) {
+    inertia.active = false;
+    inertia.accX = inertia.accY = 0;
+  }
+  return { stepX, stepY };
 }
 
-module.exports = { handleTwoFingerScroll };
+module.exports = { handleTwoFingerScroll, stepScrollInertia };
@@ -8,6 +8,7 @@ const btnStart  = document.getElementById('btnStart');
 const btnCancel = document.getElementById('btnCancel');
 
 const tutorDiv = document.getElementById('tutor');
+const profDiv  = document.getElementById('prof');
 
 const recbar    = document.getElementById('recbar');
 const recStatus = document.getElementById('recStatus');
@@ -33,7 +34,8 @@ function resize() {
 window.addEventListener('resize', resize);
 resize();
 
-let data = null;
+let data = null;           // HUD state, patched by every update (they are diffs)
+let updated = false;       // an update arrived since the last animation frame
 let calStep = 'idle';
 let trainerEnabled = false;
 
@@ -48,6 +50,18 @@ function addToast(text) {
   setTimeout(() => el.remove(), 1800);
 }
 
+// --- Profiler panel --------------------------------------------------------
+// Rolling per-handler timings (µs) from src/core/profiler.js; null hides it
+function renderProfPanel(p) {
+  if (!p) { profDiv.style.display = 'none'; return; }
+  const pad = (v, n = 7) => String(v ?? '—').padStart(n);
+  const row = (s) => `${s.name.padEnd(20).slice(0, 20)}${pad(s.n)}${pad(s.p50)}${pad(s.p95)}${pad(s.p99)}${pad(s.max, 8)}`;
+  const lines = [`${'µs'.padEnd(20)}${pad('n')}${pad('p50')}${pad('p95')}${pad('p99')}${pad('max', 8)}`];
+  for (const s of [p.frame, p.animate, ...(p.handlers || [])]) if (s) lines.push(row(s));
+  profDiv.textContent = lines.join('\n');
+  profDiv.style.display = 'block';
+}
+
 // --- Gestures panel --------------------------------------------------------
 async function renderGesturesPanel(root, preloadedFlags) {
   const flags = preloadedFlags || await window.leap.getGestures();
@@ -92,7 +106,7 @@ async function renderGesturesPanel(root, preloadedFlags) {
       cursor: true, scroll: true, pinchClick: false, drag: false,
       threeFingerDrag: false, osSwipes: false, windowMove: false,
       windowResize: false, snapCycle: false, showDesktop: false,
-      launchpad: false, dwellClick: false
+      launchpad: false, dwellClick: false, bimanual: false
     });
     renderGesturesPanel(root); // refresh
     addToast('Safe start preset applied');
@@ -106,7 +120,7 @@ renderGesturesPanel(gesturesRoot).catch(() => { /* ignore */ });
 function draw() {
   ctx.clearRect(0,0,canvas.width, canvas.height);
 
-  if (data) {
+  if (data && data.hands) {
     const r = devicePixelRatio || 1;
     const x = (data.x ?? 0) * r, y = (data.y ?? 0) * r;
 
@@ -132,21 +146,28 @@ function draw() {
     const disp = data?.displayId != null ? `  disp:${data.displayId}` : '';
     const lock = data?.gcr ? `  lock:${data.gcr}` : '';
     const profile = data?.profile?.name ? `  profile:${data.profile.name}` : '';
+    const s = data?.sched;
+    const sched = s ? `  q:${s.q}/${s.qMax}  drop:${s.dropped}  coal:${s.coalesced}  h:${s.ms}ms(max ${s.maxMs})` : '';
     info.textContent = data
-      ? `hands:${data.hands}  ext:${data.ext}  pinch:${data.pinch}  grab:${data.grab}  mode:${data.windowMode||'—'}  drag:${data.dragging?'yes':'no'}  x:${data.x} y:${data.y}${disp}${lock}${profile}`
+      ? `hands:${data.hands}  ext:${data.ext}  pinch:${data.pinch}  grab:${data.grab}  mode:${data.windowMode||'—'}  drag:${data.dragging?'yes':'no'}  x:${data.x} y:${data.y}${disp}${lock}${profile}${sched}`
       : '—';
   }
 
+  // pull the next update: main sends at most one per drawn frame
+  if (updated) { updated = false; window.hud.ready(); }
   requestAnimationFrame(draw);
 }
 requestAnimationFrame(draw);
 
 // --- HUD events from main --------------------------------------------------
 window.hud.onUpdate((payload) => {
-  data = payload || data;
-  if (payload?.calStep) calStep = payload.calStep;
-  if (payload?.tutor) addToast(payload.tutor);
+  updated = true;
+  if (!payload) return;
+  data = Object.assign(data || {}, payload);
+  if (payload.calStep) calStep = payload.calStep;
+  if (payload.tutor) [].concat(payload.tutor).forEach(addToast);
   if (payload?.rec) recStatus.textContent = `Recorder: ${payload.rec}`;
+  if ('prof' in payload) renderProfPanel(payload.prof);
 
   // Trainer UI sync
   if (payload?.trainer) {
@@ -165,6 +186,24 @@ window.hud.onUpdate((payload) => {
   }
 });
 
+// IR camera preview: 8-bit grayscale into a reused ImageData
+const irCanvas = document.getElementById('ir');
+const irCtx = irCanvas.getContext('2d');
+let irImage = null;
+window.hud.onImage?.(({ w, h, bpp, px }) => {
+  if (!irImage || irImage.width !== w || irImage.height !== h) {
+    irCanvas.width = w; irCanvas.height = h;
+    irImage = irCtx.createImageData(w, h);
+    irCanvas.style.display = 'block';
+  }
+  const out = irImage.data;
+  for (let i = 0, o = 0; o < out.length; i += bpp, o += 4) {
+    const v = px[i];
+    out[o] = v; out[o + 1] = v; out[o + 2] = v; out[o + 3] = 255;
+  }
+  irCtx.putImageData(irImage, 0, 0);
+});
+
 window.hud.onToggle((visible) => { document.body.style.opacity = visible ? '1' : '0'; });
 
 window.hud.onCal((payload) => {
@@ -1,19 +1,19 @@
 // src/input/profileSwitcher.js
-const { frontBundleId } = require('./profiles');
-
-function switchProfile(engine) {
+// bid: frontmost bundle id from the front-app watcher (src/osx/frontApp.js)
+function switchProfile(engine, bid) {
   if (!engine.profilesAuto) return;
-  const bid = frontBundleId(); if (!bid) return;
+  if (!bid) return;
   if (bid === engine.frontBundleId) return;
 
   engine.frontBundleId = bid;
+  if (engine.ctx) engine.ctx.frontBundleId = bid;
 
   // preserve current gesture toggles before reset
   const keepGestures = { ...(engine.persist?.gestures || {}) };
 
-  // reset to base, then restore toggles
-  engine.opts     = JSON.parse(JSON.stringify(engine._base.opts));
-  engine.persist  = JSON.parse(JSON.stringify(engine._base.persist));
+  // reset to base in place (ctx holds these objects), then restore toggles
+  resetInPlace(engine.opts, engine._base.opts);
+  resetInPlace(engine.persist, engine._base.persist);
   engine.persist.gestures = { ...(engine.persist.gestures || {}), ...keepGestures };
 
   const p = engine.profiles.activate(bid);
@@ -31,4 +31,10 @@ function switchProfile(engine) {
   engine._hudPatch({ settings: { gestures: engine.persist.gestures } });
 }
 
+function resetInPlace(target, base) {
+  const copy = JSON.parse(JSON.stringify(base));
+  for (const k of Object.keys(target)) if (!(k in copy)) delete target[k];
+  Object.assign(target, copy);
+}
+
 module.exports = { switchProfile };
@@ -1,18 +1,8 @@
 const fs = require('fs');
-const { execFileSync } = require('child_process');
 const { keyChord } = require('../core/utils');
 const { parseKey } = require('./keys');
 
-function frontBundleId() {
-  try {
-    const out = execFileSync(
-      'osascript',
-      ['-e', 'tell application "System Events" to get bundle identifier of (first process whose frontmost is true)'],
-      { encoding: 'utf8' }
-    );
-    return String(out || '').trim();
-  } catch { return ''; }
-}
+// Frontmost-app changes come from src/osx/frontApp.js (push-based watcher)
 
 class Profiles {
   constructor(profilesPath, onTutor) {
@@ -22,8 +12,10 @@ class Profiles {
     this.activeName = 'Default';
     this.auto = true;
     this.onTutor = onTutor || (()=>{});
+    this._cache = new Map(); // bundleId -> resolved profile
   }
   load() {
+    this._cache.clear();
     try {
       if (this.path && fs.existsSync(this.path)) {
         const obj = JSON.parse(fs.readFileSync(this.path,'utf8'));
@@ -35,8 +27,13 @@ class Profiles {
   setAuto(v) { this.auto = !!v; }
   current() { return { id: this.activeId, name: this.activeName }; }
   getProfileFor(bundleId) {
-    const p = this.data.profiles || {};
-    return p[bundleId] || p['default'] || { name:'Default', overrides:{} };
+    let prof = this._cache.get(bundleId);
+    if (!prof) {
+      const p = this.data.profiles || {};
+      prof = p[bundleId] || p['default'] || { name:'Default', overrides:{} };
+      this._cache.set(bundleId, prof);
+    }
+    return prof;
   }
   activate(bundleId) {
     const prof = this.getProfileFor(bundleId || 'default');
@@ -53,4 +50,4 @@ class Profiles {
   }
 }
 
-module.exports = { Profiles, frontBundleId };
+module.exports = { Profiles };
@@ -0,0 +1,114 @@
+// src/osx/frontApp.js
+// Frontmost-app watcher. Push-based through `axwin watchFront` (NSWorkspace activation
+// notifications streamed as lines); falls back to an async osascript poll when the
+// helper is missing. Sources are pluggable: tests feed synthetic focus changes through
+// createStubSource().
+//
+// Source interface: { start(onFront), stop() }, onFront({ bundleId, pid })
+const { spawn, execFile } = require('child_process');
+const { EventEmitter } = require('events');
+
+// "front <bundleId> <pid>" -> { bundleId, pid } | null
+function parseFrontLine(line) {
+  const m = /^front\s+(\S*)\s+(\d+)\s*$/.exec(line);
+  return m ? { bundleId: m[1], pid: Number(m[2]) } : null;
+}
+
+function axwinSource(helperPath, { restartMs = 1000, fallback = null } = {}) {
+  let child = null, stopped = false, timer = null, fellBack = false, failures = 0;
+
+  function fallBack(onFront) {
+    if (stopped || fellBack || !fallback) return;
+    fellBack = true;
+    fallback.start(onFront);
+  }
+
+  function start(onFront) {
+    stopped = false;
+    let buf = '';
+    child = spawn(helperPath, ['watchFront'], { stdio: ['pipe', 'pipe', 'ignore'] });
+    child.stdout.setEncoding('utf8');
+    child.stdout.on('data', (d) => {
+      buf += d;
+      let nl;
+      while ((nl = buf.indexOf('\n')) !== -1) {
+        const ev = parseFrontLine(buf.slice(0, nl));
+        buf = buf.slice(nl + 1);
+        if (ev) { failures = 0; onFront(ev); }
+      }
+    });
+    // helper missing/not executable: hand over to the fallback source for good
+    child.on('error', () => fallBack(onFront));
+    child.on('exit', () => {
+      child = null;
+      // an older helper without watchFront exits at once; give up after a few tries
+      if (++failures >= 3) fallBack(onFront);
+      if (!stopped && !fellBack) timer = setTimeout(() => start(onFront), restartMs);
+    });
+  }
+
+  function stop() {
+    stopped = true;
+    clearTimeout(timer);
+    if (fellBack) fallback.stop();
+    try { child?.stdin.end(); child?.kill(); } catch {}
+    child = null;
+  }
+
+  return { start, stop };
+}
+
+// Fallback: async (never blocks the event loop) osascript poll
+function pollSource({ intervalMs = 800 } = {}) {
+  let timer = null, inflight = false;
+  const script = 'tell application "System Events" to get bundle identifier of (first process whose frontmost is true)';
+
+  function start(onFront) {
+    timer = setInterval(() => {
+      if (inflight) return;
+      inflight = true;
+      execFile('osascript', ['-e', script], { encoding: 'utf8' }, (err, out) => {
+        inflight = false;
+        const bundleId = err ? '' : String(out || '').trim();
+        if (bundleId) onFront({ bundleId, pid: 0 });
+      });
+    }, intervalMs);
+  }
+
+  function stop() { clearInterval(timer); timer = null; }
+
+  return { start, stop };
+}
+
+// Synthetic focus changes (tests)
+function createStubSource() {
+  let cb = null;
+  return {
+    start(onFront) { cb = onFront; },
+    stop() { cb = null; },
+    focus(bundleId, pid = 0) { cb?.({ bundleId, pid }); },
+  };
+}
+
+// Emits 'change' ({ bundleId, pid }) only when the frontmost bundle actually changes
+function createFrontAppWatcher({ helperPath = null, source = null } = {}) {
+  const bus = new EventEmitter();
+  const src = source || (helperPath ? axwinSource(helperPath, { fallback: pollSource() }) : pollSource());
+  let current = '';
+
+  const api = {
+    on: (...a) => { bus.on(...a); return api; },
+    current: () => current,
+    start() {
+      src.start((ev) => {
+        if (!ev.bundleId || ev.bundleId === current) return;
+        current = ev.bundleId;
+        bus.emit('change', ev);
+      });
+    },
+    stop() { src.stop(); },
+  };
+  return api;
+}
+
+module.exports = { createFrontAppWatcher, createStubSource, axwinSource, pollSource, parseFrontLine };
@@ -13,12 +13,27 @@ const hudChannels = {
   update: 'hud:update',
   toggle: 'hud:toggle',
   cal:    'hud:cal',
+  image:  'hud:image',
+  ready:  'hud:ready',
 };
 
+// Compact updates (src/core/hudPublisher.js, HUD_COMPACT=1) pack the hot numbers into
+// n[] and name them once in nk; expanded here so the renderer always sees fields
+// (expandHudPatch there; a sandboxed preload can't require it).
+const hotKeys = { keys: null };
+function expandPatch(p) {
+  if (p && p.nk) hotKeys.keys = p.nk;
+  if (p && p.n && hotKeys.keys) {
+    for (let i = 0; i < hotKeys.keys.length; i++) if (p.n[i] === p.n[i]) p[hotKeys.keys[i]] = p.n[i];
+  }
+  return p;
+}
+
 contextBridge.exposeInMainWorld('hud', {
   // Event subscriptions (return an unsubscribe fn to avoid leaks)
+  // Updates are diffs against the previous ones; call ready() once one has been drawn
   onUpdate: (fn) => {
-    const handler = (_e, data) => fn(data);
+    const handler = (_e, data) => fn(expandPatch(data));
     ipcRenderer.on(hudChannels.update, handler);
     return () => ipcRenderer.removeListener(hudChannels.update, handler);
   },
@@ -32,6 +47,13 @@ contextBridge.exposeInMainWorld('hud', {
     ipcRenderer.on(hudChannels.cal, handler);
     return () => ipcRenderer.removeListener(hudChannels.cal, handler);
   },
+  onImage: (fn) => {
+    const handler = (_e, img) => fn(img);
+    ipcRenderer.on(hudChannels.image, handler);
+    return () => ipcRenderer.removeListener(hudChannels.image, handler);
+  },
+
+  ready: () => ipcRenderer.send(hudChannels.ready),
 
   // Actions (invoke -> main)
   calStart:   () => ipcRenderer.invoke('cal:start'),
@@ -0,0 +1,51 @@
+// src/worker/actuator.js
+// Main-thread side of the gesture worker: replays command batches from remoteIO.js on
+// the real IO surface (adapters/io + window ops) in order, one batch after another.
+
+function createActuator(io, { profiles } = {}) {
+  const btn = (b) => (io.Button && io.Button[b] !== undefined ? io.Button[b] : b);
+  const key = (k) => (io.Key && io.Key[k] !== undefined ? io.Key[k] : k);
+  const stats = { batches: 0, commands: 0, errors: 0 };
+  let tail = Promise.resolve();
+
+  async function run(cmd) {
+    const m = io.mouse;
+    switch (cmd[0]) {
+      case 'm': return m.setPosition(new io.Point(Math.round(cmd[1]), Math.round(cmd[2])));
+      case 's': {
+        const dx = Math.trunc(cmd[1]), dy = Math.trunc(cmd[2]);
+        if (dy) await (dy > 0 ? m.scrollUp(dy) : m.scrollDown(-dy));
+        if (dx) await (dx > 0 ? m.scrollRight(dx) : m.scrollLeft(-dx));
+        return;
+      }
+      case 'c': return m.click(btn(cmd[1]));
+      case 'd': return m.pressButton(btn(cmd[1]));
+      case 'u': return m.releaseButton(btn(cmd[1]));
+      case 'kd': return io.keyboard.pressKey(key(cmd[1]));
+      case 'ku': return io.keyboard.releaseKey(key(cmd[1]));
+      case 'k': return io.keyChord(cmd[1]);
+      case 'w':
+        if (cmd[1] === 'move') return io.moveWindow?.(cmd[2], cmd[3]);
+        if (cmd[1] === 'resize') return io.resizeWindow?.(cmd[2], cmd[3]);
+        if (cmd[1] === 'snap') return io.snapWindow?.(cmd[2]);
+        return;
+      case 'b': return profiles?.runBinding?.(cmd[1]);
+      default: return;
+    }
+  }
+
+  function apply(cmds) {
+    stats.batches++;
+    stats.commands += cmds.length;
+    tail = tail.then(async () => {
+      for (const c of cmds) {
+        try { await run(c); } catch (e) { stats.errors++; }
+      }
+    });
+    return tail;
+  }
+
+  return { apply, stats };
+}
+
+module.exports = { createActuator };
@@ -0,0 +1,171 @@
+// src/worker/frameChannel.js
+// Single-slot SharedArrayBuffer frame channel (main -> gesture worker), latest-wins.
+// The writer publishes each frame under a sequence lock (odd = writing); the reader
+// copies the slot into its own FrameView and retries if the sequence moved meanwhile.
+// Frames the reader never saw are counted as skipped.
+//
+// Slot layout (hand records use the frameView.js Float32/Uint8 layout):
+//   Int32  [SEQ, FRAME_ID, HANDS, FPS_MILLI, DISPLAY, TS_LO, TS_HI, FLAGS, id0..idN-1]
+//   (TS: the frame's device timestamp in us, split into two 32-bit halves;
+//    FLAGS bit 0: idle heartbeat)
+//   Float32[maxHands * F.SIZE]
+//   Uint8  [maxHands * U.SIZE]
+
+const { FrameView, FINGER_NAMES, orientFromQuat, normalizeAll, FRAME_LAYOUT: { F, U } } = require('../bridges/frameView');
+
+const H = { SEQ: 0, FRAME_ID: 1, HANDS: 2, FPS_MILLI: 3, DISPLAY: 4, TS_LO: 5, TS_HI: 6, FLAGS: 7, IDS: 8 };
+const TS_SPLIT = 2 ** 32;
+
+function layout(maxHands) {
+  const hdrLen = H.IDS + maxHands;
+  const f32Off = hdrLen * 4;
+  const u8Off = f32Off + maxHands * F.SIZE * 4;
+  return { hdrLen, f32Off, u8Off, bytes: u8Off + maxHands * U.SIZE };
+}
+
+function channelBytes(maxHands = 2) { return layout(maxHands).bytes; }
+
+function views(sab, maxHands) {
+  const L = layout(maxHands);
+  return {
+    hdr: new Int32Array(sab, 0, L.hdrLen),
+    f32: new Float32Array(sab, L.f32Off, maxHands * F.SIZE),
+    u8: new Uint8Array(sab, L.u8Off, maxHands * U.SIZE),
+  };
+}
+
+// Any legacy-shaped hand (LeapJS or our own views) -> one packed record
+function encodeHand(f, fo, u, uo, hand, box) {
+  put3(f, fo + F.PALM, hand.palmPosition);
+  put3(f, fo + F.VEL, hand.palmVelocity);
+  put3(f, fo + F.STAB, hand.palmStabilized || hand.stabilizedPalmPosition || hand.palmPosition);
+  const q = hand.palmQuaternion;
+  if (q && q.length >= 4) { f[fo + F.QUAT] = q[0]; f[fo + F.QUAT + 1] = q[1]; f[fo + F.QUAT + 2] = q[2]; f[fo + F.QUAT + 3] = q[3]; }
+  else { f[fo + F.QUAT] = 0; f[fo + F.QUAT + 1] = 0; f[fo + F.QUAT + 2] = 0; f[fo + F.QUAT + 3] = 1; }
+  if (typeof hand.roll === 'function' && hand.palmNormal && hand.direction) {
+    f[fo + F.ROLL] = hand.roll(); f[fo + F.PITCH] = hand.pitch(); f[fo + F.YAW] = hand.yaw?.() || 0;
+    put3(f, fo + F.NORMAL, hand.palmNormal);
+    put3(f, fo + F.DIR, hand.direction);
+  } else {
+    orientFromQuat(f, fo);
+  }
+  put3(f, fo + F.ANGVEL, hand.angularVelocity);
+  f[fo + F.PINCH_DIST] = hand.pinchDistance || 0;
+  f[fo + F.GRAB_ANGLE] = hand.grabAngle || 0;
+  f[fo + F.PINCH] = hand.pinchStrength || 0;
+  f[fo + F.GRAB] = hand.grabStrength || 0;
+  f[fo + F.CONF] = typeof hand.confidence === 'number' ? hand.confidence : 1;
+  u[uo + U.TYPE] = hand.type === 0 || hand.type === 'left' ? 0 : 1;
+  u[uo + U.NEW] = hand.isNew === undefined ? 2 : hand.isNew ? 1 : 0;
+
+  const fingers = Array.isArray(hand.fingers) ? hand.fingers : [];
+  for (let i = 0; i < FINGER_NAMES.length; i++) {
+    const fg = fingers.find(x => x.type === i);
+    put3(f, fo + F.TIPS + i * 3, (fg && fg.stabilizedTipPosition) || hand.palmPosition);
+    u[uo + U.EXT + i] = fg && fg.extended ? 1 : 0;
+  }
+  normalizeHand(f, fo, box);
+  u[uo + U.SCREEN_OK] = 0;
+}
+
+// Pre-normalized palm/tips for the reader: our box fills them in place; a LeapJS
+// InteractionBox only offers normalizePoint()
+function normalizeHand(f, fo, box) {
+  if (box?.normalizeInto) { normalizeAll(f, fo, box); return; }
+  if (!box?.normalizePoint) return;
+  const put = (dst, src) => {
+    const n = box.normalizePoint([f[src], f[src + 1], f[src + 2]], false);
+    f[dst] = n[0]; f[dst + 1] = n[1]; f[dst + 2] = n[2];
+  };
+  put(fo + F.NORM_STAB, fo + F.STAB);
+  for (let i = 0; i < 5; i++) put(fo + F.NORM_TIPS + i * 3, fo + F.TIPS + i * 3);
+}
+
+function put3(f, at, v) {
+  if (v && v.length >= 3) { f[at] = v[0]; f[at + 1] = v[1]; f[at + 2] = v[2]; }
+  else { f[at] = 0; f[at + 1] = 0; f[at + 2] = 0; }
+}
+
+function createFrameWriter(sab, maxHands = 2) {
+  const { hdr, f32, u8 } = views(sab, maxHands);
+
+  function write(frame) {
+    const hands = Array.isArray(frame.hands) ? frame.hands : [];
+    const n = Math.min(hands.length, maxHands);
+    const seq = Atomics.load(hdr, H.SEQ);
+    Atomics.store(hdr, H.SEQ, seq + 1);
+
+    hdr[H.FRAME_ID] = frame.id | 0;
+    hdr[H.HANDS] = n;
+    hdr[H.FPS_MILLI] = Math.round((frame.fps || frame.currentFrameRate || 0) * 1000);
+    hdr[H.DISPLAY] = frame.displayId >>> 0;   // u32 (CGDirectDisplayID); read back unsigned
+    const ts = frame.timestamp > 0 ? frame.timestamp : 0;
+    hdr[H.TS_LO] = ts % TS_SPLIT;
+    hdr[H.TS_HI] = Math.floor(ts / TS_SPLIT);
+    hdr[H.FLAGS] = frame.heartbeat ? 1 : 0;
+    if (frame._f32 && frame._u8) {
+      // pooled bridge frame: records are already packed
+      f32.set(frame._f32.subarray(0, n * F.SIZE));
+      u8.set(frame._u8.subarray(0, n * U.SIZE));
+    } else {
+      for (let h = 0; h < n; h++) encodeHand(f32, h * F.SIZE, u8, h * U.SIZE, hands[h], frame.interactionBox);
+    }
+    for (let h = 0; h < n; h++) hdr[H.IDS + h] = hands[h].id | 0;
+
+    Atomics.store(hdr, H.SEQ, seq + 2);
+    Atomics.notify(hdr, H.SEQ);
+  }
+
+  return { write };
+}
+
+function createFrameReader(sab, maxHands = 2, interactionBox) {
+  const { hdr, f32, u8 } = views(sab, maxHands);
+  let lastSeq = 0;
+  let skipped = 0;
+
+  // Copies the newest published frame into `view` (a FrameView); null if nothing new
+  function read(view) {
+    for (let tries = 0; tries < 8; tries++) {
+      const s1 = Atomics.load(hdr, H.SEQ);
+      if (s1 === lastSeq) return null;
+      if (s1 & 1) continue;
+
+      const n = Math.min(hdr[H.HANDS], maxHands);
+      view._f32.set(f32.subarray(0, n * F.SIZE));
+      view._u8.set(u8.subarray(0, n * U.SIZE));
+      for (let h = 0; h < n; h++) view._views[h].id = hdr[H.IDS + h];
+      const id = hdr[H.FRAME_ID], fps = hdr[H.FPS_MILLI], display = hdr[H.DISPLAY] >>> 0;
+      const ts = hdr[H.TS_HI] * TS_SPLIT + (hdr[H.TS_LO] >>> 0);
+      const flags = hdr[H.FLAGS];
+
+      if (Atomics.load(hdr, H.SEQ) !== s1) continue; // torn: writer published meanwhile
+      view.id = id;
+      view.fps = fps ? fps / 1000 : undefined;
+      view.displayId = display;
+      view.timestamp = ts;
+      view.heartbeat = (flags & 1) === 1;
+      view.hands = view._byCount[n];
+      skipped += (s1 - lastSeq) / 2 - 1;
+      lastSeq = s1;
+      return view;
+    }
+    return null;
+  }
+
+  // Resolves when a frame newer than the last read is (being) published
+  function next(timeoutMs = 1000) {
+    const s = Atomics.load(hdr, H.SEQ);
+    if (s !== lastSeq && !(s & 1)) return Promise.resolve();
+    const r = Atomics.waitAsync(hdr, H.SEQ, s, timeoutMs);
+    return r.async ? r.value : Promise.resolve();
+  }
+
+  function createView() { return new FrameView(maxHands, interactionBox); }
+
+  function takeSkipped() { const n = skipped; skipped = 0; return n; }
+
+  return { read, next, createView, takeSkipped };
+}
+
+module.exports = { channelBytes, createFrameWriter, createFrameReader };
@@ -0,0 +1,74 @@
+// src/worker/gestureWorker.js
+// worker_threads entry: decodes frames from the shared frame channel and runs the
+// composed gesture/function middleware (GestureCore) here, off the Electron main loop.
+// Only actuation commands, HUD patches and persistence requests go back to main.
+const { parentPort, workerData } = require('worker_threads');
+const GestureCore = require('../core/gestureCore');
+const { createRemoteIO } = require('./remoteIO');
+const { createFrameReader } = require('./frameChannel');
+const { createInteractionBox } = require('../core/interactionBox');
+
+const { sab, maxHands, mmBounds, persisted, userDataPath, helperPath, animIntervalMs } = workerData;
+const post = (m) => parentPort.postMessage(m);
+const io = createRemoteIO(post);
+
+// Profile snapshot pushed by main (the real Profiles lives there)
+const prof = { current: workerData.profile || { id: 'default', name: 'Default' }, profiles: workerData.profiles || {} };
+const profiles = {
+  current: () => prof.current,
+  getProfileFor: (bid) => prof.profiles[bid] || prof.profiles.default || { name: 'Default', overrides: {} },
+  runBinding: (binding) => io.runBinding(binding),
+  setAuto() {}, load() {},
+};
+
+const core = new GestureCore({
+  io, profiles, persisted, userDataPath, helperPath,
+  animIntervalMs: animIntervalMs || 4,
+  onHUD: (p) => post({ t: 'hud', p }),
+  onCalState: (p) => post({ t: 'cal', p }),
+  onSave: (p) => post({ t: 'save', p }),
+});
+
+const reader = createFrameReader(sab, maxHands, createInteractionBox(mmBounds));
+const view = reader.createView();
+let running = true;
+
+async function loop() {
+  while (running) {
+    await reader.next();
+    const f = reader.read(view);
+    if (!f) continue;
+    core.frames.stats.coalesced += reader.takeSkipped();
+    core.frames.push(f);
+    await core.frames.idle();   // one view: never refill it under the handler
+  }
+}
+
+parentPort.on('message', (m) => {
+  switch (m.t) {
+    case 'display': core.setDisplay(m.d); break;
+    case 'settings': core.applySettings(m.s); break;
+    case 'profile':
+      prof.current = m.p.current || prof.current;
+      if (m.p.profiles) prof.profiles = m.p.profiles;
+      core.frontBundleId = m.p.frontBundleId || '';
+      core.ctx.frontBundleId = core.frontBundleId;
+      break;
+    case 'gesture': core._onGesture(m.g); break;
+    case 'call': if (typeof core[m.m] === 'function') core[m.m](...(m.a || [])); break;
+    case 'stop':
+      running = false;
+      core.stopCore();
+      io.flush();
+      parentPort.close();
+      break;
+    default: break;
+  }
+});
+
+(async () => {
+  await core.run(core.ctx);
+  core._animate();
+  post({ t: 'ready' });
+  await loop();
+})().catch((e) => post({ t: 'error', e: String(e && e.stack || e) }));
@@ -0,0 +1,53 @@
+// src/worker/index.js
+// Main-thread handle for the gesture worker (LEAP_GESTURE_WORKER=1).
+// Frames go in through the shared frame channel; command batches come back and are
+// applied by the actuator. HUD/calibration/save messages are forwarded to the engine.
+const path = require('path');
+const { Worker } = require('worker_threads');
+const { channelBytes, createFrameWriter } = require('./frameChannel');
+const { createActuator } = require('./actuator');
+const { DEFAULT_BOUNDS } = require('../core/interactionBox');
+
+function createGestureWorker(engine, {
+  maxHands = 2,
+  mmBounds = DEFAULT_BOUNDS,
+  animIntervalMs = 4,
+  script = path.join(__dirname, 'gestureWorker.js'),
+} = {}) {
+  const sab = new SharedArrayBuffer(channelBytes(maxHands));
+  const writer = createFrameWriter(sab, maxHands);
+  const actuator = createActuator(engine.io, { profiles: engine.profiles });
+
+  const worker = new Worker(script, {
+    workerData: {
+      sab, maxHands, mmBounds, animIntervalMs,
+      persisted: engine.persistedSnapshot(),
+      userDataPath: engine.userDataPath, helperPath: engine.helperPath,
+      profile: engine.profiles.current(), profiles: engine.profiles.data?.profiles || {},
+    },
+  });
+
+  worker.on('message', (m) => {
+    switch (m.t) {
+      case 'cmd': actuator.apply(m.c); break;
+      case 'hud': engine.onHUD(m.p); break;
+      case 'cal': engine.onCalState(m.p); break;
+      case 'save': engine.onSave(m.p); break;
+      case 'error': console.error('[gesture-worker]', m.e); engine._tutor('Gesture worker error'); break;
+      default: break;
+    }
+  });
+  worker.on('error', (e) => { console.error('[gesture-worker]', e); engine._tutor('Gesture worker error'); });
+
+  const post = (m) => worker.postMessage(m);
+
+  return {
+    pushFrame: (frame) => writer.write(frame),
+    post,
+    call: (m, ...a) => post({ t: 'call', m, a }),
+    stats: () => ({ ...actuator.stats }),
+    terminate: () => { try { post({ t: 'stop' }); } catch {} return worker.terminate(); },
+  };
+}
+
+module.exports = { createGestureWorker };
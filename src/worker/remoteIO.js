@@ -0,0 +1,70 @@
+// src/worker/remoteIO.js
+// Actuation surface for the gesture worker. Same shape as adapters/io (+ window ops)
+// as seen through ctx, but every call only appends a compact command; the batch is
+// posted to the main thread once per event-loop turn (i.e. once per frame / tick), or
+// once every `tickMs` when set (src/adapters/inject.js batches main-thread output this way).
+//
+// Commands (arrays, first element = opcode):
+//   ['m', x, y]          move cursor (absolute px)      — consecutive moves coalesce
+//   ['s', dx, dy]        scroll (dy > 0 = up)          — consecutive scrolls sum
+//   ['c'|'d'|'u', btn]   click / press / release        — btn = Button name
+//   ['kd'|'ku', key]     key down / up                  — key = Key name
+//   ['k', [keys]]        key chord
+//   ['w', op, a, b]      window op: 'move' dx dy | 'resize' dw dh | 'snap' which
+//   ['b', binding]       profile binding (runs on main with the real Profiles)
+
+const names = (list) => Object.freeze(Object.fromEntries(list.map(k => [k, k])));
+
+// Key/Button resolve to their own names; main maps them onto the real enums
+const Key = new Proxy({}, { get: (_, k) => (typeof k === 'string' ? k : undefined) });
+const Button = names(['LEFT', 'RIGHT', 'MIDDLE']);
+
+function Point(x, y) { this.x = x; this.y = y; }
+
+function createRemoteIO(post, { tickMs = 0 } = {}) {
+  let batch = [];
+  let scheduled = false;
+  let last = { x: 0, y: 0 };
+
+  function flush() {
+    scheduled = false;
+    if (!batch.length) return;
+    const c = batch;
+    batch = [];
+    post({ t: 'cmd', c });
+  }
+
+  function push(cmd) {
+    const prev = batch[batch.length - 1];
+    if (prev && prev[0] === cmd[0] && cmd[0] === 'm') { prev[1] = cmd[1]; prev[2] = cmd[2]; }
+    else if (prev && prev[0] === cmd[0] && cmd[0] === 's') { prev[1] += cmd[1]; prev[2] += cmd[2]; }
+    else batch.push(cmd);
+    if (!scheduled) { scheduled = true; if (tickMs > 0) setTimeout(flush, tickMs); else setImmediate(flush); }
+  }
+
+  const mouse = {
+    setPosition: (p) => { last = { x: p.x, y: p.y }; push(['m', p.x, p.y]); },
+    getPosition: async () => ({ ...last }),
+    click: (b) => push(['c', b]),
+    pressButton: (b) => push(['d', b]),
+    releaseButton: (b) => push(['u', b]),
+    scrollUp: (n) => push(['s', 0, Math.abs(n)]),
+    scrollDown: (n) => push(['s', 0, -Math.abs(n)]),
+    scrollLeft: (n) => push(['s', -Math.abs(n), 0]),
+    scrollRight: (n) => push(['s', Math.abs(n), 0]),
+  };
+
+  return {
+    mouse,
+    keyboard: { pressKey: (k) => push(['kd', k]), releaseKey: (k) => push(['ku', k]) },
+    Key, Button, Point, screen: {},
+    keyChord: (keys) => push(['k', keys.slice()]),
+    moveWindow: (dx, dy) => push(['w', 'move', dx, dy]),
+    resizeWindow: (dw, dh) => push(['w', 'resize', dw, dh]),
+    snapWindow: (which) => push(['w', 'snap', which]),
+    runBinding: (binding) => push(['b', binding]),
+    flush,
+  };
+}
+
+module.exports = { createRemoteIO };
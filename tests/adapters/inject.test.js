@@ -0,0 +1,59 @@
+const fs = require('fs');
+const os = require('os');
+const path = require('path');
+const { createBatchedIO, axwinBackend, createRecordingBackend, encodeBatch } = require('../../src/adapters/inject');
+
+const turn = () => new Promise(r => setImmediate(r));
+const wait = (ms) => new Promise(r => setTimeout(r, ms));
+
+describe('batched injection', () => {
+  test('one batch per tick: moves coalesce, scrolls sum, order is kept', async () => {
+    const rec = createRecordingBackend();
+    const io = createBatchedIO(rec, { tickMs: 4 });
+    // cursor smoothing runs every turn; within a tick only the last point goes out
+    for (let i = 1; i <= 5; i++) { io.mouse.setPosition(new io.Point(i, 2 * i)); await turn(); }
+    io.mouse.scrollUp(3); io.mouse.scrollDown(1);
+    io.keyboard.pressKey(io.Key.LeftSuper);
+    io.mouse.scrollUp(2);
+    io.keyboard.releaseKey(io.Key.LeftSuper);
+    io.keyChord(['LeftControl', 'Up']);
+    io.snapWindow('left');
+    await wait(10);
+    expect(rec.batches).toHaveLength(1);
+    expect(rec.batches[0]).toEqual([
+      ['m', 5, 10], ['s', 0, 2], ['kd', 'LeftSuper'], ['s', 0, 2], ['ku', 'LeftSuper'], ['k', ['LeftControl', 'Up']], ['w', 'snap', 'left'],
+    ]);
+    io.mouse.click(io.Button.LEFT);
+    await wait(10);
+    expect(rec.batches[1]).toEqual([['c', 'LEFT']]);
+  });
+
+  test('helper lines', () => {
+    expect(encodeBatch([['m', 10.4, 20.6], ['s', 0.7, -2], ['d', 'LEFT'], ['k', ['LeftSuper', 'L']], ['w', 'move', 3, -4], ['s', 0, 0.5]]))
+      .toBe('m 10 21\ns 0 -2\nd LEFT\nk LeftSuper+L\nw move 3 -4\n');
+  });
+
+  test('a persistent helper gets each batch as one write; a missing one falls back', async () => {
+    const dir = fs.mkdtempSync(path.join(os.tmpdir(), 'inject-'));
+    const out = path.join(dir, 'lines'), helper = path.join(dir, 'axwin');
+    fs.writeFileSync(helper, `#!/bin/sh\n[ "$1" = inject ] || exit 1\necho start >> "${out}"\nexec cat >> "${out}"\n`, { mode: 0o755 });
+    const be = axwinBackend(helper);
+    be.post([['m', 1, 2], ['c', 'LEFT']]);
+    be.post([['k', ['LeftControl', 'Right']]]);
+    await wait(200);
+    be.stop();
+    await wait(100);
+    expect(fs.readFileSync(out, 'utf8')).toBe('start\nm 1 2\nc LEFT\nk LeftControl+Right\n');
+    expect(be.stats.writes).toBe(2);
+
+    const fallback = createRecordingBackend();
+    const missing = axwinBackend(path.join(dir, 'nope'), { fallback });
+    // posted before the spawn fails: replayed on the fallback, the release included
+    missing.post([['d', 'LEFT'], ['m', 1, 1]]);
+    missing.post([['u', 'LEFT']]);
+    await wait(50);
+    missing.post([['m', 3, 3]]);
+    expect(missing.stats.fellBack).toBe(true);
+    expect(fallback.commands()).toEqual([['d', 'LEFT'], ['m', 1, 1], ['u', 'LEFT'], ['m', 3, 3]]);
+  });
+});
@@ -0,0 +1,74 @@
+// Bytes allocated per frame by the LeapC bridge hand mapping: legacy object mapper vs pooled views.
+const { createFramePool } = require('../../src/bridges/frameView');
+const { bytesPerOp, timePerOp, gcCount, report } = require('../helpers/bench');
+
+// Baseline: the mapper the bridge used before frameView.js (fresh objects per hand per frame).
+function mapHandLegacy(raw) {
+  const order = ['thumb', 'index', 'middle', 'ring', 'pinky'];
+  const mkTip = (name) => {
+    const tip = raw.fingers?.[name];
+    if (Array.isArray(tip) && tip.length >= 3) return [tip[0], tip[1], tip[2]];
+    const p = raw.palmPosition || [0, 0, 0];
+    return [p[0], p[1], p[2]];
+  };
+  const mkExt = (name) => (raw.fingerExtended && Object.prototype.hasOwnProperty.call(raw.fingerExtended, name))
+    ? !!raw.fingerExtended[name] : false;
+  const fingers = order.map((name) => ({
+    type: name === 'thumb' ? 0 : name === 'index' ? 1 : name === 'middle' ? 2 : name === 'ring' ? 3 : 4,
+    stabilizedTipPosition: mkTip(name),
+    extended: mkExt(name),
+  }));
+  return {
+    id: raw.id, type: raw.type === 'left' ? 0 : 1,
+    palmPosition: raw.palmPosition || [0, 0, 0],
+    palmVelocity: raw.palmVel || [0, 0, 0],
+    palmStabilized: raw.palmStab || raw.palmPosition || [0, 0, 0],
+    palmQuaternion: raw.palmQuat || [0, 0, 0, 1],
+    pinchDistance: typeof raw.pinchDistance === 'number' ? raw.pinchDistance : 0,
+    grabAngle: typeof raw.grabAngle === 'number' ? raw.grabAngle : 0,
+    pinchStrength: typeof raw.pinch === 'number' ? raw.pinch : 0,
+    grabStrength: typeof raw.grab === 'number' ? raw.grab : 0,
+    indexFinger: { stabilizedTipPosition: mkTip('index') },
+    fingers,
+  };
+}
+function legacyFrame(msg, iBox) {
+  const hands = Array.isArray(msg.hands) ? msg.hands.map(mapHandLegacy) : [];
+  return { type: 'frame', id: msg.frameId, hands, interactionBox: iBox, fps: msg.framerate };
+}
+
+const hand = (id, type) => ({
+  id, type, palmPosition: [12.5, 180.2, -20.1], grab: 0.1, pinch: 0.3, pinchDistance: 40.2, grabAngle: 0.5,
+  palmStab: [12.4, 180.0, -20.0], palmVel: [120, -30, 4], palmQuat: [0.1, 0.2, 0.3, 0.9],
+  fingers: { thumb: [1, 2, 3], index: [4, 5, 6], middle: [7, 8, 9], ring: [10, 11, 12], pinky: [13, 14, 15] },
+  fingerExtended: { thumb: true, index: true, middle: false, ring: false, pinky: false },
+});
+const msg = { frameId: 1, framerate: 120, hands: [hand(1, 'left'), hand(2, 'right')] };
+const line = JSON.stringify(msg);
+
+describe('bridge allocation (2 hands / frame)', () => {
+  test('pooled frame views allocate less than the legacy mapper', async () => {
+    const pool = createFramePool();
+    let sink = 0;
+    const legacy = () => { sink += legacyFrame(msg).hands.length; };
+    const pooled = () => { sink += pool.fill(msg).hands.length; };
+    const legacyE2E = () => { sink += legacyFrame(JSON.parse(line)).hands.length; };
+    const pooledE2E = () => { sink += pool.fill(JSON.parse(line)).hands.length; };
+
+    const rows = [
+      { path: 'map only  legacy', bytesPerFrame: bytesPerOp(legacy).toFixed(0), nsPerFrame: timePerOp(legacy).toFixed(0) },
+      { path: 'map only  pooled', bytesPerFrame: bytesPerOp(pooled).toFixed(0), nsPerFrame: timePerOp(pooled).toFixed(0) },
+      { path: 'parse+map legacy', bytesPerFrame: bytesPerOp(legacyE2E).toFixed(0), nsPerFrame: timePerOp(legacyE2E).toFixed(0) },
+      { path: 'parse+map pooled', bytesPerFrame: bytesPerOp(pooledE2E).toFixed(0), nsPerFrame: timePerOp(pooledE2E).toFixed(0) },
+    ];
+    const gcLegacy = await gcCount(legacyE2E, 100000);
+    const gcPooled = await gcCount(pooledE2E, 100000);
+    rows.push({ path: 'GCs / 100k frames legacy', minor: gcLegacy.minor, major: gcLegacy.major });
+    rows.push({ path: 'GCs / 100k frames pooled', minor: gcPooled.minor, major: gcPooled.major });
+    report('bridge allocation (2 hands / frame)', rows);
+
+    expect(sink).toBeGreaterThan(0);
+    expect(Number(rows[1].bytesPerFrame)).toBeLessThan(Number(rows[0].bytesPerFrame));
+    expect(Number(rows[3].bytesPerFrame)).toBeLessThan(Number(rows[2].bytesPerFrame));
+  });
+});
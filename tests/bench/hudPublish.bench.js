@@ -0,0 +1,64 @@
+// HUD IPC: one message per engine patch (previous main.js) vs the diffed publisher
+// pulled by the renderer's requestAnimationFrame, with and without compact numbers.
+// Serialization is v8.serialize, the structured clone Electron IPC runs per message.
+const v8 = require('v8');
+const { createHudPublisher } = require('../../src/core/hudPublisher');
+const { report } = require('../helpers/bench');
+
+const ENGINE_HZ = 120, HUD_HZ = 60, SECONDS = 10;
+
+// What GestureCore._onFrame sends: a hand drifting, mostly unchanged flags and profile
+function payload(i) {
+  return {
+    hands: 1, ext: 2 + ((i >> 7) & 1), pinch: +(0.3 + 0.2 * Math.sin(i / 40)).toFixed(2), grab: 0.05,
+    x: Math.round(600 + 300 * Math.sin(i / 90)), y: Math.round(400 + 200 * Math.cos(i / 70)),
+    windowMode: 'none', dragging: false, calStep: 'idle', displayId: 1, gcr: null,
+    profile: { name: 'Default', app: 'com.apple.Safari' },
+    sched: { q: 0, qMax: 3, dropped: 0, coalesced: 12, ms: +(1 + 0.1 * ((i >> 4) & 3)).toFixed(1), maxMs: 6.2 },
+  };
+}
+
+function run(publish) {
+  let messages = 0, bytes = 0, ns = 0;
+  const send = (p) => {
+    const t0 = process.hrtime.bigint();
+    const buf = v8.serialize(p);
+    ns += Number(process.hrtime.bigint() - t0);
+    messages++; bytes += buf.length;
+  };
+  const t0 = process.hrtime.bigint();
+  publish(send);
+  const totalNs = Number(process.hrtime.bigint() - t0);
+  const frames = ENGINE_HZ * SECONDS;
+  return {
+    msgsPerSec: (messages / SECONDS).toFixed(0),
+    bytesPerSec: (bytes / SECONDS).toFixed(0),
+    serializeUsPerSec: (ns / 1e3 / SECONDS).toFixed(0),
+    mainUsPerFrame: (totalNs / 1e3 / frames).toFixed(2),
+  };
+}
+
+describe('HUD update channel', () => {
+  test('per-patch IPC vs diffed rAF-pulled publisher', () => {
+    const frames = ENGINE_HZ * SECONDS, perHud = ENGINE_HZ / HUD_HZ;
+    const perPatch = () => run((send) => { for (let i = 0; i < frames; i++) send(payload(i)); });
+    perPatch();
+    const direct = perPatch();
+    const diffed = (compact) => run((send) => {
+      const pub = createHudPublisher({ send, compact });
+      for (let i = 0; i < frames; i++) {
+        pub.patch(payload(i));
+        if (i % perHud === perHud - 1) pub.ready();   // renderer drew a frame
+      }
+    });
+    diffed(false); diffed(true);   // warm-up
+    const plain = diffed(false), compact = diffed(true);
+    report(`HUD IPC (${ENGINE_HZ} Hz engine, ${HUD_HZ} Hz HUD, per second)`, [
+      { mode: 'per patch', ...direct },
+      { mode: 'diffed', ...plain },
+      { mode: 'diffed+compact', ...compact },
+    ]);
+    expect(Number(plain.msgsPerSec)).toBeLessThanOrEqual(HUD_HZ);
+    expect(Number(plain.bytesPerSec)).toBeLessThan(Number(direct.bytesPerSec) / 2);
+  });
+});
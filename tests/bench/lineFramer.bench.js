@@ -0,0 +1,69 @@
+// Burst framing cost: legacy string split vs Buffer line framer (all frames / latest-wins).
+const { createLineFramer } = require('../../src/bridges/lineFramer');
+const { timePerOp, report } = require('../helpers/bench');
+
+const hand = (id, type) => ({
+  id, type, palmPosition: [12.5, 180.2, -20.1], grab: 0.1, pinch: 0.3, pinchDistance: 40.2, grabAngle: 0.5,
+  palmStab: [12.4, 180.0, -20.0], palmVel: [120, -30, 4], palmQuat: [0.1, 0.2, 0.3, 0.9],
+  fingers: { thumb: [1, 2, 3], index: [4, 5, 6], middle: [7, 8, 9], ring: [10, 11, 12], pinky: [13, 14, 15] },
+  fingerExtended: { thumb: true, index: true, middle: false, ring: false, pinky: false },
+});
+const line = (id) => JSON.stringify({ frameId: id, framerate: 120, hands: [hand(1, 'left'), hand(2, 'right')] }).replace('{"frameId":', '{"frameId": ') + '\n';
+
+// Socket reads cut the stream at arbitrary offsets
+function chunked(text, size) {
+  const all = Buffer.from(text), out = [];
+  for (let i = 0; i < all.length; i += size) out.push(all.subarray(i, i + size));
+  return out;
+}
+
+// Baseline: the bridge's previous data handler
+function legacyFramer(onMsg) {
+  let buf = '';
+  return (data) => {
+    buf += data.toString('utf8');
+    const parts = buf.split('\n');
+    buf = parts.pop();
+    for (const l of parts) { if (!l) continue; try { onMsg(JSON.parse(l)); } catch {} }
+  };
+}
+
+describe('line framing under bursts', () => {
+  test('framer vs legacy split', () => {
+    let sink = 0;
+    const onMsg = (m) => { sink += m.frameId || 1; };
+    const onRecord = (b, s, e) => onMsg(JSON.parse(b.toString('utf8', s, e)));
+    const rows = [];
+
+    // N queued frames drained in 64 KiB reads (consumer stalled for N/120 s)
+    for (const n of [1, 10, 100, 1000]) {
+      let text = '';
+      for (let i = 0; i < n; i++) text += line(i + 1);
+      const chunks = chunked(text, 64 * 1024);
+      const run = (push) => () => { for (const c of chunks) push(c); };
+      const legacy = legacyFramer(onMsg);
+      const all = createLineFramer({ onRecord });
+      const lw = createLineFramer({ onRecord, latestWins: true });
+      const iters = Math.max(50, 20000 / n);
+      rows.push({
+        burst: n,
+        legacyUs: (timePerOp(run(legacy), iters) / 1e3).toFixed(1),
+        framerUs: (timePerOp(run(all.push), iters) / 1e3).toFixed(1),
+        latestWinsUs: (timePerOp(run(lw.push), iters) / 1e3).toFixed(1),
+      });
+    }
+
+    // One 256 KiB record trickling in as 1 KiB reads: the string remainder is re-copied
+    // and re-split on every read (quadratic) vs appended once to the framer's tail
+    const big = '{"type": "blob", "pad": "' + 'x'.repeat(256 * 1024) + '"}\n';
+    const trickle = chunked(big, 1024);
+    const legacyBig = () => { const f = legacyFramer(onMsg); for (const c of trickle) f(c); };
+    const framerBig = () => { const f = createLineFramer({ onRecord: () => { sink++; } }); for (const c of trickle) f.push(c); };
+    rows.push({ burst: '256KiB/1KiB reads', legacyUs: (timePerOp(legacyBig, 5) / 1e3).toFixed(1), framerUs: (timePerOp(framerBig, 5) / 1e3).toFixed(1) });
+
+    report('line framing (2 hands / frame, incl. JSON.parse)', rows);
+    expect(sink).toBeGreaterThan(0);
+    const r1000 = rows[3];
+    expect(Number(r1000.latestWinsUs)).toBeLessThan(Number(r1000.legacyUs));
+  });
+});
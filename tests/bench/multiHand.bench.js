@@ -0,0 +1,49 @@
+// Engine cost per tracking frame (GestureCore._onFrame, the composed middleware and the
+// hand tracker) with one hand, with two (listed in alternating order, the second one
+// idle), and with both hands in a two-hand pinch. Actuation is stubbed; frames come from
+// the bridge's pool, as in the app.
+const { createFramePool } = require('../../src/bridges/frameView');
+const { report, createBenchEngine, driftingHand } = require('../helpers/bench');
+
+const FRAMES = 20000, BUDGET_US = 1e6 / 120;
+
+async function run(make) {
+  const core = createBenchEngine();
+  await core.run(core.ctx);
+  const pool = createFramePool();
+  const recs = Array.from({ length: 512 }, (_, i) => make(i));
+  const frame = (i) => pool.fill({ frameId: i, ts: i * 8333, hands: recs[i & 511] });
+  for (let i = 0; i < 2000; i++) await core._onFrame(frame(i));    // warm-up
+  // best of three passes; only the handler is timed (filling the pool is the bridge's cost)
+  let best = Infinity;
+  for (let pass = 0; pass < 3; pass++) {
+    let ns = 0n;
+    for (let i = 0; i < FRAMES; i++) {
+      const f = frame(i);
+      const t0 = process.hrtime.bigint();
+      await core._onFrame(f);
+      ns += process.hrtime.bigint() - t0;
+    }
+    best = Math.min(best, Number(ns) / 1e3 / FRAMES);
+  }
+  core.stopCore();
+  return { hands: recs[0].length, usPerFrame: best.toFixed(1), budgetPct: (100 * best / BUDGET_US).toFixed(2) };
+}
+
+describe('multi-hand engine', () => {
+  test('per-frame cost: one hand vs two', async () => {
+    const right = (i, pinch) => driftingHand(i, { id: 1, type: 'right', x0: 40, pinch });
+    const left = (i, pinch) => driftingHand(i, { id: 2, type: 'left', x0: -80, pinch });
+    const one = await run((i) => [right(i)]);
+    const two = await run((i) => (i & 1 ? [right(i), left(i)] : [left(i), right(i)]));
+    const bi = await run((i) => [right(i, 0.95), left(i, 0.95)]);
+    report(`GestureCore._onFrame (${FRAMES} frames, budget ${BUDGET_US.toFixed(0)} us at 120 Hz)`, [
+      { mode: 'one hand', ...one },
+      { mode: 'two hands', ...two },
+      { mode: 'two-hand pinch', ...bi },
+    ]);
+    // one hand stays far below 1% of a 120 Hz frame; two hands (and the two-hand pinch)
+    // must too. (A few us apart, the modes are within run-to-run noise of each other.)
+    for (const r of [one, two, bi]) expect(Number(r.budgetPct)).toBeLessThan(1);
+  });
+});
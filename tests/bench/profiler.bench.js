@@ -0,0 +1,53 @@
+// Cost of the handler profiler (src/core/profiler.js): GestureCore._onFrame with the
+// profiler off and on, and what an always-installed wrapper (frame, cursor tick, bus)
+// adds to a call while off. Actuation is stubbed; frames come from the bridge's pool.
+const { createProfiler } = require('../../src/core/profiler');
+const { createFramePool } = require('../../src/bridges/frameView');
+const { report, timePerOp, createBenchEngine, driftingHand } = require('../helpers/bench');
+
+const FRAMES = 20000, BUDGET_US = 1e6 / 120;
+
+async function run(profile) {
+  const core = createBenchEngine({ profile });
+  await core.run(core.ctx);
+  const pool = createFramePool();
+  const recs = Array.from({ length: 512 }, (_, i) => [driftingHand(i)]);
+  const frame = (i) => pool.fill({ frameId: i, ts: i * 8333, hands: recs[i & 511] });
+  const onFrame = (f) => core.frames.handler(f);     // the scheduler's handler: profiler tick + frame wrapper
+  for (let i = 0; i < 2000; i++) await onFrame(frame(i));
+  let best = Infinity;
+  for (let pass = 0; pass < 3; pass++) {
+    let ns = 0n;
+    for (let i = 0; i < FRAMES; i++) {
+      const f = frame(i);
+      const t0 = process.hrtime.bigint();
+      await onFrame(f);
+      ns += process.hrtime.bigint() - t0;
+    }
+    best = Math.min(best, Number(ns) / 1e3 / FRAMES);
+  }
+  const series = core.prof.snapshot().length;
+  core.stopCore();
+  return { usPerFrame: best.toFixed(2), budgetPct: (100 * best / BUDGET_US).toFixed(2), series };
+}
+
+describe('profiler overhead', () => {
+  test('off vs on', async () => {
+    const off = await run(false);
+    const on = await run(true);
+    report(`GestureCore frame handler (${FRAMES} frames, budget ${BUDGET_US.toFixed(0)} us at 120 Hz)`, [
+      { profiler: 'off', ...off },
+      { profiler: 'on', ...on },
+    ]);
+
+    const fn = (a) => a + 1;
+    const wrapped = createProfiler().wrap('x', fn);
+    const raw = timePerOp((i) => fn(i), 2e6), idle = timePerOp((i) => wrapped(i), 2e6);
+    report('wrapper while off (ns/call)', [{ raw: raw.toFixed(1), wrapped: idle.toFixed(1), added: (idle - raw).toFixed(1) }]);
+
+    expect(off.series).toBe(0);                   // nothing recorded while off
+    expect(on.series).toBeGreaterThan(2);
+    expect(idle - raw).toBeLessThan(50);          // a flag check, not a timer read
+    expect(Number(on.budgetPct)).toBeLessThan(1);
+  });
+});
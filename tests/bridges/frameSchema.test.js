@@ -0,0 +1,171 @@
+const net = require('net');
+const { FIELD_BITS, ALL_FIELDS, HAND_FIELDS, decodeBinary, createDeltaDecoder, decodeRecord } = require('../../src/bridges/frameSchema');
+const { createFramePool } = require('../../src/bridges/frameView');
+const { createLeapCBridge } = require('../../src/bridges/leapc-tcp');
+
+// Little-endian writer for hand-built records (layout: cMiddleware/frame_schema.h)
+function writer() {
+  const dv = new DataView(new ArrayBuffer(4096));
+  let o = 0;
+  const w = {
+    u8: (v) => { dv.setUint8(o, v); o += 1; return w; },
+    u32: (v) => { dv.setUint32(o, v, true); o += 4; return w; },
+    i32: (...v) => { v.forEach(x => { dv.setInt32(o, x, true); o += 4; }); return w; },
+    f32: (...v) => { v.forEach(x => { dv.setFloat32(o, x, true); o += 4; }); return w; },
+    header: (mask, nHands, flags = 0, frameId = 42, ts = 1234567) => {
+      w.u32(mask); dv.setBigInt64(o, BigInt(frameId), true); o += 8;
+      dv.setBigInt64(o, BigInt(ts), true); o += 8;
+      return w.f32(120, -100, 100, 50, 350, -100, 100).u32(3).u8(nHands).u8(flags);
+    },
+    // delta records carry their sequence number after the header
+    delta: (mask, nHands, flags, seq, frameId) => w.header(mask, nHands, flags, frameId).u32(seq),
+    bytes: () => new Uint8Array(dv.buffer, 0, o),
+  };
+  return w;
+}
+
+const b64 = (bytes) => Buffer.from(bytes).toString('base64');
+const MASK = FIELD_BITS.id | FIELD_BITS.type | FIELD_BITS.pinch | FIELD_BITS.palmNorm | FIELD_BITS.screen | FIELD_BITS.fingerExtended;
+
+describe('frame schema decoders', () => {
+  test('field bits follow the schema order', () => {
+    expect(HAND_FIELDS[0]).toBe('id');
+    HAND_FIELDS.forEach((k, i) => expect(FIELD_BITS[k]).toBe(1 << i));
+    expect(ALL_FIELDS).toBe((1 << HAND_FIELDS.length) - 1);
+  });
+
+  test('binary records decode to the JSON shape and fill the pool', () => {
+    const w = writer().header(MASK, 2);
+    // hand 7: screen point present; hand 9: absent (NaN-filled)
+    w.u32(7).u8(1).f32(0.25).f32(0.5, 0.6, 0.7).f32(640, 360).u8(0b00010);
+    w.u32(9).u8(0).f32(0.75).f32(0.1, 0.2, 0.3).f32(NaN, NaN).u8(0b11111);
+    const rec = decodeBinary(w.bytes());
+
+    expect(rec).toMatchObject({ frameId: 42, ts: 1234567, displayId: 3, ibox: [-100, 100, 50, 350, -100, 100] });
+    const { palmNorm, ...rest } = rec.hands[0];
+    expect(rest).toEqual({
+      id: 7, type: 'right', pinch: 0.25, screen: [640, 360],
+      fingerExtended: { thumb: false, index: true, middle: false, ring: false, pinky: false },
+    });
+    expect(palmNorm[2]).toBeCloseTo(0.7);
+    expect(rec.hands[1].screen).toBeUndefined();
+    expect(rec.hands[1].fingerExtended.pinky).toBe(true);
+
+    const frame = createFramePool().fill(rec);
+    expect(frame.hands.map(h => h.id)).toEqual([7, 9]);
+    expect(frame.hands[0].pinchStrength).toBeCloseTo(0.25);
+    expect(frame.hands[0].palmStabilized.normalized[0]).toBeCloseTo(0.5);
+    expect(Array.from(frame.hands[0].screenPoint)).toEqual([640, 360]);
+    expect(frame.hands[1].screenPoint).toBeNull();
+    expect(frame.hands[1].fingers[4].extended).toBe(true);
+    expect(frame.heartbeat).toBe(false);
+  });
+
+  test('the heartbeat flag reaches the frame', () => {
+    const rec = decodeBinary(writer().header(FIELD_BITS.id, 0, 2).bytes());
+    expect(rec.heartbeat).toBe(true);
+    expect(createFramePool().fill(rec).heartbeat).toBe(true);
+    expect(createDeltaDecoder().decode(writer().delta(FIELD_BITS.id, 0, 3, 0).bytes()).heartbeat).toBe(true);
+  });
+
+  test('delta records apply changed fields over the last state', () => {
+    const dec = createDeltaDecoder();
+    const present = MASK & ~FIELD_BITS.screen;
+    const all = present & ~FIELD_BITS.id;
+
+    // keyframe: everything present is sent, quantized (pinch 10^-3, palmNorm 10^-4)
+    let w = writer().delta(MASK, 1, 1, 0);
+    w.u32(7).u32(present).u32(all).u8(1).i32(250).i32(5000, 6000, 7000).u8(0b00010);
+    let rec = dec.decode(w.bytes());
+    expect(rec.keyframe).toBe(true);
+    expect(rec.hands[0]).toEqual({
+      id: 7, type: 'right', pinch: 0.25, palmNorm: [0.5, 0.6, 0.7],
+      fingerExtended: { thumb: false, index: true, middle: false, ring: false, pinky: false },
+    });
+
+    // next: only pinch moved, and a screen point appeared
+    w = writer().delta(MASK, 1, 0, 1, 43);
+    w.u32(7).u32(present | FIELD_BITS.screen).u32(FIELD_BITS.pinch | FIELD_BITS.screen).i32(500).i32(6400, 3600);
+    rec = dec.decode(w.bytes());
+    expect(rec.hands[0]).toMatchObject({ pinch: 0.5, palmNorm: [0.5, 0.6, 0.7], screen: [640, 360] });
+
+    // screen point gone again: dropped from the hand
+    w = writer().delta(MASK, 1, 0, 2, 44);
+    w.u32(7).u32(present).u32(0);
+    rec = dec.decode(w.bytes());
+    expect(rec.hands[0].screen).toBeUndefined();
+    expect(rec.hands[0].pinch).toBe(0.5);
+  });
+
+  test('delta hands wait for a full record; missing hands are forgotten', () => {
+    const dec = createDeltaDecoder();
+    const present = FIELD_BITS.id | FIELD_BITS.pinch;
+    // joined mid-stream: hand 7 only sends what changed, so it is held back
+    let w = writer().delta(present, 1, 0, 30);
+    w.u32(7).u32(present).u32(0);
+    expect(dec.decode(w.bytes()).hands).toHaveLength(0);
+
+    w = writer().delta(present, 1, 1, 31);
+    w.u32(7).u32(present).u32(FIELD_BITS.pinch).i32(100);
+    expect(dec.decode(w.bytes()).hands).toEqual([{ id: 7, pinch: 0.1 }]);
+
+    // hand 7 leaves, then returns: it must be sent whole again
+    dec.decode(writer().delta(present, 0, 0, 32).bytes());
+    w = writer().delta(present, 1, 0, 33);
+    w.u32(7).u32(present).u32(0);
+    expect(dec.decode(w.bytes()).hands).toHaveLength(0);
+  });
+
+  test('a lost delta record voids the state until the next keyframe', () => {
+    const dec = createDeltaDecoder();
+    const present = FIELD_BITS.id | FIELD_BITS.pinch;
+    const pinch = (seq, flags, v) => {
+      const w = writer().delta(present, 1, flags, seq, 100 + seq);
+      return w.u32(7).u32(present).u32(FIELD_BITS.pinch).i32(v).bytes();
+    };
+    const same = (seq) => writer().delta(present, 1, 0, seq, 100 + seq).u32(7).u32(present).u32(0).bytes();
+
+    expect(dec.decode(pinch(0, 1, 100)).hands).toEqual([{ id: 7, pinch: 0.1 }]);
+    expect(dec.decode(pinch(1, 0, 200)).hands).toEqual([{ id: 7, pinch: 0.2 }]);
+    // seq 2 (pinch 0.3) never arrives: seq 3 only says "unchanged", which is no longer known
+    expect(dec.decode(same(3))).toBeNull();
+    expect(dec.decode(pinch(4, 0, 500))).toBeNull();
+    const rec = dec.decode(pinch(5, 1, 600));
+    expect(rec).toMatchObject({ frameId: 105, keyframe: true, hands: [{ id: 7, pinch: 0.6 }] });
+    expect(dec.decode(same(6)).hands).toEqual([{ id: 7, pinch: 0.6 }]);
+  });
+
+  test('decodeRecord unwraps the base64 line', () => {
+    const w = writer().header(FIELD_BITS.id, 1).u32(5);
+    expect(decodeRecord({ type: 'frameBin', enc: 'bin', data: b64(w.bytes()) }).hands).toEqual([{ id: 5 }]);
+    expect(decodeRecord({ type: 'frameBin', enc: 'zstd', data: '' })).toBeNull();
+  });
+
+  test('bridge swaps the JSON stream for the delta stream', async () => {
+    let bridge;
+    const lines = [];
+    const server = net.createServer((c) => {
+      c.setEncoding('utf8');
+      c.on('data', (d) => {
+        lines.push(...d.split('\n').filter(Boolean));
+        if (lines.length < 2) return;
+        const w = writer().delta(FIELD_BITS.id | FIELD_BITS.pinch, 1, 1, 0);
+        w.u32(12).u32(FIELD_BITS.id | FIELD_BITS.pinch).u32(FIELD_BITS.pinch).i32(800);
+        c.write(JSON.stringify({ type: 'frameBin', enc: 'delta', data: b64(w.bytes()) }) + '\n');
+      });
+    });
+    await new Promise(r => server.listen(0, '127.0.0.1', r));
+
+    const frame = await new Promise((resolve) => {
+      bridge = createLeapCBridge({ port: server.address().port, encoding: 'delta' });
+      bridge.on('frame', resolve);
+    });
+    expect(lines).toEqual(['subscribe delta', 'unsubscribe frames']);
+    expect(frame.id).toBe(42);
+    expect(frame.hands[0].id).toBe(12);
+    expect(frame.hands[0].pinchStrength).toBeCloseTo(0.8);
+
+    bridge.disconnect();
+    await new Promise(r => server.close(r));
+  });
+});
@@ -0,0 +1,121 @@
+const { createFramePool, createInteractionBox } = require('../../src/bridges/frameView');
+
+function rawHand(over = {}) {
+  return {
+    id: 7, type: 'left', palmPosition: [10, 200, -5],
+    grab: 0.25, pinch: 0.75, pinchDistance: 31.5, grabAngle: 0.4,
+    palmStab: [11, 201, -4], palmVel: [100, -50, 0], palmQuat: [0, 0, 0, 1],
+    fingers: { thumb: [1, 2, 3], index: [4, 5, 6], middle: [7, 8, 9], ring: [10, 11, 12], pinky: [13, 14, 15] },
+    fingerExtended: { thumb: false, index: true, middle: true, ring: false, pinky: false },
+    ...over,
+  };
+}
+
+describe('frameView', () => {
+  test('keeps the legacy hand shape', () => {
+    const pool = createFramePool();
+    const frame = pool.fill({ frameId: 42, framerate: 118.5, hands: [rawHand()] });
+
+    expect(frame.id).toBe(42);
+    expect(frame.fps).toBeCloseTo(118.5);
+    expect(frame.hands).toHaveLength(1);
+
+    const h = frame.hands[0];
+    expect(h.id).toBe(7);
+    expect(h.type).toBe(0);
+    expect(h.pinchStrength).toBeCloseTo(0.75);
+    expect(h.grabStrength).toBeCloseTo(0.25);
+    expect(Array.from(h.palmVelocity)).toEqual([100, -50, 0]);
+    expect(Array.from(h.stabilizedPalmPosition)).toEqual([11, 201, -4]);
+    expect(h.fingers.map(f => f.type)).toEqual([0, 1, 2, 3, 4]);
+    expect(h.fingers.filter(f => f.extended)).toHaveLength(2);
+    expect(Array.from(h.indexFinger.stabilizedTipPosition)).toEqual([4, 5, 6]);
+  });
+
+  test('missing tips fall back to the palm and flags clear on refill', () => {
+    const pool = createFramePool({ slots: 1 });
+    pool.fill({ frameId: 1, hands: [rawHand()] });
+    const frame = pool.fill({ frameId: 2, hands: [rawHand({ fingers: {}, fingerExtended: {} })] });
+    const h = frame.hands[0];
+    expect(Array.from(h.fingers[3].stabilizedTipPosition)).toEqual([10, 200, -5]);
+    expect(h.fingers.some(f => f.extended)).toBe(false);
+  });
+
+  test('reuses frame slots round-robin', () => {
+    const pool = createFramePool({ slots: 2 });
+    const a = pool.fill({ frameId: 1, hands: [rawHand()] });
+    const b = pool.fill({ frameId: 2, hands: [] });
+    const c = pool.fill({ frameId: 3, hands: [rawHand(), rawHand({ id: 8, type: 'right' })] });
+    expect(b).not.toBe(a);
+    expect(c).toBe(a);
+    expect(b.hands).toHaveLength(0);
+    expect(c.hands.map(h => h.id)).toEqual([7, 8]);
+    expect(c.hands[1].type).toBe(1);
+  });
+
+  test('retained frames are skipped when the ring wraps', () => {
+    const pool = createFramePool({ slots: 3 });
+    const a = pool.fill({ frameId: 1, hands: [] });
+    a.retain();
+    const seen = [2, 3, 4, 5].map(id => pool.fill({ frameId: id, hands: [] }));
+    expect(seen).not.toContain(a);
+    expect(a.id).toBe(1);
+    a.release();
+    expect([6, 7, 8].map(id => pool.fill({ frameId: id, hands: [] }))).toContain(a);
+  });
+
+  test('uses middleware orientation fields and exposes roll/pitch/yaw', () => {
+    const pool = createFramePool();
+    const h = pool.fill({ frameId: 1, hands: [rawHand({
+      roll: 0.3, pitch: -0.2, yaw: 0.1, palmNormal: [0.1, -0.9, 0], palmDir: [0, 0.2, -0.95], angVel: [0, 1.5, 0],
+    })] }).hands[0];
+    expect(h.roll()).toBeCloseTo(0.3);
+    expect(h.pitch()).toBeCloseTo(-0.2);
+    expect(h.yaw()).toBeCloseTo(0.1);
+    expect(Array.from(h.palmNormal)[1]).toBeCloseTo(-0.9);
+    expect(Array.from(h.angularVelocity)[1]).toBeCloseTo(1.5);
+  });
+
+  test('derives orientation from palmQuat for older middleware', () => {
+    const pool = createFramePool();
+    const a = 0.4; // rotation about +Z rolls the palm
+    const h = pool.fill({ frameId: 1, hands: [rawHand({ palmQuat: [0, 0, Math.sin(a / 2), Math.cos(a / 2)] })] }).hands[0];
+    expect(h.roll()).toBeCloseTo(a, 4);
+    expect(h.pitch()).toBeCloseTo(0, 4);
+    expect(Array.from(h.direction)[2]).toBeCloseTo(-1, 4);
+    expect(Array.from(h.angularVelocity)).toEqual([0, 0, 0]);
+  });
+
+  test('middleware-normalized points and the screen point are passed through', () => {
+    const box = createInteractionBox();
+    const pool = createFramePool({ interactionBox: box });
+    const f = pool.fill({ frameId: 1, ibox: [-100, 100, 50, 250, -100, 100], displayId: 3, hands: [rawHand({
+      palmNorm: [0.5, 0.6, 0.5], tipsNorm: [[0.1, 0.1, 0.1], [0.2, 0.3, 0.4], [0, 0, 0], [0, 0, 0], [0, 0, 0]], screen: [640, 360],
+    })] });
+    const h = f.hands[0];
+    expect(f.displayId).toBe(3);
+    expect(box.bounds.y).toEqual([50, 250]);
+    expect(box.normalizePoint(h.indexFinger.stabilizedTipPosition)[1]).toBeCloseTo(0.3, 5);
+    expect(box.normalizePoint(h.stabilizedPalmPosition)[1]).toBeCloseTo(0.6, 5);
+    expect(Array.from(h.screenPoint)).toEqual([640, 360]);
+  });
+
+  test('normalizes in JS for middleware without palmNorm and has no screen point', () => {
+    const box = createInteractionBox();
+    const pool = createFramePool({ interactionBox: box });
+    const h = pool.fill({ frameId: 1, hands: [rawHand({ fingers: { index: [0, 150, 60] } })] }).hands[0];
+    expect(pool.fill({ frameId: 2, hands: [] }).displayId).toBe(0);
+    expect(box.normalizePoint(h.indexFinger.stabilizedTipPosition)).toEqual([0.5, 0.5, 0.75]);
+    expect(h.screenPoint).toBeNull();
+  });
+
+  test('hand lifecycle fields: isNew and confidence, unknown for older middleware', () => {
+    const pool = createFramePool();
+    let h = pool.fill({ frameId: 1, hands: [rawHand({ isNew: true, confidence: 0.5 })] }).hands[0];
+    expect(h.isNew).toBe(true);
+    expect(h.confidence).toBeCloseTo(0.5);
+    h = pool.fill({ frameId: 2, hands: [rawHand()] }).hands[0];
+    expect(h.isNew).toBeUndefined();
+    expect(h.confidence).toBe(1);
+  });
+});
@@ -0,0 +1,57 @@
+const fs = require('fs');
+const os = require('os');
+const path = require('path');
+const { createImageReader } = require('../../src/bridges/imageChannel');
+
+const HDR = 64, SLOTS = 4, MAX_PIXELS = 4096, SLOT_BYTES = HDR + MAX_PIXELS;
+
+// Writes a pool file the way images.c lays it out
+function makePool(file) {
+  const b = Buffer.alloc(HDR + SLOTS * SLOT_BYTES);
+  b.write('ULMIMG01', 0, 'latin1');
+  b.writeUInt32LE(SLOTS, 8); b.writeUInt32LE(SLOT_BYTES, 12); b.writeUInt32LE(MAX_PIXELS, 16);
+  fs.writeFileSync(file, b);
+  const fd = fs.openSync(file, 'r+');
+  return {
+    publish(slot, seq, w, h, fill) {
+      const at = HDR + slot * SLOT_BYTES;
+      const hdr = Buffer.alloc(HDR);
+      hdr.writeUInt32LE(seq, 0); hdr.writeUInt32LE(w, 4); hdr.writeUInt32LE(h, 8);
+      hdr.writeUInt32LE(2, 12); hdr.writeUInt32LE(1, 16); hdr.writeUInt32LE(w * h * 2, 20);
+      fs.writeSync(fd, hdr, 0, HDR, at);
+      fs.writeSync(fd, Buffer.alloc(w * h * 2, fill), 0, w * h * 2, at + HDR);
+    },
+    close: () => fs.closeSync(fd),
+  };
+}
+
+describe('image channel', () => {
+  const file = path.join(os.tmpdir(), `ulm-images-${process.pid}.shm`);
+  afterAll(() => { try { fs.unlinkSync(file); } catch {} });
+
+  test('reads the notified slot from the pool file', () => {
+    const pool = makePool(file);
+    pool.publish(2, 4, 16, 8, 0x7f);
+    const reader = createImageReader({ path: file });
+    const img = reader.read({ type: 'image', frameId: 9, ts: 100, slot: 2, seq: 4 });
+    expect(img).toMatchObject({ id: 9, width: 16, height: 8, count: 2, bpp: 1 });
+    expect(img.pixels.length).toBe(16 * 8 * 2);
+    expect(img.pixels[100]).toBe(0x7f);
+    reader.close(); pool.close();
+  });
+
+  test('skips slots rewritten since the notification, and missing pools', () => {
+    const pool = makePool(file);
+    pool.publish(0, 6, 4, 4, 1);
+    const reader = createImageReader({ path: file });
+    expect(reader.read({ frameId: 1, slot: 0, seq: 4 })).toBeNull();  // already overwritten
+    pool.publish(0, 7, 4, 4, 1);                                       // odd: being written
+    expect(reader.read({ frameId: 2, slot: 0, seq: 6 })).toBeNull();
+    expect(reader.stats.torn).toBe(2);
+    reader.close(); pool.close();
+
+    const none = createImageReader({ path: file + '.missing' });
+    expect(none.read({ slot: 0, seq: 2 })).toBeNull();
+    expect(none.stats.missing).toBe(1);
+  });
+});
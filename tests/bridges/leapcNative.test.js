@@ -0,0 +1,94 @@
+const fs = require('fs');
+const path = require('path');
+const { FIELD_BITS } = require('../../src/bridges/frameSchema');
+const { createLeapCNative, loadAddon } = require('../../src/bridges/leapc-native');
+
+// Stand-in for cMiddleware/addon/leap_addon.c: one slot, records written by the test
+function mockAddon() {
+  const slotSize = 256;
+  const shared = { buffer: new ArrayBuffer(slotSize * 2), slotSize, slots: 2 };
+  const addon = {
+    lines: [],
+    start(options, onFrame) { addon.options = options; addon.onFrame = onFrame; return shared; },
+    stop() { addon.stopped = true; },
+    control(line) {
+      addon.lines.push(line);
+      if (line.startsWith('bogus')) return JSON.stringify({ type: 'error', error: 'unknown command' });
+      return JSON.stringify({ type: 'ack', ibox: [-10, 10, 0, 20, -10, 10] });
+    },
+    stats: () => JSON.stringify({ type: 'stats', frames: 3 }),
+    // writes one record (layout: frame_schema.h) into `slot` and hands it to JS
+    push(slot, handId, pinch) {
+      const dv = new DataView(shared.buffer, slot * slotSize, slotSize);
+      let o = 0;
+      dv.setUint32(o, FIELD_BITS.id | FIELD_BITS.pinch, true); o += 4;
+      dv.setBigInt64(o, 77n, true); o += 8;
+      dv.setBigInt64(o, 5_000_000n, true); o += 8;
+      [120, -100, 100, 50, 350, -100, 100].forEach(v => { dv.setFloat32(o, v, true); o += 4; });
+      dv.setUint32(o, 1, true); o += 4;
+      dv.setUint8(o++, 1); dv.setUint8(o++, 0);
+      dv.setUint32(o, handId, true); o += 4;
+      dv.setFloat32(o, pinch, true); o += 4;
+      addon.onFrame(slot, o, 0);
+    },
+  };
+  return addon;
+}
+
+const ADDON = process.env.LEAPC_ADDON || path.join(__dirname, '../../cMiddleware/build/leap_addon.node');
+// only where the addon was built against the fake device (-DULM_FAKE_LEAPC=ON)
+const withAddon = fs.existsSync(ADDON) ? test : test.skip;
+
+describe('in-process LeapC bridge', () => {
+  test('decodes shared slots into pooled frames', async () => {
+    const addon = mockAddon();
+    const bridge = createLeapCNative({ addon, fields: 'id,pinch' });
+    const frames = [];
+    bridge.on('frame', f => frames.push({ id: f.id, ts: f.timestamp, hand: f.hands[0].id, pinch: f.hands[0].pinchStrength }));
+    await new Promise(r => bridge.on('connect', r));
+
+    expect(addon.options).toEqual({ fields: 'id,pinch' });
+    addon.push(1, 5, 0.25);
+    addon.push(0, 6, 0.75);
+    expect(frames).toEqual([{ id: 77, ts: 5e6, hand: 5, pinch: 0.25 }, { id: 77, ts: 5e6, hand: 6, pinch: 0.75 }]);
+    expect(bridge.stats()).toEqual({ records: 2, coalesced: 0 });
+
+    bridge.disconnect();
+    expect(addon.stopped).toBe(true);
+    addon.push(0, 7, 0.5);
+    expect(frames).toHaveLength(2);
+  });
+
+  test('control commands go through the addon', () => {
+    const addon = mockAddon();
+    const bridge = createLeapCNative({ addon, ibox: [-1, 1, 0, 2, -1, 1] });
+    const errors = [], stats = [];
+    bridge.on('error', e => errors.push(e.message)).on('stats', s => stats.push(s));
+
+    bridge.calibrate(2, { w: 1920, h: 1080 });
+    bridge.selectDisplay(2);
+    bridge.requestStats();
+    expect(addon.lines).toEqual(['ibox -1 1 0 2 -1 1', 'calibrate 2 1920 1080 0 1 0 1', 'display 2']);
+    bridge.selectDisplay(0x80000001);       // CGDirectDisplayID is u32
+    expect(addon.lines.pop()).toBe('display 2147483649');
+    expect(stats).toEqual([{ type: 'stats', frames: 3 }]);
+
+    addon.control = () => JSON.stringify({ type: 'error', error: 'unknown command' });
+    bridge.setInteractionBox('auto');
+    expect(errors).toEqual(['[leapc] unknown command']);
+    bridge.disconnect();
+  });
+
+  withAddon('runs against the compiled addon and the fake device', async () => {
+    process.env.ULM_FAKE_HANDS = '2';
+    const bridge = createLeapCNative({ addon: loadAddon(ADDON) });
+    const frame = await new Promise((resolve, reject) => {
+      bridge.on('error', reject);
+      bridge.on('frame', f => { if (f.hands.length === 2) resolve({ n: f.hands.length, id: f.id, ts: f.timestamp }); });
+    });
+    expect(frame.n).toBe(2);
+    expect(frame.id).toBeGreaterThan(0);
+    expect(frame.ts).toBeGreaterThan(0);
+    bridge.disconnect();
+  });
+});
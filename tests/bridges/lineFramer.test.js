@@ -0,0 +1,42 @@
+const { createLineFramer } = require('../../src/bridges/lineFramer');
+
+const frame = (id) => `{"frameId": ${id}, "framerate": 120.0, "hands": []}\n`;
+const gesture = (id) => `{"type": "gesture", "frameId": ${id}, "label": "circle"}\n`;
+
+function collect(opts) {
+  const out = [];
+  const framer = createLineFramer({ ...opts, onRecord: (b, s, e) => out.push(JSON.parse(b.toString('utf8', s, e))) });
+  return { framer, out };
+}
+
+describe('lineFramer', () => {
+  test('reassembles records split across chunks at any byte', () => {
+    const text = frame(1) + gesture(1) + frame(2);
+    for (let cut = 1; cut < text.length; cut++) {
+      const { framer, out } = collect();
+      framer.push(Buffer.from(text.slice(0, cut)));
+      framer.push(Buffer.from(text.slice(cut)));
+      expect(out.map(m => m.type || m.frameId)).toEqual([1, 'gesture', 2]);
+    }
+  });
+
+  test('latest-wins keeps only the newest frame of a burst and every gesture', () => {
+    const { framer, out } = collect({ latestWins: true });
+    framer.push(Buffer.from(frame(1) + gesture(1) + frame(2) + frame(3) + gesture(3) + frame(4).slice(0, 5)));
+    expect(out.map(m => m.type || m.frameId)).toEqual(['gesture', 3, 'gesture']);
+    expect(framer.stats.dropped).toBe(2);
+
+    // the partial frame 4 is stale once frame 5 completes in the same read
+    framer.push(Buffer.from(frame(4).slice(5) + frame(5)));
+    expect(out.map(m => m.type || m.frameId).slice(3)).toEqual([5]);
+    expect(framer.stats.dropped).toBe(3);
+  });
+
+  test('oversized partial record is skipped up to its newline', () => {
+    const { framer, out } = collect({ maxRecordBytes: 16 });
+    framer.push(Buffer.from('{"frameId": 1, "pad": "' + 'x'.repeat(40)));
+    framer.push(Buffer.from('"}\n' + frame(2)));
+    expect(out.map(m => m.frameId)).toEqual([2]);
+    expect(framer.stats.overflows).toBe(1);
+  });
+});
@@ -0,0 +1,68 @@
+const net = require('net');
+const { createSkeletonDecoder, SKELETON_LAYOUT: { S, BONE } } = require('../../src/bridges/skeleton');
+const { createLeapCBridge } = require('../../src/bridges/leapc-tcp');
+
+// Packs hands the way skeleton.c does: header, arm, then digit-major bones
+function record(hands, frameId = 5) {
+  const f = new Float32Array(hands.length * S.STRIDE);
+  hands.forEach((h, i) => {
+    const o = i * S.STRIDE;
+    f[o + S.TYPE] = h.type; f[o + S.CONFIDENCE] = 0.9; f[o + S.PALM_WIDTH] = 80; f[o + S.EXTENDED] = 0b00110;
+    f[o + S.ARM + BONE.WIDTH] = 55;
+    for (let d = 0; d < 5; d++) for (let b = 0; b < 4; b++) {
+      const at = o + S.DIGITS + (d * 4 + b) * BONE.SIZE;
+      f.set([d, b, h.id], at + BONE.NEXT);
+      f[at + BONE.ROT + 3] = 1;
+    }
+  });
+  return {
+    type: 'skeleton', frameId, ts: 1000, stride: S.STRIDE, ids: hands.map(h => h.id),
+    data: Buffer.from(f.buffer).toString('base64'),
+  };
+}
+
+describe('skeleton stream', () => {
+  test('decodes every bone through fixed views', () => {
+    const dec = createSkeletonDecoder();
+    const s = dec.decode(record([{ id: 3, type: 0 }, { id: 9, type: 1 }]));
+    expect(s.id).toBe(5);
+    expect(s.hands.map(h => h.id)).toEqual([3, 9]);
+    const h = s.hands[1];
+    expect(h.type).toBe(1);
+    expect(h.confidence).toBeCloseTo(0.9);
+    expect(h.arm.width).toBe(55);
+    expect(Array.from(h.digits[4][3].nextJoint)).toEqual([4, 3, 9]);
+    expect(h.digits[2][1].rotation[3]).toBe(1);
+    expect([0, 1, 2, 3, 4].map(d => h.extended(d))).toEqual([false, true, true, false, false]);
+
+    // same objects next frame; mismatched layouts are refused
+    const again = dec.decode(record([{ id: 4, type: 0 }], 6));
+    expect(again.hands[0]).toBe(s.hands[0]);
+    expect(again.hands).toHaveLength(1);
+    expect(dec.decode({ ...record([]), stride: 12 })).toBeNull();
+  });
+
+  test('bridge subscribes on connect and emits skeleton records', async () => {
+    let bridge;
+    const lines = [];
+    const server = net.createServer((c) => {
+      c.setEncoding('utf8');
+      c.on('data', (d) => {
+        lines.push(...d.split('\n').filter(Boolean));
+        c.write(JSON.stringify({ type: 'ack', streams: ['frames', 'skeleton'] }) + '\n');
+        c.write(JSON.stringify(record([{ id: 11, type: 1 }])) + '\n');
+      });
+    });
+    await new Promise(r => server.listen(0, '127.0.0.1', r));
+
+    const got = await new Promise((resolve) => {
+      bridge = createLeapCBridge({ port: server.address().port, skeleton: true });
+      bridge.on('skeleton', (s) => resolve(s.hands.map(h => h.id)));
+    });
+    expect(lines).toEqual(['subscribe skeleton']);
+    expect(got).toEqual([11]);
+
+    bridge.disconnect();
+    await new Promise(r => server.close(r));
+  });
+});
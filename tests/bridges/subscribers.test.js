@@ -0,0 +1,71 @@
+const fs = require('fs');
+const net = require('net');
+const { spawn } = require('child_process');
+
+// LEAPC_MIDDLEWARE: a TCP middleware built against the fake device (-DULM_FAKE_LEAPC=ON);
+// it listens on its fixed port
+const MIDDLEWARE = process.env.LEAPC_MIDDLEWARE;
+const withMiddleware = MIDDLEWARE && fs.existsSync(MIDDLEWARE) ? test : test.skip;
+const PORT = 8000;
+
+const sleep = (ms) => new Promise((r) => setTimeout(r, ms));
+
+function connect() {
+  return new Promise((resolve, reject) => {
+    const s = net.connect(PORT, '127.0.0.1', () => resolve(s));
+    s.once('error', reject);
+  });
+}
+
+async function connectRetry(ms = 5000) {
+  const until = Date.now() + ms;
+  for (;;) {
+    try { return await connect(); } catch (e) { if (Date.now() > until) throw e; await sleep(50); }
+  }
+}
+
+// One "stats" reply on a reading client
+function stats(sock) {
+  return new Promise((resolve) => {
+    let buf = '';
+    const onData = (d) => {
+      buf += d;
+      for (const line of buf.split('\n')) {
+        if (!line.startsWith('{"type": "stats"')) continue;
+        try { sock.off('data', onData); resolve(JSON.parse(line)); return; } catch {}
+      }
+    };
+    sock.on('data', onData);
+    sock.write('stats\n');
+  });
+}
+
+describe('subscribers', () => {
+  withMiddleware('a client that stops reading misses whole records and stays connected', async () => {
+    const mw = spawn(MIDDLEWARE, ['--skeleton'], { env: { ...process.env, ULM_FAKE_HZ: '2000' }, stdio: 'ignore' });
+    try {
+      const slow = await connectRetry();
+      let closed = false, text = '';
+      slow.on('close', () => { closed = true; });
+      slow.on('data', (d) => { text += d; });
+      await sleep(200);
+      slow.pause();                       // stops reading: its socket buffers fill up
+
+      // held full for a few seconds: sends come up short as the buffer fills
+      await sleep(3000);
+      const ctl = await connect();
+      const me = (await stats(ctl)).clients.find((c) => c.id === 1);
+      slow.resume();
+      await sleep(1000);
+      expect(me).toBeDefined();
+      expect(me.dropped).toBeGreaterThan(0);
+      expect(closed).toBe(false);
+      const lines = text.slice(0, text.lastIndexOf('\n')).split('\n');
+      expect(lines.length).toBeGreaterThan(100);
+      for (const line of lines) expect(() => JSON.parse(line)).not.toThrow();
+      slow.destroy(); ctl.destroy();
+    } finally {
+      mw.kill();
+    }
+  }, 30000);
+});
@@ -0,0 +1,70 @@
+const FrameScheduler = require('../../src/core/frameScheduler');
+
+const tick = () => new Promise(r => setImmediate(r));
+
+describe('FrameScheduler', () => {
+  test('one handler at a time, newest pending frame wins', async () => {
+    const seen = [];
+    let active = 0, maxActive = 0;
+    let unblock;
+    const sched = new FrameScheduler(async (f) => {
+      active++; maxActive = Math.max(maxActive, active);
+      seen.push(f.id);
+      if (f.id === 1) await new Promise(r => { unblock = r; });
+      active--;
+    });
+
+    sched.push({ id: 1 });
+    for (let id = 2; id <= 5; id++) sched.push({ id });
+    unblock();
+    await tick(); await tick();
+
+    expect(seen).toEqual([1, 5]);
+    expect(maxActive).toBe(1);
+    expect(sched.stats.coalesced).toBe(3);
+    expect(sched.stats.maxDepth).toBe(4); // arrivals while frame 1 ran
+    expect(sched.stats.depth).toBe(0);    // frame 5 ran without backlog
+    expect(sched.stats.handled).toBe(2);
+  });
+
+  test('counts id gaps as dropped and keeps running after a handler throws', async () => {
+    const seen = [];
+    const sched = new FrameScheduler(async (f) => { seen.push(f.id); if (f.id === 1) throw new Error('boom'); }, { onError: () => {} });
+    sched.push({ id: 1 });
+    await tick();
+    sched.push({ id: 4 });
+    await tick();
+    expect(seen).toEqual([1, 4]);
+    expect(sched.stats.dropped).toBe(2);
+    expect(sched.hud()).toHaveProperty('coalesced', 0);
+  });
+
+  test('idle heartbeats reset the id gap instead of counting it', async () => {
+    const sched = new FrameScheduler(async () => {});
+    const feed = async (f) => { sched.push(f); await tick(); };
+    await feed({ id: 1 });
+    await feed({ id: 2 });
+    // idle: one heartbeat per second, the frames between them skipped by the middleware
+    await feed({ id: 3, heartbeat: true });
+    await feed({ id: 123, heartbeat: true });
+    await feed({ id: 243, heartbeat: true });
+    // a hand wakes it: the first full frame follows another skipped stretch
+    await feed({ id: 300 });
+    await feed({ id: 301 });
+    expect(sched.stats.dropped).toBe(0);
+    await feed({ id: 304 });
+    expect(sched.stats.dropped).toBe(2);
+  });
+
+  test('retains pooled frames while pending or in flight', async () => {
+    const mk = (id) => ({ id, refs: 0, retain() { this.refs++; }, release() { this.refs--; } });
+    let unblock;
+    const sched = new FrameScheduler(async (f) => { if (f.id === 1) await new Promise(r => { unblock = r; }); });
+    const f1 = mk(1), f2 = mk(2), f3 = mk(3);
+    sched.push(f1); sched.push(f2); sched.push(f3);
+    expect([f1.refs, f2.refs, f3.refs]).toEqual([1, 0, 1]);
+    unblock();
+    await tick(); await tick();
+    expect([f1.refs, f2.refs, f3.refs]).toEqual([0, 0, 0]);
+  });
+});
@@ -0,0 +1,68 @@
+const { createHandTracker } = require('../../src/core/hands');
+
+const box = { normalizePoint: (p) => p };
+const hand = (id, type, x = 0.5, y = 0.5) => ({ id, type, pinchStrength: 0, palmVelocity: [3, 4, 0], stabilizedPalmPosition: [x, y, 0] });
+
+describe('hand tracker', () => {
+  test('primary hand follows the policy, not LeapC order', () => {
+    const hands = createHandTracker();
+    const L = hand(1, 'left'), R = hand(2, 'right');
+    expect(hands.update([L, R], 0, box, 'right').primary.id).toBe(2);
+    expect(hands.update([R, L], 16, box, 'right').primary.id).toBe(2);
+    expect(hands.update([R, L], 32, box, 'right').secondary.id).toBe(1);
+    expect(hands.update([L, R], 48, box, 'left').primary.id).toBe(1);
+  });
+
+  test("'first' keeps the longest-tracked hand while it stays", () => {
+    const hands = createHandTracker();
+    hands.update([hand(5, 'right')], 0, box, 'first');
+    let sel = hands.update([hand(9, 'left'), hand(5, 'right')], 16, box, 'first');
+    expect(sel.primary.id).toBe(5);
+    expect(sel.changed).toBe(false);
+    sel = hands.update([hand(9, 'left')], 32, box, 'first');
+    expect(sel.primary.id).toBe(9);
+    expect(sel.changed).toBe(true);
+    expect(sel.secondary).toBeNull();
+  });
+
+  test('each hand keeps its own lock and state; slices are recycled', () => {
+    const hands = createHandTracker();
+    const sel = hands.update([hand(1, 'left', 0.2), hand(2, 'right', 0.8)], 0, box, 'right');
+    sel.primary.gcr.acquire('scroll', 2);
+    expect(hands.get(1).gcr.current()).toBeNull();
+    expect(hands.get(2).gcr.current()).toBe('scroll');
+    expect(hands.get(2).palmVel).toBe(5);
+    expect(hands.get(1).nx).toBeCloseTo(0.2);
+
+    // smoothing is per hand
+    hands.update([hand(1, 'left', 0.4), hand(2, 'right', 0.8)], 16, box, 'right', 0.5);
+    expect(hands.get(1).nx).toBeCloseTo(0.3);
+    expect(hands.get(2).nx).toBeCloseTo(0.8);
+
+    // hand 2 leaves; a new hand reuses its slice with a fresh lock
+    const slice = hands.get(2);
+    hands.update([hand(1, 'left')], 32, box, 'right');
+    const next = hands.update([hand(1, 'left'), hand(3, 'right')], 48, box, 'right');
+    expect(next.primary).toBe(slice);
+    expect(next.primary.id).toBe(3);
+    expect(next.primary.gcr.current()).toBeNull();
+    expect(next.changed).toBe(true);
+  });
+
+  test('a hand is entering for its first frames: middleware isNew, else its own count', () => {
+    const hands = createHandTracker({ entryFrames: 2 });
+    const ages = [];
+    for (let i = 0; i < 4; i++) ages.push(hands.update([hand(1, 'right')], i * 8, box).primary.entering);
+    expect(ages).toEqual([true, true, false, false]);
+
+    // a re-entering hand starts over; the middleware's flag wins over the count
+    hands.update([], 40, box);
+    let s = hands.update([hand(1, 'right')], 48, box).primary;
+    expect(s.frames).toBe(1);
+    expect(s.entering).toBe(true);
+    expect(s.confidence).toBe(1);
+    s = hands.update([{ ...hand(1, 'right'), isNew: false, confidence: 0.4 }], 56, box).primary;
+    expect(s.entering).toBe(false);
+    expect(s.confidence).toBe(0.4);
+  });
+});
@@ -0,0 +1,83 @@
+const { createHudPublisher, expandHudPatch, HOT_FIELDS } = require('../../src/core/hudPublisher');
+
+const frame = (i) => ({
+  hands: 1, ext: 2, pinch: 0.25, grab: 0, x: 100 + i, y: 200,
+  windowMode: 'none', dragging: false, profile: { name: 'Default' }, sched: { q: 0, ms: 1.2 },
+});
+
+describe('HUD publisher', () => {
+  test('sends changed fields only, one message per ready()', () => {
+    const sent = [];
+    const pub = createHudPublisher({ send: (p) => sent.push(p) });
+
+    pub.patch(frame(0));
+    expect(sent).toHaveLength(1);
+    expect(sent[0]).toEqual(frame(0));
+
+    // renderer hasn't drawn yet: everything piles up
+    for (let i = 1; i <= 5; i++) pub.patch(frame(i));
+    pub.patch({ trainer: { label: 'circle' } });
+    pub.patch({ trainer: { recording: true } });
+    expect(sent).toHaveLength(1);
+
+    pub.ready();
+    expect(sent).toHaveLength(2);
+    expect(sent[1]).toEqual({ x: 105, trainer: { label: 'circle', recording: true } });
+
+    // nothing changed: ready() sends nothing and the next change goes out at once
+    pub.patch(frame(5));
+    pub.ready();
+    expect(sent).toHaveLength(2);
+    pub.patch({ sched: { q: 1, ms: 1.2 } });
+    expect(sent[2]).toEqual({ sched: { q: 1, ms: 1.2 } });
+    expect(pub.stats()).toMatchObject({ patches: 10, messages: 3 });
+  });
+
+  test('every toast is delivered, even repeated ones', () => {
+    const sent = [];
+    const pub = createHudPublisher({ send: (p) => sent.push(p) });
+    pub.patch({ tutor: 'Saved' });
+    pub.patch({ tutor: 'Saved' });
+    pub.patch({ tutor: 'Launchpad' });
+    pub.ready();
+    expect(sent).toEqual([{ tutor: 'Saved' }, { tutor: ['Saved', 'Launchpad'] }]);
+  });
+
+  test('a renderer that never answers is sent to again after staleMs', () => {
+    let t = 0;
+    const sent = [];
+    const pub = createHudPublisher({ send: (p) => sent.push(p), staleMs: 1000, now: () => t });
+    pub.patch({ x: 1 });
+    t = 500; pub.patch({ x: 2 });
+    expect(sent).toHaveLength(1);
+    t = 1600; pub.patch({ x: 3 });
+    expect(sent).toEqual([{ x: 1 }, { x: 3 }]);
+  });
+
+  test('reset resends the whole state', () => {
+    const sent = [];
+    const pub = createHudPublisher({ send: (p) => sent.push(p) });
+    pub.patch(frame(0));
+    pub.ready();
+    pub.reset();
+    expect(sent[1]).toEqual(frame(0));
+  });
+
+  test('compact packs the hot numbers and expands back', () => {
+    const sent = [];
+    const pub = createHudPublisher({ send: (p) => sent.push(p), compact: true });
+    pub.patch(frame(0));
+    pub.ready();
+    pub.patch({ ...frame(1), pinch: 0.5 });
+
+    expect(sent[0].nk).toEqual(HOT_FIELDS);
+    expect(sent[0].n).toEqual([1, 2, 0.25, 0, 100, 200]);
+    expect(sent[0].x).toBeUndefined();
+    expect(sent[1].nk).toBeUndefined();
+
+    const keys = { keys: null };
+    const hud = {};
+    sent.forEach(p => Object.assign(hud, expandHudPatch(p, keys)));
+    expect(hud).toMatchObject({ hands: 1, ext: 2, pinch: 0.5, x: 101, y: 200, profile: { name: 'Default' } });
+  });
+});
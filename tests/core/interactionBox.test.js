@@ -0,0 +1,32 @@
+const { createInteractionBox, DEFAULT_BOUNDS } = require('../../src/core/interactionBox');
+
+describe('interactionBox', () => {
+  test('normalizes millimetres against the bounds and clamps', () => {
+    const box = createInteractionBox();
+    expect(box.normalizePoint([0, 150, 0])).toEqual([0.5, 0.5, 0.5]);
+    expect(box.normalizePoint({ x: -120, y: 300, z: 120 })).toEqual([0, 1, 1]);
+    expect(box.normalizePoint([-240, 0, 0])[0]).toBe(0);
+    expect(box.normalizePoint([-240, 0, 0], false)[0]).toBeCloseTo(-0.5);
+  });
+
+  test('setBounds follows the middleware box and reports changes', () => {
+    const box = createInteractionBox(DEFAULT_BOUNDS);
+    expect(box.setBounds([-120, 120, 0, 300, -120, 120])).toBe(false);
+    expect(box.setBounds([0, 100, 100, 200, 0, 100])).toBe(true);
+    expect(box.normalizePoint([25, 150, 100])).toEqual([0.25, 0.5, 1]);
+    expect(DEFAULT_BOUNDS.x).toEqual([-120, 120]); // defaults are copied, never shared
+  });
+
+  test('pre-normalized points are used as is', () => {
+    const box = createInteractionBox();
+    const pt = [999, 999, 999];
+    pt.normalized = [0.1, 0.2, 0.3];
+    expect(box.normalizePoint(pt)).toEqual([0.1, 0.2, 0.3]);
+  });
+
+  test('acceptUnit passes already-normalized WS points through', () => {
+    const unit = createInteractionBox(DEFAULT_BOUNDS, { acceptUnit: true });
+    expect(unit.normalizePoint([0.2, 0.4, 0.6])).toEqual([0.2, 0.4, 0.6]);
+    expect(unit.normalizePoint([60, 150, 0])).toEqual([0.75, 0.5, 0.5]);
+  });
+});
@@ -0,0 +1,58 @@
+const fs = require('fs');
+const os = require('os');
+const path = require('path');
+const { createProfiler, bucketOf, bucketTop } = require('../../src/core/profiler');
+
+const spin = (us) => { const end = process.hrtime.bigint() + BigInt(Math.round(us * 1e3)); while (process.hrtime.bigint() < end); };
+
+describe('profiler', () => {
+  test('quarter-octave buckets bound each sample', () => {
+    for (const us of [0.5, 1, 3, 17, 250, 4000]) {
+      const i = bucketOf(us);
+      expect(us).toBeLessThan(bucketTop(i));
+      if (i > 0) expect(us).toBeGreaterThanOrEqual(bucketTop(i - 1));
+    }
+  });
+
+  test('off: ctx handlers stay the original functions; on: timed, then restored', async () => {
+    const prof = createProfiler();
+    const handle = () => spin(200);
+    const ctx = { scroll: { handle }, zoom: { handle: async () => { spin(50); } } };
+    const frame = prof.wrap('frame', (x) => x + 1);
+    prof.attach(ctx);
+    expect(ctx.scroll.handle).toBe(handle);
+    expect(frame(1)).toBe(2);
+    expect(prof.snapshot()).toEqual([]);
+
+    prof.setEnabled(true);
+    expect(ctx.scroll.handle).not.toBe(handle);
+    for (let i = 0; i < 20; i++) { ctx.scroll.handle(); await ctx.zoom.handle(); frame(i); }
+    const s = prof.snapshot();
+    const scroll = s.find((r) => r.name === 'scroll.handle');
+    expect(scroll.n).toBe(20);
+    expect(scroll.p50).toBeGreaterThanOrEqual(150);
+    expect(scroll.p99).toBeLessThanOrEqual(scroll.max);
+    for (let i = 1; i < s.length; i++) expect(s[i - 1].p99).toBeGreaterThanOrEqual(s[i].p99);   // slowest first
+    expect(s.map((r) => r.name).sort()).toEqual(['frame', 'scroll.handle', 'zoom.handle']);
+
+    prof.setEnabled(false);
+    expect(ctx.scroll.handle).toBe(handle);
+  });
+
+  test('spans export as Chrome trace JSON', () => {
+    const prof = createProfiler({ enabled: true, traceEvents: 4 });
+    const bus = prof.bus({ on: (evt, fn) => fn, emit() {} });
+    const listener = bus.on('gesture:pinch', () => spin(20));
+    for (let i = 0; i < 6; i++) listener(0.9);
+    const t = prof.trace();
+    const spans = t.traceEvents.filter((e) => e.ph === 'X');
+    expect(spans).toHaveLength(4);                         // ring keeps the newest
+    expect(spans[0].name).toBe('bus:gesture:pinch');
+    expect(spans[1].ts).toBeGreaterThan(spans[0].ts);
+    expect(spans[0].dur).toBeGreaterThan(10);
+
+    const dir = fs.mkdtempSync(path.join(os.tmpdir(), 'prof-'));
+    const file = prof.exportTrace(dir);
+    expect(JSON.parse(fs.readFileSync(file, 'utf8')).traceEvents).toHaveLength(5);
+  });
+});
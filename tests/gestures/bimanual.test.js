@@ -0,0 +1,64 @@
+const { makeMockCtx } = require('../helpers/mockCtx');
+const { handleBimanual, stopBimanual } = require('../../src/gestures/bimanual');
+const GCR = require('../../src/core/gcr');
+
+const slice = (type, nx, ny, pinch = 0.9) => ({ type, nx, ny, pinch, gcr: new GCR() });
+
+function ctxWithChords() {
+  const ctx = makeMockCtx({ keyChord: jest.fn(), OS: { rotateLeft: ['L'], rotateRight: ['R'] }, Key: { LeftSuper: 'cmd' } });
+  return ctx;
+}
+
+describe('two-hand gestures', () => {
+  test('both hands pinching: spreading zooms in with Cmd+scroll', async () => {
+    const ctx = ctxWithChords();
+    const l = slice('left', 0.4, 0.5), r = slice('right', 0.6, 0.5);
+    expect(await handleBimanual(ctx, r, l)).toBe(true);            // engage, no output yet
+    expect(r.gcr.current()).toBe('bimanual');
+    expect(l.gcr.current()).toBe('bimanual');
+    expect(ctx.mouse.scrollUp).not.toHaveBeenCalled();
+
+    l.nx = 0.3; r.nx = 0.7;                                        // spread 0.2 -> 0.4
+    expect(await handleBimanual(ctx, r, l)).toBe(true);
+    expect(ctx.mouse.scrollUp).toHaveBeenCalledWith(40);
+    expect(ctx.keyboard.pressKey).toHaveBeenCalledWith('cmd');
+    expect(ctx.keyboard.releaseKey).toHaveBeenCalledWith('cmd');
+  });
+
+  test('tilting the line between the hands rotates in steps', async () => {
+    const ctx = ctxWithChords();
+    const l = slice('left', 0.3, 0.5), r = slice('right', 0.7, 0.5);
+    await handleBimanual(ctx, l, r);
+    // right hand up: counter-clockwise ~32 degrees -> one rotate-left chord
+    r.ny = 0.75;
+    await handleBimanual(ctx, l, r);
+    expect(ctx.keyChord).toHaveBeenCalledTimes(1);
+    expect(ctx.keyChord).toHaveBeenCalledWith(['L']);
+    // back down past level: clockwise
+    r.ny = 0.35;
+    await handleBimanual(ctx, l, r);
+    expect(ctx.keyChord).toHaveBeenLastCalledWith(['R']);
+  });
+
+  test('needs both pinches and a free lock; releasing ends it', async () => {
+    const ctx = ctxWithChords();
+    const l = slice('left', 0.4, 0.5, 0.2), r = slice('right', 0.6, 0.5);
+    expect(await handleBimanual(ctx, r, l)).toBe(false);
+    l.pinch = 0.9;
+    r.gcr.acquire('drag', 1);
+    expect(await handleBimanual(ctx, r, l)).toBe(false);
+    expect(l.gcr.current()).toBeNull();
+
+    r.gcr.release();
+    expect(await handleBimanual(ctx, r, l)).toBe(true);
+    l.pinch = 0.3;
+    expect(await handleBimanual(ctx, r, l)).toBe(false);
+    expect(r.gcr.current()).toBeNull();
+    expect(ctx.state.bimanual.active).toBe(false);
+
+    l.pinch = 0.9;
+    await handleBimanual(ctx, r, l);
+    stopBimanual(ctx, r);
+    expect(r.gcr.current()).toBeNull();
+  });
+});
@@ -0,0 +1,104 @@
+const { makeMockCtx } = require('../helpers/mockCtx');
+const { makeHand } = require('../helpers/makeFrame');
+const { makeFakeIBox } = require('../helpers/fakeIBox');
+const { createFrameClock } = require('../../src/core/frameClock');
+const { handleTwoFingerScroll, stepScrollInertia } = require('../../src/gestures/scroll');
+const { tickDwell } = require('../../src/gestures/dwellClick');
+const { handleOsSwipes } = require('../../src/gestures/osSwipes');
+
+const RATES = [60, 90, 120];
+
+// Replays `durationMs` of device time at `hz`. Frames reach the engine in bursts of
+// three (same wall-clock ms), as they do when the host stalls: only the device
+// timestamps say how far apart they were sampled.
+async function replay(hz, durationMs, onFrame, overrides = {}) {
+  let wall = 1_000_000;
+  const clock = createFrameClock({ now: () => wall });
+  const ctx = makeMockCtx({ now: () => clock.now(), ...overrides });
+  Object.assign(ctx.state, { inertia: { vx: 0, vy: 0, active: false }, pos: { x: 500, y: 500 }, lastPalmVel: 0 });
+  const period = 1000 / hz;
+  for (let i = 0; i * period <= durationMs; i++) {
+    const t = i * period;
+    if (i % 3 === 0) wall += 3 * period;
+    clock.frame(Math.round(7_000_000 + t * 1000));
+    await onFrame(ctx, t);
+  }
+  return ctx;
+}
+
+const sumCalls = (fn) => fn.mock.calls.reduce((a, c) => a + c[0], 0);
+
+describe('frame-rate invariance', () => {
+  test('scroll: the same finger motion scrolls the same number of notches', async () => {
+    const iBox = makeFakeIBox();
+    const totals = [];
+    for (const hz of RATES) {
+      // fingers glide up 0.3 -> 0.7 over 400 ms (eased), then rest
+      const ctx = await replay(hz, 600, (ctx, t) => {
+        const u = Math.min(1, t / 400);
+        const y = 0.3 + 0.4 * (u * u * (3 - 2 * u));
+        return handleTwoFingerScroll(ctx, makeHand({ fingers: 2, tip: [0.5, y, 0] }), iBox);
+      });
+      totals.push(sumCalls(ctx.mouse.scrollUp) - sumCalls(ctx.mouse.scrollDown));
+    }
+    expect(totals[0]).toBeGreaterThan(20);
+    for (const n of totals) expect(Math.abs(n - totals[0])).toBeLessThanOrEqual(2);
+  });
+
+  test('inertia: the tail coasts as far at any tick rate', () => {
+    const P = { decay: 0.9, minStep: 1 };
+    const runs = [8, 1000 / 90, 1000 / 60, 25].map((dt) => {
+      const inertia = { vx: 0, vy: 6, active: true };
+      let notches = 0, ms = 0;
+      while (inertia.active) { notches += stepScrollInertia(inertia, P, dt).stepY; ms += dt; }
+      return { notches, ms };
+    });
+    for (const r of runs) {
+      expect(Math.abs(r.notches - runs[0].notches)).toBeLessThanOrEqual(1);
+      expect(Math.abs(r.ms - runs[0].ms)).toBeLessThanOrEqual(25);
+    }
+    // 6 notches/16 ms decaying 10% per 16 ms: ~57 notches in all, stopped after ~280 ms
+    expect(runs[0].notches).toBeGreaterThan(40);
+  });
+
+  test('dwell: clicks after the same device time', async () => {
+    for (const hz of RATES) {
+      let clickedAt = null;
+      const ctx = await replay(hz, 1000, async (ctx, t) => {
+        await tickDwell(ctx);
+        if (clickedAt === null && ctx.mouse.click.mock.calls.length) clickedAt = t;
+      });
+      expect(ctx.mouse.click).toHaveBeenCalledTimes(1);
+      expect(clickedAt).toBeGreaterThanOrEqual(650);
+      expect(clickedAt).toBeLessThanOrEqual(650 + 1000 / hz);
+    }
+  });
+
+  test('swipe: the cooldown spans the same device time', async () => {
+    const keyChord = jest.fn();
+    const OS = { prevDesktop: 'l', nextDesktop: 'r', missionControlUp: 'u', missionControlDown: 'd' };
+    const counts = [];
+    for (const hz of RATES) {
+      keyChord.mockClear();
+      await replay(hz, 2000, (ctx) => handleOsSwipes(ctx, makeHand({ fingers: 4, palmVelocity: [1200, 0, 0] })), { keyChord, OS });
+      counts.push(keyChord.mock.calls.length);
+    }
+    expect(counts).toEqual([3, 3, 3]);
+  });
+
+  test('clock follows device time and re-anchors when it jumps', () => {
+    let wall = 50_000;
+    const clock = createFrameClock({ now: () => wall });
+    expect(clock.frame(1_000_000)).toBe(50_000);
+    wall += 1;                                        // arrived 1 ms later...
+    expect(clock.frame(1_016_000)).toBe(50_016);      // ...sampled 16 ms later
+    wall += 10;
+    expect(clock.now()).toBe(50_026);                 // between frames: runs on wall time
+    expect(clock.frame(1_020_000)).toBe(50_026);      // sampled at 50_020, but 50_026 was handed out: held
+    expect(clock.now()).toBe(50_026);
+    wall += 5;
+    expect(clock.frame(90_000)).toBe(50_026);         // device restarted: re-anchored, not before now()
+    expect(clock.frame(98_000)).toBe(50_034);
+    expect(clock.frame(0)).toBe(50_034);              // no timestamp: wall time, never backwards
+  });
+});
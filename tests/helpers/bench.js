@@ -0,0 +1,91 @@
+// Small helpers for tests/bench/*.bench.js (run with `npm run bench`).
+const v8 = require('v8');
+const vm = require('vm');
+const { performance, PerformanceObserver } = require('perf_hooks');
+const os = require('os');
+const GestureCore = require('../../src/core/gestureCore');
+
+// Works in plain node and inside Jest's sandbox
+v8.setFlagsFromString('--expose-gc');
+const gc = vm.runInNewContext('gc');
+
+// Mean wall time per call (ns) after a warm-up pass.
+function timePerOp(fn, iterations = 20000) {
+  for (let i = 0; i < Math.min(2000, iterations); i++) fn(i);
+  const t0 = process.hrtime.bigint();
+  for (let i = 0; i < iterations; i++) fn(i);
+  return Number(process.hrtime.bigint() - t0) / iterations;
+}
+
+// Heap bytes retained per call over short batches that fit inside the young generation,
+// so no scavenge runs mid-batch; the median batch is reported.
+function bytesPerOp(fn, { batch = 200, batches = 25 } = {}) {
+  for (let i = 0; i < batch; i++) fn(i);
+  const samples = [];
+  for (let b = 0; b < batches; b++) {
+    gc();
+    const before = process.memoryUsage().heapUsed;
+    for (let i = 0; i < batch; i++) fn(i);
+    samples.push((process.memoryUsage().heapUsed - before) / batch);
+  }
+  samples.sort((a, b) => a - b);
+  return Math.max(0, samples[samples.length >> 1]);
+}
+
+// Garbage collections (by kind) observed while running fn `iterations` times.
+async function gcCount(fn, iterations) {
+  const counts = { minor: 0, major: 0 };
+  const obs = new PerformanceObserver((list) => {
+    for (const e of list.getEntries()) {
+      const kind = e.detail?.kind ?? e.kind;
+      if (kind === 1 /* NODE_PERFORMANCE_GC_MINOR */) counts.minor++; else counts.major++;
+    }
+  });
+  obs.observe({ entryTypes: ['gc'] });
+  gc();
+  for (let i = 0; i < iterations; i++) fn(i);
+  await new Promise((r) => setTimeout(r, 50)); // let GC entries flush
+  obs.disconnect();
+  return counts;
+}
+
+function report(title, rows) {
+  // eslint-disable-next-line no-console
+  console.log(`\n${title}\n` + rows.map(r => '  ' + Object.entries(r).map(([k, v]) => `${k}=${v}`).join('  ')).join('\n'));
+}
+
+// GestureCore with actuation stubbed on a 1920x1080 display; onMove sees every cursor
+// move. Other options (e.g. profile) go to the GestureCore constructor.
+function createBenchEngine({ onMove = () => {}, ...opts } = {}) {
+  const noop = () => {};
+  const mouse = { setPosition: onMove, click: noop, pressButton: noop, releaseButton: noop, scrollUp: noop, scrollDown: noop, scrollLeft: noop, scrollRight: noop };
+  const core = new GestureCore({
+    io: { mouse, keyboard: { pressKey: noop, releaseKey: noop }, Button: { LEFT: 1 }, Key: { LeftSuper: 'cmd' }, keyChord: noop, Point: function (x, y) { this.x = x; this.y = y; } },
+    profiles: { current: () => ({ id: 'default' }), getProfileFor: () => ({}) },
+    userDataPath: os.tmpdir(),
+    ...opts,
+  });
+  core.setDisplay({ id: 1, bounds: { x: 0, y: 0 }, w: 1920, h: 1080 });
+  return core;
+}
+
+// One hand of a middleware record: palm at (x, y) mm moving at (vx, vy) mm/s, index tip
+// 60 mm above the palm, `extended` fingers held out; isNew only when given
+function handRecord({ id = 1, type = 'right', x = 0, y = 200, vx = 0, vy = 0, pinch = 0, grab = 0, extended = ['index', 'middle'], isNew } = {}) {
+  const ext = (name) => extended.includes(name);
+  const h = {
+    id, type, palmPosition: [x, y, 0], palmStab: [x, y, 0], palmVel: [vx, vy, 0], pinch, grab,
+    fingers: { thumb: [x - 30, y, 0], index: [x, y + 60, 0], middle: [x + 10, y + 60, 0], ring: [x + 20, y + 55, 0], pinky: [x + 30, y + 45, 0] },
+    fingerExtended: { thumb: ext('thumb'), index: ext('index'), middle: ext('middle'), ring: ext('ring'), pinky: ext('pinky') },
+  };
+  if (isNew !== undefined) h.isNew = isNew;
+  return h;
+}
+
+// Frame i of a hand drifting around the box with two fingers out (cursor + two-finger
+// scroll every frame); x0 places it, pinch for the two-hand pinch
+function driftingHand(i, { id = 1, type = 'right', x0 = 40, pinch = 0 } = {}) {
+  return handRecord({ id, type, x: x0 + 30 * Math.sin(i / 50), y: 200 + 30 * Math.cos(i / 70), vx: 30, vy: -20, pinch, grab: 0.1 });
+}
+
+module.exports = { gc, timePerOp, bytesPerOp, gcCount, report, performance, createBenchEngine, handRecord, driftingHand };
@@ -0,0 +1,42 @@
+jest.mock('../../src/input/keys', () => ({ parseKey: (k) => k }));
+const { Profiles } = require('../../src/input/profiles');
+const { switchProfile } = require('../../src/input/profileSwitcher');
+
+function fakeEngine(profiles) {
+  const opts = { threeFingerDrag: true, zoomWithCmdScrollOnPinch: true };
+  const persist = { pointerGain: { gainMax: 2.2 }, scrollInertia: { enabled: true }, gestures: { cursor: true } };
+  const hud = [];
+  const engine = {
+    profilesAuto: true, profiles, frontBundleId: '', opts, persist,
+    _base: JSON.parse(JSON.stringify({ opts, persist })),
+    _tutor() {}, _hudPatch: (p) => hud.push(p),
+  };
+  engine.ctx = { opts, persist };
+  return { engine, hud };
+}
+
+describe('profile switching', () => {
+  test('applies overrides in place so ctx sees them', () => {
+    const profiles = new Profiles(null);
+    profiles.data.profiles['com.google.Chrome'] = { name: 'Chrome', overrides: { threeFingerDrag: false, pointerGain: { gainMax: 3 } } };
+    const { engine } = fakeEngine(profiles);
+
+    switchProfile(engine, 'com.google.Chrome');
+    expect(engine.ctx.opts.threeFingerDrag).toBe(false);
+    expect(engine.ctx.persist.pointerGain.gainMax).toBe(3);
+    expect(engine.ctx.frontBundleId).toBe('com.google.Chrome');
+
+    switchProfile(engine, 'com.apple.finder'); // default profile: back to base
+    expect(engine.ctx.opts.threeFingerDrag).toBe(true);
+    expect(engine.ctx.persist.pointerGain.gainMax).toBe(2.2);
+  });
+
+  test('profile lookups are cached until reload', () => {
+    const profiles = new Profiles(null);
+    const a = profiles.getProfileFor('com.x');
+    profiles.data.profiles['com.x'] = { name: 'X', overrides: {} };
+    expect(profiles.getProfileFor('com.x')).toBe(a);
+    profiles.load();
+    expect(profiles.getProfileFor('com.x').name).toBe('X');
+  });
+});
@@ -0,0 +1,9 @@
+// Benchmark mode: same harness as tests/jest.config.js, but runs tests/bench/*.bench.js.
+// Usage: npm run bench
+const base = require('./jest.config');
+
+module.exports = {
+  ...base,
+  testMatch: ['<rootDir>/tests/bench/**/*.bench.js'],
+  testTimeout: 120000,
+};
@@ -0,0 +1,50 @@
+const fs = require('fs');
+const os = require('os');
+const path = require('path');
+const { createFrontAppWatcher, createStubSource, axwinSource, parseFrontLine } = require('../../src/osx/frontApp');
+
+const waitFor = async (cond, ms = 3000) => {
+  const end = Date.now() + ms;
+  while (!cond() && Date.now() < end) await new Promise(r => setTimeout(r, 10));
+};
+
+describe('front app watcher', () => {
+  test('stub source drives change events, repeats are ignored', () => {
+    const src = createStubSource();
+    const seen = [];
+    const w = createFrontAppWatcher({ source: src }).on('change', (e) => seen.push(e.bundleId));
+    w.start();
+    src.focus('com.apple.finder'); src.focus('com.apple.finder'); src.focus(''); src.focus('com.google.Chrome');
+    expect(seen).toEqual(['com.apple.finder', 'com.google.Chrome']);
+    expect(w.current()).toBe('com.google.Chrome');
+    w.stop();
+    src.focus('com.apple.Safari');
+    expect(seen).toHaveLength(2);
+  });
+
+  test('parses helper lines', () => {
+    expect(parseFrontLine('front com.apple.Terminal 512')).toEqual({ bundleId: 'com.apple.Terminal', pid: 512 });
+    expect(parseFrontLine('ERR not_trusted')).toBeNull();
+  });
+
+  test('streams events from a watchFront helper process', async () => {
+    const helper = path.join(fs.mkdtempSync(path.join(os.tmpdir(), 'axwin-')), 'axwin');
+    fs.writeFileSync(helper, '#!/bin/sh\nprintf "front com.a 1\\nfront com.b 2\\n"\ncat >/dev/null\n', { mode: 0o755 });
+    const seen = [];
+    const src = axwinSource(helper);
+    src.start((e) => seen.push(e));
+    await waitFor(() => seen.length >= 2);
+    src.stop();
+    expect(seen).toEqual([{ bundleId: 'com.a', pid: 1 }, { bundleId: 'com.b', pid: 2 }]);
+  });
+
+  test('falls back when the helper cannot run', async () => {
+    const fallback = createStubSource();
+    const seen = [];
+    const src = axwinSource(path.join(os.tmpdir(), 'no-such-axwin'), { fallback });
+    src.start((e) => seen.push(e.bundleId));
+    await waitFor(() => { fallback.focus('com.fallback'); return seen.length > 0; });
+    src.stop();
+    expect(seen[0]).toBe('com.fallback');
+  });
+});
@@ -0,0 +1,78 @@
+const { channelBytes, createFrameWriter, createFrameReader } = require('../../src/worker/frameChannel');
+const { createFramePool, createInteractionBox } = require('../../src/bridges/frameView');
+
+const rawHand = (id, over = {}) => ({
+  id, type: 'left', palmPosition: [10, 200, -5], palmVel: [1, 2, 3], pinch: 0.4, grab: 0.6,
+  fingers: { thumb: [1, 2, 3], index: [4, 5, 6], middle: [7, 8, 9], ring: [10, 11, 12], pinky: [13, 14, 15] },
+  fingerExtended: { index: true, middle: true },
+  ...over,
+});
+
+function channel() {
+  const sab = new SharedArrayBuffer(channelBytes(2));
+  const reader = createFrameReader(sab, 2, createInteractionBox({ x: [-120, 120], y: [0, 300], z: [-120, 120] }));
+  return { writer: createFrameWriter(sab, 2), reader, view: reader.createView() };
+}
+
+describe('frameChannel', () => {
+  test('pooled bridge frames round-trip through the shared buffer', () => {
+    const { writer, reader, view } = channel();
+    const pool = createFramePool();
+    writer.write(pool.fill({ frameId: 42, framerate: 120, hands: [rawHand(7), rawHand(9, { type: 'right' })] }));
+
+    const f = reader.read(view);
+    expect(f.id).toBe(42);
+    expect(f.fps).toBe(120);
+    expect(f.hands.map(h => h.id)).toEqual([7, 9]);
+    expect(f.hands[1].type).toBe(1);
+    expect(f.hands[0].pinchStrength).toBeCloseTo(0.4, 5);
+    expect(Array.from(f.hands[0].indexFinger.stabilizedTipPosition)).toEqual([4, 5, 6]);
+    expect(f.hands[0].fingers.filter(x => x.extended).map(x => x.type)).toEqual([1, 2]);
+    expect(reader.read(view)).toBeNull();
+  });
+
+  test('latest wins: unread frames are skipped and counted', () => {
+    const { writer, reader, view } = channel();
+    for (let id = 1; id <= 5; id++) writer.write({ id, hands: [] });
+    expect(reader.read(view).id).toBe(5);
+    expect(reader.takeSkipped()).toBe(4);
+  });
+
+  test('encodes LeapJS-shaped hands', () => {
+    const { writer, reader, view } = channel();
+    const fingers = [0, 1, 2, 3, 4].map(type => ({ type, extended: type === 1, stabilizedTipPosition: [type, type, type] }));
+    writer.write({ id: 3, hands: [{ id: 5, type: 'right', palmPosition: [1, 2, 3], palmVelocity: [4, 5, 6], grabStrength: 0.5, fingers }] });
+    const h = reader.read(view).hands[0];
+    expect(h.type).toBe(1);
+    expect(Array.from(h.palmStabilized)).toEqual([1, 2, 3]);
+    expect(Array.from(h.fingers[3].stabilizedTipPosition)).toEqual([3, 3, 3]);
+    expect(h.fingers.filter(x => x.extended)).toHaveLength(1);
+  });
+
+  test('carries the display id and normalized points across', () => {
+    const { writer, reader, view } = channel();
+    const box = createInteractionBox({ x: [-100, 100], y: [0, 200], z: [-100, 100] });
+    const fingers = [0, 1, 2, 3, 4].map(type => ({ type, stabilizedTipPosition: [0, 100, 50] }));
+    writer.write({ id: 4, displayId: 2, interactionBox: box, hands: [{ id: 1, palmPosition: [50, 0, 0], fingers }] });
+    const f = reader.read(view);
+    expect(f.displayId).toBe(2);
+    // normalized by the writer's box, not the reader's default one
+    expect(Array.from(f.hands[0].indexFinger.stabilizedTipPosition.normalized)).toEqual([0.5, 0.5, 0.75]);
+    expect(Array.from(f.hands[0].palmStabilized.normalized)).toEqual([0.75, 0, 0.5]);
+    expect(f.hands[0].screenPoint).toBeNull();
+  });
+
+  test('display ids above 2^31 come back unsigned', () => {
+    const { writer, reader, view } = channel();
+    writer.write({ id: 5, displayId: 0x80000001, hands: [] });
+    expect(reader.read(view).displayId).toBe(0x80000001);
+  });
+
+  test('carries the heartbeat flag across', () => {
+    const { writer, reader, view } = channel();
+    writer.write({ id: 9, heartbeat: true, hands: [] });
+    expect(reader.read(view).heartbeat).toBe(true);
+    writer.write({ id: 10, hands: [] });
+    expect(reader.read(view).heartbeat).toBe(false);
+  });
+});
@@ -0,0 +1,36 @@
+const { createGestureWorker } = require('../../src/worker');
+const { createFramePool } = require('../../src/bridges/frameView');
+
+describe('gesture worker', () => {
+  test('evaluates frames off-thread and posts back cursor moves', async () => {
+    const moves = [], hud = [];
+    const engine = {
+      io: { mouse: { setPosition: (p) => moves.push([p.x, p.y]) }, Point: function (x, y) { this.x = x; this.y = y; } },
+      profiles: { current: () => ({ id: 'default', name: 'Default' }), data: { profiles: {} } },
+      persistedSnapshot: () => ({}), userDataPath: require('os').tmpdir(), helperPath: null,
+      onHUD: (p) => hud.push(p), onCalState() {}, onSave() {}, _tutor() {},
+    };
+    const w = createGestureWorker(engine);
+    w.post({ t: 'display', d: { id: 1, bounds: { x: 0, y: 0 }, w: 1000, h: 800 } });
+
+    // open palm (index..pinky extended, no grab) at the box centre -> cursor moves
+    const pool = createFramePool();
+    const ext = { index: true, middle: true, ring: true, pinky: true };
+    let id = 0;
+    const timer = setInterval(() => {
+      id++;
+      w.pushFrame(pool.fill({ frameId: id, hands: [{ id: 1, type: 'right', palmPosition: [0, 150, 0], grab: 0, pinch: 0, fingers: { index: [0, 150, 0] }, fingerExtended: ext }] }));
+    }, 8);
+
+    const deadline = Date.now() + 5000;
+    while (!moves.length && Date.now() < deadline) await new Promise(r => setTimeout(r, 20));
+    clearInterval(timer);
+    await w.terminate();
+
+    expect(moves.length).toBeGreaterThan(0);
+    expect(hud.some(p => p.hands === 1 && p.sched)).toBe(true);
+    const [x, y] = moves[moves.length - 1];
+    expect(x).toBeGreaterThan(0); expect(x).toBeLessThanOrEqual(500);
+    expect(y).toBeGreaterThan(0); expect(y).toBeLessThanOrEqual(400);
+  });
+});
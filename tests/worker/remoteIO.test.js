@@ -0,0 +1,47 @@
+const { createRemoteIO } = require('../../src/worker/remoteIO');
+const { createActuator } = require('../../src/worker/actuator');
+
+const tick = () => new Promise(r => setImmediate(r));
+
+function recordingIO() {
+  const log = [];
+  const rec = (name) => (...a) => { log.push([name, ...a]); };
+  return {
+    log,
+    io: {
+      mouse: {
+        setPosition: (p) => log.push(['move', p.x, p.y]), click: rec('click'), pressButton: rec('press'), releaseButton: rec('release'),
+        scrollUp: rec('up'), scrollDown: rec('down'), scrollLeft: rec('left'), scrollRight: rec('right'),
+      },
+      keyboard: { pressKey: rec('keyDown'), releaseKey: rec('keyUp') },
+      Button: { LEFT: 0, RIGHT: 1, MIDDLE: 2 }, Key: { LeftSuper: 91 },
+      Point: function (x, y) { this.x = x; this.y = y; },
+      keyChord: rec('chord'), moveWindow: rec('winMove'), snapWindow: rec('snap'),
+    },
+  };
+}
+
+describe('remote actuation', () => {
+  test('one batch per turn; moves coalesce and scrolls sum between other commands', async () => {
+    const posts = [];
+    const io = createRemoteIO((m) => posts.push(m));
+    io.mouse.setPosition(new io.Point(1, 1));
+    io.mouse.setPosition(new io.Point(5, 6));
+    io.mouse.click(io.Button.LEFT);
+    io.mouse.scrollUp(3); io.mouse.scrollDown(1); io.mouse.scrollRight(2);
+    io.keyChord(['LeftControl', 'Up']);
+    await tick();
+    expect(posts).toHaveLength(1);
+    expect(posts[0].c).toEqual([['m', 5, 6], ['c', 'LEFT'], ['s', 2, 2], ['k', ['LeftControl', 'Up']]]);
+  });
+
+  test('actuator maps names onto the real enums and keeps order', async () => {
+    const { io, log } = recordingIO();
+    const act = createActuator(io, { profiles: { runBinding: (b) => log.push(['binding', b.keys]) } });
+    await act.apply([['m', 10.4, 20.6], ['d', 'LEFT'], ['kd', 'LeftSuper'], ['s', 0, -2], ['ku', 'LeftSuper'], ['u', 'LEFT'], ['w', 'snap', 'left'], ['b', { keys: ['Cmd', 'T'] }]]);
+    expect(log).toEqual([
+      ['move', 10, 21], ['press', 0], ['keyDown', 91], ['down', 2], ['keyUp', 91], ['release', 0], ['snap', 'left'], ['binding', ['Cmd', 'T']],
+    ]);
+    expect(act.stats.commands).toBe(8);
+  });
+});